@@ -0,0 +1,69 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        AliasSampler.h
+// Project:     sgpLib
+// Purpose:     Discrete distribution sampler using alias method.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SGPALIASSAMPLER_H__
+#define _SGPALIASSAMPLER_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/** \file AliasSampler.h
+\brief Discrete distribution sampler using alias method.
+
+Table is built from non-negative weights in O(n) (Vose's variant of
+Walker's method), each draw is O(1): one uniform value selects a column
+and decides between the column item and its alias.
+*/
+
+// ----------------------------------------------------------------------------
+// Headers
+// ----------------------------------------------------------------------------
+#include "sc/dtypes.h"
+
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// Simple type definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Forward class definitions
+// ----------------------------------------------------------------------------
+class sgpRandomSource;
+
+// ----------------------------------------------------------------------------
+// Class definitions
+// ----------------------------------------------------------------------------
+class sgpAliasSampler {
+public:
+  sgpAliasSampler();
+  ~sgpAliasSampler() {}
+  /// build table, returns false (and leaves sampler empty) if weights are negative, NaN or sum to zero
+  bool build(const double *weights, uint count);
+  bool build(const std::vector<double> &weights);
+  void clear();
+  uint size() const;
+  bool empty() const;
+  /// returns index of item, sampler must not be empty
+  uint sample(sgpRandomSource &random) const;
+  /// same as above, uses global RNG
+  uint sample() const;
+  /// append "count" draws to output
+  void sample(sgpRandomSource &random, uint count, std::vector<uint> &output) const;
+protected:
+  bool buildFromWork(double sum);
+private:
+  std::vector<double> m_prob;
+  std::vector<uint> m_alias;
+  std::vector<double> m_work;
+  std::vector<uint> m_small;
+  std::vector<uint> m_large;
+};
+
+#endif // _SGPALIASSAMPLER_H__
@@ -24,20 +24,24 @@
 #include <vector>
 #include <set>
 
+#include <boost/shared_ptr.hpp>
+
 #include "sc/dtypes.h"
 
 #include "sgp\FitnessValue.h"
 
+// ----------------------------------------------------------------------------
+// Forward class definitions
+// ----------------------------------------------------------------------------
+class sgpEntityPool;
+
 // ----------------------------------------------------------------------------
 // Simple type definitions
 // ----------------------------------------------------------------------------
 typedef std::vector<scDataNodeValue> sgpGaGenome;
 typedef std::vector<uint> sgpEntityIndexList;
 typedef std::set<uint> sgpEntityIndexSet;
-
-// ----------------------------------------------------------------------------
-// Forward class definitions
-// ----------------------------------------------------------------------------
+typedef boost::shared_ptr<sgpEntityPool> sgpEntityPoolPtr;
 
 // ----------------------------------------------------------------------------
 // Constants
@@ -51,10 +55,10 @@ typedef std::set<uint> sgpEntityIndexSet;
 /// Keeps DNA - info data, code & fitness value.
 class sgpEntityBase /*: boost::noncopyable*/ {
 public:  
-  sgpEntityBase() {m_fitness.resize(1);}
-  sgpEntityBase(const sgpEntityBase &src): m_fitness(src.m_fitness) {}  
+  sgpEntityBase(): m_genomeChanged(true), m_islandIdPos(-1), m_islandBitSize(0), m_islandGene(0), m_islandId(0) {m_fitness.resize(1);}
+  sgpEntityBase(const sgpEntityBase &src): m_fitness(src.m_fitness), m_genomeChanged(src.m_genomeChanged) { copyCachedIslandId(src); }  
   virtual ~sgpEntityBase() {}
-  virtual sgpEntityBase &operator=(const sgpEntityBase &src) {if (&src != this) {m_fitness = src.m_fitness;} return *this;}
+  virtual sgpEntityBase &operator=(const sgpEntityBase &src) {if (&src != this) {m_fitness = src.m_fitness; m_genomeChanged = src.m_genomeChanged; copyCachedIslandId(src);} return *this;}
 // properties
   // in fact n-th genome is in DNA science is called "chromosome"
   virtual void getGenome(int genomeNo, sgpGaGenome &output) const = 0; //{ getGenome(0, output); } 
@@ -68,6 +72,11 @@ public:
   virtual void getGenomeItem(int genomeNo, uint itemIndex, scDataNode &output) const = 0;
   virtual void setGenomeItem(int genomeNo, uint itemIndex, const scDataNode &value) = 0;
 
+  /// returns genome items if genome is stored as uint vector, otherwise SC_NULL 
+  virtual const uint *getGenomeData(int genomeNo, uint &itemCount) const { itemCount = 0; return SC_NULL; }
+  /// modifiable version of getGenomeData, marks genome as changed
+  virtual uint *modifyGenomeData(int genomeNo, uint &itemCount) { itemCount = 0; return SC_NULL; }
+
   /// returns all fitness values
   void getFitness(sgpFitnessValue &output) const {
     uint aSize = output.size();
@@ -93,8 +102,42 @@ public:
   void setFitness(double value) {m_fitness.setValue(0, value);}
   /// modifies specified fitness value
   void setFitness(int index, double value) {m_fitness.setValue(index, value);}
+
+  /// returns true if genome was modified after last evaluation
+  bool isGenomeChanged() const { return m_genomeChanged; }
+  void setGenomeChanged(bool value) { m_genomeChanged = value; }
+
+  /// decoded island gene cached by island tool, valid for gene position "genePos" decoded with "bitSize" 
+  /// bits, with raw value "gene" (use 0 if genome is not stored as uint vector)
+  bool getCachedIslandId(int genePos, uint bitSize, uint gene, uint &output) const {
+    if ((m_islandIdPos != genePos) || (m_islandBitSize != bitSize) || (m_islandGene != gene))
+      return false;
+    output = m_islandId;
+    return true;
+  }
+  void setCachedIslandId(int genePos, uint bitSize, uint gene, uint value) const { 
+    m_islandIdPos = genePos; m_islandBitSize = bitSize; m_islandGene = gene; m_islandId = value; 
+  }
+  void invalidateIslandId() const { m_islandIdPos = -1; }
+
+  /// pool entity returns to when released by generation, not copied with entity
+  const sgpEntityPoolPtr &getPool() const { return m_pool; }
+  void setPool(const sgpEntityPoolPtr &pool) { m_pool = pool; }
+protected:
+  void copyCachedIslandId(const sgpEntityBase &src) { 
+    m_islandIdPos = src.m_islandIdPos; m_islandBitSize = src.m_islandBitSize; m_islandGene = src.m_islandGene; m_islandId = src.m_islandId; 
+  }
+  /// to be called by genome item setters
+  void genomeItemChanged(uint itemIndex) { if (static_cast<int>(itemIndex) == m_islandIdPos) m_islandIdPos = -1; }
 protected:
   sgpFitnessValue m_fitness;      
+  bool m_genomeChanged;
+  sgpEntityPoolPtr m_pool;
+  // island id cache, m_islandIdPos = -1 means empty
+  mutable int m_islandIdPos;
+  mutable uint m_islandBitSize;
+  mutable uint m_islandGene;
+  mutable uint m_islandId;
 };
 
 #endif // _SGPENTBASE_H__
@@ -56,6 +56,8 @@ public:
     if (&src != this) {
       m_genome = src.m_genome; 
       m_fitness = src.m_fitness;
+      m_genomeChanged = src.m_genomeChanged;
+      copyCachedIslandId(src);
     } 
     return *this;
   }
@@ -88,6 +90,8 @@ public:
   }
 
   virtual void setGenome(const sgpGaGenome &genome) {
+    m_genomeChanged = true;
+    invalidateIslandId();
     m_genome.clear();
     m_genome.reserve(genome.size());
     for(uint i=0, epos = genome.size(); i != epos; ++i)
@@ -102,6 +106,8 @@ public:
   virtual void setGenomeItem(int genomeNo, uint itemIndex, const scDataNode &value) {
     assert(genomeNo == 0);
     m_genome[itemIndex] = value.getAsUInt();
+    m_genomeChanged = true;
+    genomeItemChanged(itemIndex);
   }
   
   virtual void getGenomeAsNode(scDataNode &output, int offset = 0, int count = -1) const;
@@ -117,6 +123,19 @@ public:
     return m_genome.size(); 
   }
 
+  virtual const uint *getGenomeData(int genomeNo, uint &itemCount) const {
+    assert(genomeNo == 0);
+    itemCount = m_genome.size();
+    return m_genome.empty() ? SC_NULL : &m_genome[0];
+  }
+
+  virtual uint *modifyGenomeData(int genomeNo, uint &itemCount) {
+    assert(genomeNo == 0);
+    m_genomeChanged = true;
+    itemCount = m_genome.size();
+    return m_genome.empty() ? SC_NULL : &m_genome[0];
+  }
+
 protected:
   code_storage_type m_genome;
 };
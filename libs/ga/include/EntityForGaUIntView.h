@@ -0,0 +1,134 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        EntityForGaUIntView.h
+// Project:     sgpLib
+// Purpose:     GA entity with uint genome kept in population store.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SGPENTFORGAUINTVIEW_H__
+#define _SGPENTFORGAUINTVIEW_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/** \file EntityForGaUIntView.h
+\brief GA entity with uint genome kept in population store.
+
+Entity does not own genome & fitness buffers - it occupies one slot of
+sgpPopulationStoreUInt and releases it on destruction. 
+Genome size is fixed by store. Fitness vector uses store's row as long as 
+number of objectives is not larger than store's objective count.
+*/
+
+// ----------------------------------------------------------------------------
+// Headers
+// ----------------------------------------------------------------------------
+#include "sgp/EntityBase.h"
+#include "sgp/PopulationStoreUInt.h"
+
+// ----------------------------------------------------------------------------
+// Simple type definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Forward class definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Constants
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Class definitions
+// ----------------------------------------------------------------------------
+class sgpEntityForGaUIntView: public sgpEntityBase {
+  typedef sgpEntityBase inherited;
+public:  
+  sgpEntityForGaUIntView(const sgpPopulationStoreUIntPtr &store);
+  sgpEntityForGaUIntView(const sgpEntityForGaUIntView &src);
+  virtual ~sgpEntityForGaUIntView();
+  virtual sgpEntityForGaUIntView &operator=(const sgpEntityForGaUIntView &src);
+
+  //--> genome access
+  virtual void getGenome(int genomeNo, sgpGaGenome &output) const
+  { 
+     assert(genomeNo == 0);
+     getGenome(output);
+  }
+   
+  virtual void setGenome(int genomeNo, const sgpGaGenome &genome) {
+     assert(genomeNo == 0);
+     setGenome(genome);
+  }
+  
+  virtual uint getGenomeCount() const { return 1; }
+
+  virtual void getGenome(sgpGaGenome &output) const {
+    output.resize(m_genomeSize);
+    for(uint i=0; i != m_genomeSize; ++i)
+      output[i].setAsUInt(m_genome[i]);
+  }
+
+  virtual void setGenome(const sgpGaGenome &genome) {
+    checkGenomeSize(genome.size());
+    m_genomeChanged = true;
+    invalidateIslandId();
+    for(uint i=0; i != m_genomeSize; ++i)
+      m_genome[i] = genome[i].getAsUInt();
+  }
+
+  virtual void getGenomeItem(int genomeNo, uint itemIndex, scDataNode &output) const {
+    assert(itemIndex < m_genomeSize);
+    output = m_genome[itemIndex]; 
+  }
+
+  virtual void setGenomeItem(int genomeNo, uint itemIndex, const scDataNode &value) {
+    assert(genomeNo == 0);
+    assert(itemIndex < m_genomeSize);
+    m_genome[itemIndex] = value.getAsUInt();
+    m_genomeChanged = true;
+    genomeItemChanged(itemIndex);
+  }
+  
+  virtual void getGenomeAsNode(scDataNode &output, int offset = 0, int count = -1) const;
+  virtual void setGenomeAsNode(const scDataNode &genome);
+
+  virtual void getGenomeItem(int genomeNo, uint itemIndex, uint &output) const {
+    assert(genomeNo == 0);
+    assert(itemIndex < m_genomeSize);
+    output = m_genome[itemIndex]; 
+  }
+
+  virtual uint getGenomeSize(int genomeNo) const {
+    assert(genomeNo == 0);
+    return m_genomeSize; 
+  }
+
+  virtual const uint *getGenomeData(int genomeNo, uint &itemCount) const {
+    assert(genomeNo == 0);
+    itemCount = m_genomeSize;
+    return m_genome;
+  }
+
+  virtual uint *modifyGenomeData(int genomeNo, uint &itemCount) {
+    assert(genomeNo == 0);
+    m_genomeChanged = true;
+    itemCount = m_genomeSize;
+    return m_genome;
+  }
+
+  uint getSlot() const { return m_slot; }
+  const sgpPopulationStoreUIntPtr &getStore() const { return m_store; }
+protected:
+  void bindToStore();
+  void checkGenomeSize(uint value) const;
+private:
+  sgpPopulationStoreUIntPtr m_store;
+  uint m_slot;
+  uint m_genomeSize;
+  uint *m_genome;
+};
+
+#endif // _SGPENTFORGAUINTVIEW_H__
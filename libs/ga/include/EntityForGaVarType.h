@@ -46,7 +46,7 @@ public:
   sgpEntityForGaVarType() {m_fitness.resize(1);}
   sgpEntityForGaVarType(const sgpEntityForGaVarType &src): m_genome(src.m_genome), sgpEntityBase(src) {}  
   virtual ~sgpEntityForGaVarType() {}
-  virtual sgpEntityForGaVarType &operator=(const sgpEntityForGaVarType &src) {if (&src != this) {m_genome = src.m_genome; m_fitness = src.m_fitness;} return *this;}
+  virtual sgpEntityForGaVarType &operator=(const sgpEntityForGaVarType &src) {if (&src != this) {m_genome = src.m_genome; m_fitness = src.m_fitness; m_genomeChanged = src.m_genomeChanged; copyCachedIslandId(src);} return *this;}
   //--> genome access
   virtual void getGenome(int genomeNo, sgpGaGenome &output) const
   { 
@@ -58,12 +58,14 @@ public:
      assert(genomeNo >= 0);
      assert(static_cast<uint>(genomeNo) < getGenomeCount());
      m_genome = genome;     
+     m_genomeChanged = true;
+     invalidateIslandId();
   }
   virtual uint getGenomeCount() const { return 1; }
 
   virtual void getGenome(sgpGaGenome &output) const {output = m_genome;}
   virtual const sgpGaGenome &getGenome() const {return m_genome;}
-  virtual void setGenome(const sgpGaGenome &genome) {m_genome = genome;}
+  virtual void setGenome(const sgpGaGenome &genome) {m_genome = genome; m_genomeChanged = true; invalidateIslandId();}
 
   virtual void getGenomeItem(int genomeNo, uint itemIndex, scDataNode &output) const {
     output = m_genome[itemIndex]; 
@@ -72,6 +74,8 @@ public:
   virtual void setGenomeItem(int genomeNo, uint itemIndex, const scDataNode &value) {
     assert(genomeNo == 0);
     m_genome.at(itemIndex).copyFrom(value);
+    m_genomeChanged = true;
+    genomeItemChanged(itemIndex);
   }
   
   virtual void getGenomeAsNode(scDataNode &output, int offset = 0, int count = -1) const;
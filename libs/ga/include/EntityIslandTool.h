@@ -24,6 +24,7 @@ Long description
 // ----------------------------------------------------------------------------
 #include "sc\dtypes.h"
 #include "sgp\GaEvolver.h"
+#include "sgp/IslandPartition.h"
 
 // ----------------------------------------------------------------------------
 // Simple type definitions
@@ -44,7 +45,8 @@ class sgpEntityIslandToolIntf: public scInterface {
 public:  
   sgpEntityIslandToolIntf() {}
   virtual ~sgpEntityIslandToolIntf() {}
-  virtual void prepareIslandMap(const sgpGaGeneration &newGeneration, scDataNode &output) = 0;
+  /// split population into islands, output is indexed by island id
+  virtual void prepareIslandPartition(const sgpGaGeneration &newGeneration, sgpIslandPartition &output) = 0;
   virtual bool getIslandId(const sgpEntityBase &entity, uint &output) = 0;
   virtual bool setIslandId(sgpEntityBase &entity, uint value) = 0;
 };
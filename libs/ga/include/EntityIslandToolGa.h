@@ -46,7 +46,7 @@ public:
   void setIslandLimit(uint value);
   void setIslandIdPos(int value);
   void setBitSize(uint value);
-  virtual void prepareIslandMap(const sgpGaGeneration &newGeneration, scDataNode &output);
+  virtual void prepareIslandPartition(const sgpGaGeneration &newGeneration, sgpIslandPartition &output);
   virtual bool getIslandId(const sgpEntityBase &entity, uint &output);
   virtual bool setIslandId(sgpEntityBase &entity, uint value);
 protected:
@@ -55,6 +55,7 @@ private:
   uint m_islandLimit;
   int m_islandIdPos;
   uint m_bitSize;
+  std::vector<uint> m_islandIds;
 };
 
 #endif // _SGPENTISLTOOLGA_H__
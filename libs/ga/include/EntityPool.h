@@ -0,0 +1,99 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        EntityPool.h
+// Project:     sgpLib
+// Purpose:     Free-list pool of entity objects shared by generations.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SGPENTITYPOOL_H__
+#define _SGPENTITYPOOL_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/** \file EntityPool.h
+\brief Free-list pool of entity objects shared by generations.
+
+Entities released by a generation (clear, destruction) are kept in the pool
+together with their genome buffers and reused by newItem() / cloneItem() 
+of generations sharing the same pool, so steady-state evolution does not 
+allocate entities after warm-up.
+Pool holds entities of one class only - the one created by owning generation.
+Not thread-safe.
+*/
+
+// ----------------------------------------------------------------------------
+// Headers
+// ----------------------------------------------------------------------------
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/enable_shared_from_this.hpp>
+
+#include "sc/dtypes.h"
+
+#include "sgp/EntityBase.h"
+
+// ----------------------------------------------------------------------------
+// Simple type definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Forward class definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Constants
+// ----------------------------------------------------------------------------
+/// 0 - number of kept entities is not limited
+const uint SGP_ENTITY_POOL_DEF_CAPACITY = 0;
+
+// ----------------------------------------------------------------------------
+// Class definitions
+// ----------------------------------------------------------------------------
+class sgpEntityPool: public boost::enable_shared_from_this<sgpEntityPool> {
+public:
+  sgpEntityPool(uint capacity = SGP_ENTITY_POOL_DEF_CAPACITY);
+  virtual ~sgpEntityPool();
+
+  /// returns recycled entity or SC_NULL if pool is empty
+  sgpEntityBase *acquire();
+  /// makes entity return to this pool on dispose()
+  void attach(sgpEntityBase *entity);
+  /// stores entity for reuse or deletes it if pool is full
+  void release(sgpEntityBase *entity);
+  /// returns entity to it's pool or deletes it if it is not pooled
+  static void dispose(sgpEntityBase *entity);
+
+  void clear();
+  uint size() const { return m_items.size(); }
+  uint getCapacity() const { return m_capacity; }
+  void setCapacity(uint value);
+  ulong64 getReuseCount() const { return m_reuseCount; }
+  ulong64 getAllocCount() const { return m_allocCount; }
+  void getCounters(scDataNode &output) const;
+protected:
+  std::vector<sgpEntityBase *> m_items;
+  uint m_capacity;
+  ulong64 m_reuseCount;
+  ulong64 m_allocCount;
+};
+
+/// clone allocator for boost pointer containers - disposes entities via their pool
+struct sgpEntityCloneAllocator {
+  template<class U>
+  static U *allocate_clone(const U &r) 
+  {
+    return boost::heap_clone_allocator::allocate_clone(r);
+  }
+
+  template<class U>
+  static void deallocate_clone(const U *r) 
+  {
+    sgpEntityPool::dispose(const_cast<U *>(r));
+  }
+};
+
+#endif // _SGPENTITYPOOL_H__
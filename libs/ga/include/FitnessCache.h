@@ -0,0 +1,108 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        FitnessCache.h
+// Project:     sgpLib
+// Purpose:     Cache of fitness values indexed by genome hash.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SGPFITCACHE_H__
+#define _SGPFITCACHE_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/** \file FitnessCache.h
+\brief Cache of fitness values indexed by genome hash.
+
+Used by evaluation operator to skip calc() for genomes already evaluated
+(elite copies, entities not touched by mutation / crossover).
+Genome is identified by two independent 64-bit hashes, 
+size of cache is limited, entries are replaced using CLOCK algorithm.
+Cache should be cleared when fitness function changes it's behaviour 
+(restart, dynamic parameters). Only successful calculations should be stored.
+Not thread-safe.
+*/
+
+// ----------------------------------------------------------------------------
+// Headers
+// ----------------------------------------------------------------------------
+#include <vector>
+
+#include <boost/unordered_map.hpp>
+
+#include "sc/dtypes.h"
+
+#include "sgp/FitnessValue.h"
+#include "sgp/EntityBase.h"
+
+// ----------------------------------------------------------------------------
+// Simple type definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Forward class definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Constants
+// ----------------------------------------------------------------------------
+const uint SGP_FIT_CACHE_DEF_CAPACITY = 4096;
+
+// ----------------------------------------------------------------------------
+// Class definitions
+// ----------------------------------------------------------------------------
+/// genome identifier
+struct sgpGenomeKey {
+  ulong64 hash;
+  ulong64 check;
+};
+
+class sgpFitnessCache {
+public:
+  // construct
+  sgpFitnessCache(uint capacity = SGP_FIT_CACHE_DEF_CAPACITY);
+  virtual ~sgpFitnessCache();
+  // properties
+  uint getCapacity() const;
+  /// changes max number of entries, clears cache
+  void setCapacity(uint value);
+  uint size() const;
+  // run
+  void clear();
+  /// returns true if fitness for entity's genome was found
+  bool find(const sgpEntityBase &entity, sgpFitnessValue &fitness);
+  /// returns true if fitness for entity's genome was found, key of genome is returned for later insert
+  bool find(const sgpEntityBase &entity, sgpFitnessValue &fitness, sgpGenomeKey &key);
+  /// stores fitness calculated for entity's genome
+  void insert(const sgpEntityBase &entity, const sgpFitnessValue &fitness);
+  /// stores fitness calculated for genome with a given key
+  void insert(const sgpGenomeKey &key, const sgpFitnessValue &fitness);
+  static void calcKey(const sgpEntityBase &entity, sgpGenomeKey &output, sgpGaGenome &genomeBuffer);
+  // stats
+  ulong64 getHitCount() const;
+  ulong64 getMissCount() const;
+  void resetCounters();
+  void getCounters(scDataNode &output) const;
+protected:
+  struct sgpFitnessCacheEntry {
+    sgpGenomeKey key;
+    sgpFitnessValue fitness;
+    bool referenced;
+  };
+  typedef std::vector<sgpFitnessCacheEntry> sgpFitnessCacheEntryList;
+  typedef boost::unordered_map<ulong64, uint> sgpFitnessCacheIndex;
+
+  uint allocEntry();
+private:
+  uint m_capacity;
+  uint m_clockHand;
+  sgpFitnessCacheEntryList m_entries;
+  sgpFitnessCacheIndex m_index;
+  sgpGaGenome m_genomeBuffer;
+  ulong64 m_hitCount;
+  ulong64 m_missCount;
+};
+
+#endif // _SGPFITCACHE_H__
@@ -24,6 +24,7 @@
 #include "sgp\FitnessValue.h"
 #include "sgp\FitnessDefs.h"
 #include "sgp\EntityBase.h"
+#include "sgp/FitnessMatrix.h"
 
 enum sgpGpStopStatus {
   gssNull = 0,
@@ -36,6 +37,19 @@ enum sgpGpStopStatus {
 typedef std::vector<bool> sgpObjectiveSet; 
 typedef std::vector<int> sgpObjectiveSigns; 
 
+/// Input of calcBatch - list of entities to be evaluated
+struct sgpFitnessBatch {
+  uint count;
+  /// entity indices in generation [count]
+  const uint *entityIndices;
+  /// entities [count]
+  const sgpEntityBase * const *entities;
+  /// genomes in one buffer [count x genomeSize], row i = entities[i], 
+  /// SC_NULL if entities do not keep genome as uint vector
+  const uint *genomes;
+  uint genomeSize;
+};
+
 class sgpFitnessFunction {
 public:
   // construct
@@ -48,7 +62,18 @@ public:
   virtual int getFunctionId() const = 0;
 
   // run
+  /// Calculates fitness of a single entity.
+  /// Can be called concurrently from several threads (see sgpGaOperatorEvaluatePar), 
+  /// so implementation must not modify any shared state - all working data should be local.
+  /// Stop status should be changed only outside of calc (initProcess / postProcess).
   virtual bool calc(uint entityIndex, const sgpEntityBase *entity, sgpFitnessValue &fitness) const = 0;
+
+  /// returns <true> if function provides own calcBatch, which is then preferred by evaluation operator
+  virtual bool isBatchSupported() const { return false; }
+  /// Calculates fitness for several entities at once, row i of output = fitness of batch.entities[i]. 
+  /// Output is sized by caller to [batch.count x getObjectiveCount()].
+  /// Same reentrancy rules apply as for calc. Default version calls calc for each entity.
+  virtual bool calcBatch(const sgpFitnessBatch &batch, sgpFitnessMatrix &output) const;
   
   /// Reset any internal state variables to initial state, used for evolution restarts.
   virtual void reset() { m_stopStatus = gssNull; }
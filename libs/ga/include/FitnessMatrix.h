@@ -0,0 +1,116 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        FitnessMatrix.h
+// Project:     sgpLib
+// Purpose:     Contiguous storage of fitness vectors for many entities.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SGPFITMATRIX_H__
+#define _SGPFITMATRIX_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/** \file FitnessMatrix.h
+\brief Contiguous storage of fitness vectors for many entities.
+
+Row = entity, column = objective. All values are stored in a single 
+row-major buffer, so batch functions can read / write it directly.
+*/
+
+// ----------------------------------------------------------------------------
+// Headers
+// ----------------------------------------------------------------------------
+#include <vector>
+#include <cassert>
+
+#include "sc/dtypes.h"
+#include "sc/utils.h"
+
+#include "sgp/FitnessValue.h"
+
+// ----------------------------------------------------------------------------
+// Simple type definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Forward class definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Constants
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Class definitions
+// ----------------------------------------------------------------------------
+class sgpFitnessMatrix {
+public:
+  sgpFitnessMatrix(): m_rowCount(0), m_colCount(0) {}
+  sgpFitnessMatrix(uint rowCount, uint colCount): m_rowCount(0), m_colCount(0) { resize(rowCount, colCount); }
+
+  /// changes dimensions, contents is undefined after that
+  void resize(uint rowCount, uint colCount) {
+    m_rowCount = rowCount;
+    m_colCount = colCount;
+    m_data.resize(rowCount * colCount);
+  }
+
+  void clear() {
+    m_rowCount = m_colCount = 0;
+    m_data.clear();
+  }
+
+  uint getRowCount() const { return m_rowCount; }
+  uint getColCount() const { return m_colCount; }
+
+  double *getData() { return m_data.empty() ? SC_NULL : &m_data[0]; }
+  const double *getData() const { return m_data.empty() ? SC_NULL : &m_data[0]; }
+
+  double *getRow(uint rowIndex) { 
+    assert(rowIndex < m_rowCount);
+    return &m_data[rowIndex * m_colCount]; 
+  }
+
+  const double *getRow(uint rowIndex) const { 
+    assert(rowIndex < m_rowCount);
+    return &m_data[rowIndex * m_colCount]; 
+  }
+
+  double get(uint rowIndex, uint colIndex) const { 
+    assert(colIndex < m_colCount);
+    return m_data[rowIndex * m_colCount + colIndex]; 
+  }
+
+  void set(uint rowIndex, uint colIndex, double value) { 
+    assert(colIndex < m_colCount);
+    m_data[rowIndex * m_colCount + colIndex] = value; 
+  }
+
+  void getRow(uint rowIndex, sgpFitnessValue &output) const {
+    const double *row = getRow(rowIndex);
+    output.resize(m_colCount);
+    for(uint i=0; i != m_colCount; i++)
+      output[i] = row[i];
+  }
+
+  /// copies fitness vector to row, missing values are set to zero
+  void setRow(uint rowIndex, const sgpFitnessValue &value) {
+    double *row = getRow(rowIndex);
+    uint copyCnt = SC_MIN(m_colCount, value.size());
+    uint i = 0;
+    for(; i != copyCnt; i++)
+      row[i] = value[i];
+    for(; i != m_colCount; i++)
+      row[i] = 0.0;
+  }
+
+private:
+  uint m_rowCount;
+  uint m_colCount;
+  std::vector<double> m_data;
+};
+
+#endif // _SGPFITMATRIX_H__
@@ -37,6 +37,12 @@
 // Constants
 // ----------------------------------------------------------------------------
 
+/// how items with equal values are handled by top-K selection
+enum sgpTopTieMode {
+  ttmDistinct = 0, ///< only first (lowest index) item of each value is returned
+  ttmKeepAll = 1   ///< all items are returned, equal values ordered by index
+};
+
 // ----------------------------------------------------------------------------
 // Class definitions
 // ----------------------------------------------------------------------------
@@ -48,7 +54,12 @@ public:
   sgpFitnessScanner(const scDataNode *input);
   sgpFitnessScanner(const sgpGaGeneration *input);
   virtual ~sgpFitnessScanner();
-  void getTopGenomesByObjective(int limit, uint objectiveIndex, sgpEntityIndexList &indices);  
+  void getTopGenomesByObjective(int limit, uint objectiveIndex, sgpEntityIndexList &indices, sgpTopTieMode tieMode = ttmDistinct);  
+  /// returns up to limit indices ordered by objective value desc, lower index first for equal values
+  void getTopIndicesByObjective(uint limit, uint objectiveIndex, sgpTopTieMode tieMode, sgpEntityIndexList &indices) const;
+  /// top-K for several objectives, fitness of each item is read once
+  void getTopIndicesByObjectives(uint limit, const std::vector<uint> &objectiveIndices, sgpTopTieMode tieMode, 
+    std::vector<sgpEntityIndexList> &indices) const;
   uint getBestGenomeIndexByObjective(uint objIndex, bool searchForMin = false) const;
   uint findBestWithWeights(const sgpWeightVector &weights, const sgpEntityIndexSet *requiredItems, const sgpEntityIndexSet &ignoreSet, bool includeFront) const;
   uint findBestWithWeights(const sgpWeightVector &weights, const sgpEntityIndexSet *requiredItems = SC_NULL) const;
@@ -67,6 +78,9 @@ protected:
   uint findBestWithWeightsMultiObj(const sgpWeightVector &weights, const sgpEntityIndexSet *requiredItems, const sgpEntityIndexSet &ignoreSet, bool includeFront) const;
   void intFindBestWithWeights(uint &bestIndex, uint *bestCount, const sgpWeightVector &weights, const sgpEntityIndexSet *requiredItems, const sgpEntityIndexSet &ignoreSet, bool includeFront) const;
   uint countEntitiesWithFitness(const sgpFitnessValue &fitValue) const;
+  /// orders items by Pareto front ranks of weight levels (lexicographically), then by index;
+  /// only first limit items are guaranteed to be fully ordered
+  void sortByWeightLevels(const sgpWeightVector &weights, uint limit, sgpEntityIndexList &items) const;
 protected:
   std::auto_ptr<sgpFitnessStorage> m_storage;  
 };
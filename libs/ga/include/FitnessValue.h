@@ -37,6 +37,16 @@
 // ----------------------------------------------------------------------------
 // Constants
 // ----------------------------------------------------------------------------
+/// number of objectives stored without heap allocation, each entity (also 
+/// store-bound sgpEntityForGaUIntView) carries this buffer.
+/// Projects using many objectives (e.g. 20-30) should define it as 32.
+#ifndef SGP_FITNESS_INLINE_CAPACITY
+#define SGP_FITNESS_INLINE_CAPACITY 4
+#endif
+
+#if SGP_FITNESS_INLINE_CAPACITY < 1
+#error SGP_FITNESS_INLINE_CAPACITY must be at least 1
+#endif
 
 // ----------------------------------------------------------------------------
 // Class definitions
@@ -44,120 +54,101 @@
 
 //typedef std::vector<double> sgpFitnessValue;
 
+/// Fitness vector. Up to SGP_FITNESS_INLINE_CAPACITY values are stored inline, longer vectors on heap.
+/// Storage can be also bound to external buffer (e.g. row of population's fitness matrix),
+/// it is then used as long as vector fits in it.
 class sgpFitnessValue {
 public:
   typedef uint size_type;
 
   // objective index offset
   enum { 
-     SGP_OBJ_OFFSET = 0
+     SGP_OBJ_OFFSET = 0,
+     INLINE_CAPACITY = SGP_FITNESS_INLINE_CAPACITY
   };
 
-  sgpFitnessValue(): m_valueList(NULL) { }
-
-  sgpFitnessValue(const sgpFitnessValue &src) { 
-    
-    if (src.m_valueList == NULL)
-    {
-      m_singleValue = src.m_singleValue;
-      m_valueList = NULL;
-    } else {
-      m_valueList = new std::vector<double>();
-      (*m_valueList) = (*src.m_valueList);
-    }
+  sgpFitnessValue(): m_data(m_inline), m_size(1), m_capacity(INLINE_CAPACITY), m_external(false) { m_inline[0] = 0.0; }
 
+  sgpFitnessValue(const sgpFitnessValue &src): m_data(m_inline), m_size(1), m_capacity(INLINE_CAPACITY), m_external(false) { 
+    assign(src);
   }
 
   ~sgpFitnessValue() { 
-     if (m_valueList != NULL) 
-     {
-       delete m_valueList;
-       m_valueList = NULL;
-     }
+    releaseData();
   }
 
   sgpFitnessValue& operator=(const sgpFitnessValue& rhs)
   {
     if (&rhs != this)
-    {
-      if (rhs.m_valueList == NULL)
-      {
-        resize(1);
-        m_singleValue = rhs.m_singleValue;
-      } else {
-        resize(rhs.size());
-        (*m_valueList) = (*rhs.m_valueList);
-      }
-    }
+      assign(rhs);
     return *this;
   }
 
   const double &operator[](size_type idx) const {
-    if (m_valueList == NULL)
-    {
-      assert(idx < 2);
-      return m_singleValue;
-    } else {
-      return (*m_valueList)[idx];
-    }
+    assert((m_size > 1) || (idx < 2));
+    return m_data[(m_size > 1) ? idx : 0];
   }
 
   double &operator[](size_type idx) {
-    if (m_valueList == NULL)
-    {
-      assert(idx < 2);
-      return m_singleValue;
-    } else {
-      return (*m_valueList)[idx];
-    }
+    assert((m_size > 1) || (idx < 2));
+    return m_data[(m_size > 1) ? idx : 0];
   }
 
   double getValue(size_type index) const {
-    if (m_valueList == NULL) {
-      assert(index < 2);
-      return m_singleValue;
-    } else {
-      return (*m_valueList)[index];
-    }
+    return (*this)[index];
   }
 
   void setValue(size_type index, double value) {
-    if (m_valueList == NULL) {
-      assert(index < 2);
-      m_singleValue = value;
-    } else {
-      (*m_valueList)[index] = value;
-    }
+    (*this)[index] = value;
   }
 
   size_type size() const { 
-    if (m_valueList == NULL)
-      return 1;
-    else
-      return m_valueList->size();
+    return m_size;
   }
 
+  /// direct access to values, valid until next resize
+  const double *getData() const { return m_data; }
+  double *getData() { return m_data; }
+
+  const double *begin() const { return m_data; }
+  const double *end() const { return m_data + m_size; }
+
   void resize(size_type newSize)
   {
     if (newSize > SGP_OBJ_OFFSET + 1)
     {
-      if (m_valueList == NULL)
-        m_valueList = new std::vector<double>();
-      m_valueList->resize(newSize);
+      reserve(newSize);
+      for(size_type i = m_size; i < newSize; i++)
+        m_data[i] = 0.0;
+      m_size = newSize;
     } else {
-      if (m_valueList != NULL) {
-        delete m_valueList;
-        m_valueList = NULL;
+      if ((m_data != m_inline) && !m_external) {
+        m_inline[0] = m_data[0];
+        releaseData();
       }
+      m_size = 1;
     }
   }
 
   void clear()
   {
-     if (m_valueList != NULL) 
-       m_valueList->clear();
+    if (m_size > 1) 
+      m_size = 0;
   }
 
+  /// use external buffer as storage, buffer has to be valid as long as it is bound
+  void bind(double *data, size_type capacity)
+  {
+    assert(capacity > 0);
+    releaseData();
+    m_data = data;
+    m_capacity = capacity;
+    m_external = true;
+    m_size = 1;
+  }
+
+  bool isBound() const { return m_external; }
+
   /// Compare fitness values
   /// \return Returns:
   ///  0 - if values are equal,
@@ -195,8 +186,46 @@ public:
   }
 
 private:
-  double m_singleValue;
-  std::vector<double> *m_valueList;
+  void assign(const sgpFitnessValue &src) {
+    if (src.m_size > 1) {
+      resize(src.m_size);
+      for(size_type i = 0; i != m_size; i++)
+        m_data[i] = src.m_data[i];
+    } else {
+      resize(1);
+      m_data[0] = src.m_data[0];
+      m_size = src.m_size;
+    }
+  }
+
+  // makes space for newSize values, keeps existing values
+  void reserve(size_type newSize) {
+    if (newSize <= m_capacity)
+      return;
+
+    double *newData = new double[newSize];
+    size_type copyCnt = (m_size > 0) ? m_size : 0;
+    for(size_type i = 0; i != copyCnt; i++)
+      newData[i] = m_data[i];
+    releaseData();
+    m_data = newData;
+    m_capacity = newSize;
+  }
+
+  void releaseData() {
+    if ((m_data != m_inline) && !m_external) 
+      delete [] m_data;
+    m_data = m_inline;
+    m_capacity = INLINE_CAPACITY;
+    m_external = false;
+  }
+
+private:
+  double *m_data;
+  size_type m_size;
+  size_type m_capacity;
+  bool m_external;
+  double m_inline[INLINE_CAPACITY];
 };
 
 
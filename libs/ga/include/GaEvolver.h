@@ -125,6 +125,7 @@ typedef boost::ptr_vector<sgpEntityBase> sgpGaGenomeWorkList;
 // ----------------------------------------------------------------------------
 // Forward class definitions
 // ----------------------------------------------------------------------------
+class sgpRandomSource;
 
 // ----------------------------------------------------------------------------
 // Constants
@@ -184,6 +185,11 @@ public:
   /// Executed after whole generation was evaluated. Returns <false> if process should be aborted.
   virtual bool postProcess(sgpGaGeneration &newGeneration) {return true;}
 
+  /// Returns <true> if postProcess can be executed again on fitness which it already processed
+  /// (e.g. it does not modify fitness). Required by incremental evaluation, where unchanged 
+  /// entities keep fitness from previous step.
+  virtual bool isIncrementalSupported() const {return false;}
+
   /// Returns list of dynamic parameters - parameters that can be optimized during evolution
   virtual bool describeDynamicParams(sgpGaGenomeMetaList &output, scDataNode &nameList, const scDataNode &filter = scDataNode()) {return false;}
   /// Updates dynamic parameters - parameters that can be optimized during evolution
@@ -314,6 +320,9 @@ public:
 class sgpGaOperatorEvaluate: public sgpGaOperator {
 public:
   virtual bool execute(uint stepNo, bool isNewGen, sgpGaGeneration &generation) = 0;
+  /// if enabled, only entities with modified genome are evaluated;
+  /// operators which do not support it (e.g. fitness filters modifying fitness in-place) throw scError 
+  virtual void setIncrementalMode(bool value);
 };
 
 class sgpGaOperatorSelect: public sgpGaOperator {
@@ -386,6 +395,8 @@ public:
   static void getRandomRanged(const scDataNode &minValue, const scDataNode &maxValue, scDataNode &output);
   static void getRandomRanged(const scDataNode &startValue, 
     const scDataNode &minValue, const scDataNode &maxValue, scDataNode &output);
+  static void getRandomRanged(const scDataNode &startValue, 
+    const scDataNode &minValue, const scDataNode &maxValue, scDataNode &output, sgpRandomSource &random);
 };
 
 class sgpGaOperatorInitEntity: public sgpGaOperator {
@@ -450,6 +461,10 @@ public:
   static void getTopGenomesByWeights(const sgpGaGeneration &input, int limit, 
     const sgpWeightVector &weights, sgpEntityIndexList &indices);
   void setEliteLimit(uint a_limit);
+  /// evaluate only entities modified in the current step (disabled by default),
+  /// evaluation fails with scError if evaluation operator or fitness function does not support it
+  void setIncrementalEval(bool value);
+  bool getIncrementalEval() const;
   void setPopulationSize(uint a_size);
   uint getPopulationSize() const;
   sgpGaOperator *getOperator(const scString &operatorType) const;
@@ -497,6 +512,7 @@ protected:
 // configuration
   uint m_eliteLimit;
   uint m_populationSize;
+  bool m_incrementalEval;
   sgpGaGenomeMetaList m_genomeMeta;
   sgpGaOperatorMap m_operatorMap;
   scObjectRegistry m_operatorReg;
@@ -22,6 +22,7 @@
 // Headers
 // ----------------------------------------------------------------------------
 #include "sgp\EntityBase.h"
+#include "sgp/EntityPool.h"
 #include "base\StructureWriter.h"
 
 // ----------------------------------------------------------------------------
@@ -78,7 +79,7 @@ public:
   virtual sgpGaGeneration *newEmpty() const = 0;
 
 protected:
-  typedef boost::ptr_vector<sgpEntityBase> sgpGaGenomeWorkList;
+  typedef boost::ptr_vector<sgpEntityBase, sgpEntityCloneAllocator> sgpGaGenomeWorkList;
   sgpGaGenomeWorkList m_items;
 };
   
@@ -31,6 +31,7 @@
 // ----------------------------------------------------------------------------
 // Forward class definitions
 // ----------------------------------------------------------------------------
+class sgpEntityForGaUInt;
 
 // ----------------------------------------------------------------------------
 // Constants
@@ -43,7 +44,7 @@
 class sgpGaGenerationUInt: public sgpGaGeneration {
   typedef sgpGaGeneration inherited;
 public:
-  sgpGaGenerationUInt(): inherited() {}
+  sgpGaGenerationUInt(): inherited(), m_pool(new sgpEntityPool()) {}
   virtual ~sgpGaGenerationUInt() {}
 
   virtual sgpEntityBase *cloneItem(int index) const;
@@ -51,11 +52,18 @@ public:
   virtual sgpEntityBase *newItem(const sgpEntityBase &src) const;
 
   virtual sgpGaGeneration *newEmpty() const {
-  	return new sgpGaGenerationUInt();
+  	return new sgpGaGenerationUInt(m_pool);
   }
   virtual base::StructureWriterIntf *newWriterForCode(const scDataNode &extraValues) const;
   virtual base::StructureWriterIntf *newWriterForFitness(const scDataNode &extraValues) const;
+  /// entity pool shared with generations created by newEmpty()
+  const sgpEntityPoolPtr &getPool() const { return m_pool; }
 protected:
+  sgpGaGenerationUInt(const sgpEntityPoolPtr &pool): inherited(), m_pool(pool) {}
+  sgpEntityForGaUInt *acquireItem() const;
+  sgpEntityForGaUInt *attachItem(sgpEntityForGaUInt *item) const;
+
+  sgpEntityPoolPtr m_pool;
 };
   
 
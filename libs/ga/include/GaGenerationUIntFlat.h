@@ -0,0 +1,69 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        GaGenerationUIntFlat.h
+// Project:     sgpLib
+// Purpose:     Entity container for GA algorithms - uint items in flat storage.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SGPGAGENERUINTFLAT_H__
+#define _SGPGAGENERUINTFLAT_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/** \file GaGenerationUIntFlat.h
+\brief Entity container for GA algorithms - uint items in flat storage.
+
+Genomes and fitness values of all entities are kept in one 
+sgpPopulationStoreUInt (structure-of-arrays), entities are views on it.
+Generations created with newEmpty() share the same store, so entities 
+can be moved between them without copying genome data.
+*/
+
+// ----------------------------------------------------------------------------
+// Headers
+// ----------------------------------------------------------------------------
+#include "sgp/GaGenerationUInt.h"
+#include "sgp/PopulationStoreUInt.h"
+
+// ----------------------------------------------------------------------------
+// Simple type definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Forward class definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Constants
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Class definitions
+// ----------------------------------------------------------------------------
+
+class sgpGaGenerationUIntFlat: public sgpGaGenerationUInt {
+  typedef sgpGaGenerationUInt inherited;
+public:
+  sgpGaGenerationUIntFlat(uint genomeSize, uint objectiveCount, uint chunkSize = SGP_POP_STORE_DEF_CHUNK_SIZE);
+  virtual ~sgpGaGenerationUIntFlat();
+
+  virtual sgpEntityBase *cloneItem(int index) const;
+  virtual sgpEntityBase *newItem() const;
+  virtual sgpEntityBase *newItem(const sgpEntityBase &src) const;
+
+  virtual sgpGaGeneration *newEmpty() const {
+  	return new sgpGaGenerationUIntFlat(m_store);
+  }
+
+  const sgpPopulationStoreUIntPtr &getStore() const { return m_store; }
+protected:
+  sgpGaGenerationUIntFlat(const sgpPopulationStoreUIntPtr &store);
+private:
+  sgpPopulationStoreUIntPtr m_store;
+};
+  
+
+#endif // _SGPGAGENERUINTFLAT_H__
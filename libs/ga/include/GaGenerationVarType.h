@@ -31,6 +31,7 @@
 // ----------------------------------------------------------------------------
 // Forward class definitions
 // ----------------------------------------------------------------------------
+class sgpEntityForGaVarType;
 
 // ----------------------------------------------------------------------------
 // Constants
@@ -43,7 +44,7 @@
 class sgpGaGenerationVarType: public sgpGaGeneration {
   typedef sgpGaGeneration inherited;
 public:
-  sgpGaGenerationVarType(): inherited() {}
+  sgpGaGenerationVarType(): inherited(), m_pool(new sgpEntityPool()) {}
   virtual ~sgpGaGenerationVarType() {}
 
   virtual sgpEntityBase *cloneItem(int index) const;
@@ -51,10 +52,17 @@ public:
   virtual sgpEntityBase *newItem(const sgpEntityBase &src) const;
 
   virtual sgpGaGeneration *newEmpty() const {
-  	return new sgpGaGenerationVarType();
+  	return new sgpGaGenerationVarType(m_pool);
   }
   
+  /// entity pool shared with generations created by newEmpty()
+  const sgpEntityPoolPtr &getPool() const { return m_pool; }
 protected:
+  sgpGaGenerationVarType(const sgpEntityPoolPtr &pool): inherited(), m_pool(pool) {}
+  sgpEntityForGaVarType *acquireItem() const;
+  sgpEntityForGaVarType *attachItem(sgpEntityForGaVarType *item) const;
+
+  sgpEntityPoolPtr m_pool;
 };
   
 
@@ -0,0 +1,71 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        GaGenomeMetaIndex.h
+// Project:     sgpLib
+// Purpose:     Index of gene offsets for genome meta information.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SGPGAGENMETAIDX_H__
+#define _SGPGAGENMETAIDX_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/** \file GaGenomeMetaIndex.h
+\brief Index of gene offsets for genome meta information.
+
+Translates gene point (0..sum(genSize)-1) to index of variable containing it.
+Built once per meta list: prefix sums of variable sizes are searched with
+binary search, for genomes with up to SGP_GA_META_INDEX_DIRECT_LIMIT points
+a direct point-to-variable table is used.
+*/
+
+// ----------------------------------------------------------------------------
+// Headers
+// ----------------------------------------------------------------------------
+#include <vector>
+
+#include "sc/dtypes.h"
+
+#include "sgp/GaEvolver.h"
+
+// ----------------------------------------------------------------------------
+// Simple type definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Forward class definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Constants
+// ----------------------------------------------------------------------------
+/// max number of points for which direct lookup table is built
+const uint SGP_GA_META_INDEX_DIRECT_LIMIT = 65536;
+
+// ----------------------------------------------------------------------------
+// Class definitions
+// ----------------------------------------------------------------------------
+class sgpGaGenomeMetaIndex {
+public:
+  sgpGaGenomeMetaIndex();
+  void build(const sgpGaGenomeMetaList &list);
+  void clear();
+  /// total size of genome in points
+  uint getPointCount() const { return m_offsets.empty() ? 0 : m_offsets.back(); }
+  uint getVarCount() const { return m_offsets.empty() ? 0 : m_offsets.size() - 1; }
+  /// offset of first point of variable
+  uint getVarOffset(uint varIndex) const { return m_offsets[varIndex]; }
+  /// returns index of (non-empty) variable containing point, getVarCount() if point is outside of genome
+  uint findVar(uint point) const;
+  /// returns index of first non-empty variable starting at or after point, getVarCount() if not found
+  uint findVarFrom(uint point) const;
+protected:
+  std::vector<uint> m_offsets;
+  std::vector<uint> m_pointToVar;
+  std::vector<bool> m_emptyVar;
+};
+
+#endif // _SGPGAGENMETAIDX_H__
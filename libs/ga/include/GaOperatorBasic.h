@@ -32,16 +32,19 @@
 
 //sgp
 #include "sgp/GaEvolver.h"
+#include "sgp/FitnessCache.h"
+#include "sgp/GaGenomeMetaIndex.h"
+#include "sgp/RandomStream.h"
+#include "sgp/WorkStealScheduler.h"
+#include "sgp/TournamentGroup.h"
 
 // ----------------------------------------------------------------------------
 // Simple type definitions
 // ----------------------------------------------------------------------------
-typedef std::set<uint> sgpTournamentGroup;
 
 // ----------------------------------------------------------------------------
 // Forward class definitions
 // ----------------------------------------------------------------------------
-
 // ----------------------------------------------------------------------------
 // Constants
 // ----------------------------------------------------------------------------
@@ -50,6 +53,7 @@ const double SGP_GA_DEF_OPER_PROB_XOVER = 0.06;
 const double SGP_GA_DEF_SPECIES_THRESHOLD = 0.5;
 const uint SGP_GA_DEF_TOURNAMENT_SIZE = 4;
 const double SGP_GA_DEF_SELECT_DIST_FACTOR = 0.33;
+const uint SGP_GA_DEF_EVAL_BATCH_SIZE = 256;
 
 // ----------------------------------------------------------------------------
 // Class definitions
@@ -110,16 +114,76 @@ public:
   void setProbability(double aValue);
   virtual void setMetaInfo(const sgpGaGenomeMetaList &list);
   virtual void getCounters(scDataNode &output) {}
+  /// if enabled, distance to next mutation is sampled from geometric distribution
+  /// instead of drawing each mutation trial - number of RNG calls is proportional
+  /// to number of mutations
+  bool getSkipSampling() const;
+  void setSkipSampling(bool value);
+  /// if enabled, entities are mutated concurrently, each one with own random stream 
+  /// keyed by (seed, step, entity) - result does not depend on number of threads.
+  /// Used only if hasDefaultHooks() returns true, sequential mode is used otherwise.
+  bool getParallel() const;
+  void setParallel(bool value);
+  /// number of worker threads in parallel mode, 0 = use OpenMP default
+  uint getThreadCount() const;
+  void setThreadCount(uint value);
+  /// seed of random streams, 0 = new seed is taken from global RNG on each execute
+  ulong64 getRandomSeed() const;
+  void setRandomSeed(ulong64 value);
+  /// used by worker tasks
+  bool mutateEntityPar(sgpGaGeneration &generation, uint entityIndex, uint workerNo, sgpRandomSource &random);
 protected:  
-  inline void mutateVar(const sgpGaGenomeMetaInfo &metaInfo, uint offset, scDataNode &var);
+  /// reads change probability & point limit of each entity
+  void prepareEntities(sgpGaGeneration &newGeneration);
+  /// draws number of mutations per entity, returns list of entities to be mutated
+  void sampleMutationCounts(sgpGaGeneration &newGeneration, sgpEntityIndexList &output);
+  void executeParallel(sgpGaGeneration &newGeneration, const sgpEntityIndexList &itemList);
+  /// called before entity's change probability & point limit are read in skip-sampling & parallel mode
+  virtual void prepareEntity(uint entityIndex) {}
+  /// called for each changed entity after parallel pass, on caller's thread
+  virtual void finishEntity(uint entityIndex, sgpEntityBase &entity) {}
+  uint getTrialCount(uint entityIndex, sgpRandomSource &random);
+  bool isTrialHit(uint entityIndex, sgpRandomSource &random);
+  inline void mutateVar(const sgpGaGenomeMetaInfo &metaInfo, uint offset, scDataNode &var, sgpRandomSource &random);
+  inline void mutateVarUInt(const sgpGaGenomeMetaInfo &metaInfo, uint offset, uint &var, sgpRandomSource &random);
+  inline uint flipRangedBit(const sgpGaGenomeMetaInfo &metaInfo, uint value, sgpRandomSource &random);
   virtual void invokeNextEntity() {} 
+  /// mutates entity, returns true if entity was changed
+  virtual bool processEntity(uint entityIndex, sgpEntityBase &entity);
+  /// mutates entity using a given buffer & RNG, does not use virtual per-entity hooks
+  bool mutateEntity(uint entityIndex, sgpEntityBase &entity, sgpGaGenome &genomeBuffer, sgpRandomSource &random);
+  /// mutates genome in generic form using global RNG, used in sequential mode for entities 
+  /// without uint genome data or if hasDefaultHooks() returns false
   virtual bool processGenome(uint entityIndex, sgpGaGenome &genome);
+  /// returns true if processEntity() & processGenome() can be skipped (in-place & parallel mode);
+  /// default is true only for this exact class, subclasses which keep the hooks
+  /// equivalent can override it
+  virtual bool hasDefaultHooks() const;
+  /// mutates genome in generic form using a given RNG
+  bool mutateGenome(uint entityIndex, sgpGaGenome &genome, sgpRandomSource &random);
+  /// mutates uint genome in-place
+  bool processGenomeData(uint entityIndex, sgpEntityBase &entity, sgpRandomSource &random);
   virtual void beforeExecute(sgpGaGeneration &newGeneration);
   virtual double getEntityChangeProb();
   virtual uint getChangePointLimit();
 protected:
   double m_probability;  
   uint m_genomeSize;
+  sgpGaGenomeMetaIndex m_metaIndex;
+  sgpGaGenome m_genomeBuffer;
+  bool m_skipSampling;
+  bool m_parallel;
+  // parallel mode used by current execute
+  bool m_parallelActive;
+  ulong64 m_randomSeed;
+  uint m_stepNo;
+  sgpWorkStealScheduler m_scheduler;
+  std::vector<sgpGaGenome> m_workerGenomeBuffers;
+  std::vector<double> m_entityChangeProbs;
+  std::vector<uint> m_entityPointLimits;
+  // number of mutations per entity in skip-sampling mode
+  std::vector<uint> m_entityMutationCounts;
+  sgpEntityIndexList m_taskList;
 };
 
 // mutate operator with yield support
@@ -133,22 +197,62 @@ public:
   void setYieldSignal(scSignal *value);
 protected:
   virtual void invokeNextEntity();
+  virtual bool hasDefaultHooks() const;
 private:
   scSignal *m_yieldSignal;
 };
 
+/// working buffers for batch evaluation
+struct sgpEvalBatchBuffer {
+  std::vector<const sgpEntityBase *> entities;
+  std::vector<uint> genomes;
+  sgpFitnessMatrix fitness;
+  sgpFitnessValue fitValue;
+};
+
 class sgpGaOperatorEvaluateBasic: public sgpGaOperatorEvaluate {
 public:
+  sgpGaOperatorEvaluateBasic();
   void setFitnessFunc(sgpFitnessFunction *value);
   void setOperatorMonitor(sgpGaOperatorEvalMonitorIntf *value);
+  /// optional cache of already calculated fitness values, not owned
+  void setFitnessCache(sgpFitnessCache *value);
+  /// skip entities with unchanged genome; execute throws scError if fitness function 
+  /// has post-processing which does not support it (see sgpFitnessFunctionEx::isIncrementalSupported)
+  virtual void setIncrementalMode(bool value);
+  /// max number of entities passed to calcBatch
+  uint getBatchSize() const;
+  void setBatchSize(uint value);
   virtual bool execute(uint stepNo, bool isNewGen, sgpGaGeneration &generation);
 protected: 
   virtual bool evaluateAll(sgpGaGeneration *generation);
   virtual bool evaluateRange(sgpGaGeneration *generation, int first, int last);
+  /// prepares list of entities which need to be calculated, returns result for entities found in cache;
+  /// with cache: fills m_evalKeys and puts entities with genome equal to an already listed one 
+  /// on m_evalDuplicates instead of output
+  virtual bool prepareEvalList(sgpGaGeneration *generation, int first, int last, sgpEntityIndexList &output);
+  /// calculates fitness for listed entities
+  virtual bool evaluateList(sgpGaGeneration *generation, const sgpEntityIndexList &itemList);
+  /// copies fitness of calculated entities to their duplicates
+  void copyDuplicateFitness(sgpGaGeneration *generation, bool evalRes);
+  void storeInCache(sgpGaGeneration *generation, const sgpEntityIndexList &itemList);
+  /// calculates fitness using calcBatch, can be executed concurrently with different buffers
+  bool evaluateBatch(sgpGaGeneration *generation, const uint *itemIndices, uint count, sgpEvalBatchBuffer &buffer) const;
   virtual void invokeNextEntity() {}
 protected:  
   sgpFitnessFunction *m_fitnessFunc;
   sgpGaOperatorEvalMonitorIntf *m_operatorMonitor;
+  sgpFitnessCache *m_fitnessCache;
+  sgpEntityIndexList m_evalList;
+  // genome key of each m_evalList item, filled only when cache is used
+  std::vector<sgpGenomeKey> m_evalKeys;
+  // genome hash -> position in m_evalList
+  boost::unordered_map<ulong64, uint> m_evalKeyIndex;
+  // pairs: entity index, position in m_evalList of entity with the same genome
+  std::vector<std::pair<uint, uint> > m_evalDuplicates;
+  bool m_incrementalMode;
+  uint m_batchSize;
+  sgpEvalBatchBuffer m_batchBuffer;
 };
 
 class sgpGaOperatorEvaluateWithYield: public sgpGaOperatorEvaluateBasic {
@@ -167,10 +271,26 @@ private:
 
 class sgpGaOperatorSelectBasic: public sgpGaOperatorSelect {
 public:
+  // construct
+  sgpGaOperatorSelectBasic();
+  // properties
+  /// stochastic universal sampling: select all items in one sweep using equally spaced pointers
+  bool getSusMode() const;
+  void setSusMode(bool value);
+  // run
   virtual void execute(sgpGaGeneration &input, sgpGaGeneration &output, uint limit);
+protected:
+  void selectByWeights(sgpGaGeneration &input, sgpGaGeneration &output, uint limit, 
+    const std::vector<double> &weights, double weightSum, const char *traceName);
+  /// returns false if weights cannot be used (negative values or zero sum)
+  bool selectUniversal(sgpGaGeneration &input, sgpGaGeneration &output, uint limit, 
+    const std::vector<double> &weights, const char *traceName);
+protected:
+  bool m_susMode;
 };
 
-class sgpGaOperatorSelectPrec: public sgpGaOperatorSelect {
+class sgpGaOperatorSelectPrec: public sgpGaOperatorSelectBasic {
+  typedef sgpGaOperatorSelectBasic inherited;
 public:
   virtual void execute(sgpGaGeneration &input, sgpGaGeneration &output, uint limit);
 };
@@ -189,6 +309,7 @@ public:
 protected:
   inline void genRandomGroup(sgpTournamentGroup &output, const sgpGaGeneration &input, uint limit);  
   inline void getRandomElement(uint &output, const sgpTournamentGroup &group);  
+  void getRandomElement(uint &output, const sgpTournamentGroup &group, sgpRandomSource &random);  
 protected:
   uint m_tournamentSize;  
   double m_temperature;
@@ -261,12 +382,44 @@ public:
   void setProbability(double aValue);
   virtual void setMetaInfo(const sgpGaGenomeMetaList &list);
   virtual void getCounters(scDataNode &output) {}
+  /// if enabled, pairs are selected sequentially and crossed concurrently,
+  /// each pair with own random stream keyed by (seed, step, first entity).
+  /// Pairs are accepted by canCrossGenomes(). Used only if hasDefaultHooks() returns true,
+  /// sequential mode is used otherwise.
+  bool getParallel() const;
+  void setParallel(bool value);
+  /// number of worker threads in parallel mode, 0 = use OpenMP default
+  uint getThreadCount() const;
+  void setThreadCount(uint value);
+  /// seed of random streams, 0 = new seed is taken from global RNG on each execute
+  ulong64 getRandomSeed() const;
+  void setRandomSeed(ulong64 value);
+  /// used by worker tasks
+  bool crossGenomesPar(sgpGaGeneration &newGeneration, uint first, uint second, sgpRandomSource &random);
 protected:
   virtual bool crossGenomes(sgpGaGeneration &newGeneration, uint first, uint second);
+  /// returns true if pair can be crossed, must not modify entities
+  virtual bool canCrossGenomes(sgpGaGeneration &newGeneration, uint first, uint second);
+  /// returns true if crossGenomes() can be skipped (parallel mode);
+  /// default is true only for this exact class
+  virtual bool hasDefaultHooks() const;
+  bool doCrossGenomes(sgpGaGeneration &newGeneration, uint first, uint second, sgpRandomSource &random);
+  void executeParallel(double aProb, sgpGaGeneration &newGeneration);
   void crossVars(sgpGaGenome &firstGenome, sgpGaGenome &secondGenome, uint genIndex, uint endPoint);
+  /// swaps ranged gene in-place
+  void crossVarsUInt(uint *firstGenome, uint *secondGenome, uint genIndex);
 protected:
   double m_probability;  
   uint m_genomeSize;
+  sgpGaGenomeMetaIndex m_metaIndex;
+  // false if meta contains alpha strings, these are crossed in generic form
+  bool m_inPlaceSupported;
+  bool m_parallel;
+  ulong64 m_randomSeed;
+  uint m_stepNo;
+  sgpWorkStealScheduler m_scheduler;
+  // flat list of selected pairs: first, second, first, second...
+  sgpEntityIndexList m_pairList;
 };
 
 
@@ -281,7 +434,8 @@ public:
   // run
   virtual void init();
 protected:
-  virtual bool crossGenomes(sgpGaGeneration &newGeneration, uint first, uint second);
+  virtual bool canCrossGenomes(sgpGaGeneration &newGeneration, uint first, uint second);
+  virtual bool hasDefaultHooks() const;
   virtual double calcGenomeDiff(const sgpGaGenome &genome1, const sgpGaGenome &genome2);
   double calcRangedDiff(const scDataNode &var1, const scDataNode &var2, const scDataNode &minValue, const scDataNode &maxValue);
   virtual void setMetaInfo(const sgpGaGenomeMetaList &list);
@@ -0,0 +1,69 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        GaOperatorEvaluatePar.h
+// Project:     sgpLib
+// Purpose:     Evaluation operator running fitness function on several threads
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SGPGAOPERATOREVALPAR_H__
+#define _SGPGAOPERATOREVALPAR_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/// \file GaOperatorEvaluatePar.h
+///
+/// Parallel version of evaluation operator. 
+/// Each entity (or batch if fitness function supports calcBatch) is a separate 
+/// task of work-stealing scheduler, so entities with very different evaluation 
+/// cost are balanced between workers.
+/// Fitness function's calc() is executed concurrently, so it must be reentrant.
+/// initProcess / postProcess and monitor hooks are still executed on caller's thread.
+/// Requires USE_OPENMP, without it works as sgpGaOperatorEvaluateBasic.
+
+// ----------------------------------------------------------------------------
+// Headers
+// ----------------------------------------------------------------------------
+//sgp
+#include "sgp/GaOperatorBasic.h"
+#include "sgp/WorkStealScheduler.h"
+
+// ----------------------------------------------------------------------------
+// Simple type definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Forward class definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Constants
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Class definitions
+// ----------------------------------------------------------------------------
+class sgpGaOperatorEvaluatePar: public sgpGaOperatorEvaluateBasic {
+  typedef sgpGaOperatorEvaluateBasic inherited;
+public:
+  // construct
+  sgpGaOperatorEvaluatePar();
+  virtual ~sgpGaOperatorEvaluatePar();
+  // properties
+  /// number of worker threads, 0 = use OpenMP default
+  uint getThreadCount() const;
+  void setThreadCount(uint value);
+  /// returns scheduler stats: steal counts & busy time per worker
+  virtual void getCounters(scDataNode &output);
+  void resetCounters();
+  /// used by worker tasks
+  bool evaluateBatchPar(sgpGaGeneration *generation, const uint *itemIndices, uint count, sgpEvalBatchBuffer &buffer) const;
+protected:
+  virtual bool evaluateList(sgpGaGeneration *generation, const sgpEntityIndexList &itemList);
+private:
+  sgpWorkStealScheduler m_scheduler;
+};
+
+#endif // _SGPGAOPERATOREVALPAR_H__
@@ -57,18 +57,20 @@ protected:
   virtual void intExecute(uint stepNo, const sgpGaGeneration &input);
   void rateIslands(const sgpGaGeneration &input, scDataNode &islandRating, uint &bestIslandId);
   virtual void calcIslandsSize(const sgpGaGeneration &input, scDataNode &islandSize);
-  void addIslandRatingForObjective(scDataNode &islandRating, const sgpGaGeneration &input, uint objectiveIndex);
+  void addIslandRatingForObjective(scDataNode &islandRating, const sgpGaGeneration &input, uint objectiveIndex, 
+    const sgpEntityIndexList &topIdList);
   void calcTopIslandStats(const sgpGaGeneration &input, 
-    const scDataNode &topIslandIds,
-    scDataNode &topIslandSum, scDataNode &topIslandSize);
+    const std::vector<uint> &topIslandIds,
+    std::vector<double> &topIslandSum, std::vector<uint> &topIslandSize);
   virtual void optimizeParams(const scDataNode &islandRating, sgpGaExperimentParamsStored *params);
   void logIslandStatsToFile(uint stepNo, uint topBestIslandId, uint objBestIslandId, 
     const scDataNode &islandRating);
   void logIslandParamsToFile(uint stepNo, const scDataNode &islandRating, const scDataNode &islandSize);
   void prepareIslandIds(const sgpGaGeneration &input, const sgpEntityIndexList &topIdList, 
-    scDataNode &topIslandIds);
-  virtual void getTopGenomesByObjective(const sgpGaGeneration &input, uint objectiveIndex, 
-    scDataNode &topIslandIds);
+    std::vector<uint> &topIslandIds);
+  /// returns top entities for each objective, population is scanned once
+  virtual void getTopGenomesByObjectives(const sgpGaGeneration &input, const std::vector<uint> &objectiveIndices, 
+    std::vector<sgpEntityIndexList> &topIdLists);
   uint getIslandTopSize();
   virtual uint getBestIslandIdByBestItem();
 protected:  
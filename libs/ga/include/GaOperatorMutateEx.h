@@ -73,7 +73,10 @@ public:
 protected:
   virtual void invokeNextEntity();
   virtual void invokeEntityChanged(uint entityIndex);
-  virtual bool processGenome(uint entityIndex, sgpGaGenome &genome);
+  virtual bool processEntity(uint entityIndex, sgpEntityBase &entity);
+  virtual bool hasDefaultHooks() const;
+  virtual void prepareEntity(uint entityIndex);
+  virtual void finishEntity(uint entityIndex, sgpEntityBase &entity);
   virtual void beforeExecute(sgpGaGeneration &newGeneration);
   void updateIslandId(uint entityIndex);
   virtual uint getChangePointLimit();
@@ -87,6 +90,8 @@ private:
   uint m_features;
   double m_entityChangeProb;
   sgpGaGeneration *m_activeGeneration;
+  // island ids before mutation, filled by prepareEntity
+  std::vector<uint> m_entityIslandIds;
 };
 
 #endif // _SGPGAOPERATORMUTEX_H__
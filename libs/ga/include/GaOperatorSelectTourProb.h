@@ -29,12 +29,72 @@
 #include "sgp/GaOperatorBasic.h"
 #include "sgp/ExperimentLog.h"
 #include "sgp/EntityIslandTool.h"
+#include "sgp/IslandPartition.h"
+#include "sgp/AliasSampler.h"
+#include "sgp/ShapeClusterer.h"
 
 // ----------------------------------------------------------------------------
 // Simple type definitions
 // ----------------------------------------------------------------------------
 typedef std::multimap<uint, uint> sgpTraceEntityMoveMap;
 
+/// counters of group matches
+struct sgpTourMatchStats {
+  /// number of groups processed
+  ulong64 groupCount;
+  /// total number of match rounds
+  ulong64 roundCount;
+  /// groups finished because all matches in round were equal
+  ulong64 equalShortcutCount;
+  /// groups finished because round limit was reached
+  ulong64 limitHitCount;
+  sgpTourMatchStats() { clear(); }
+  void clear() { groupCount = roundCount = equalShortcutCount = limitHitCount = 0; }
+  void add(const sgpTourMatchStats &src) { 
+    groupCount += src.groupCount; 
+    roundCount += src.roundCount; 
+    equalShortcutCount += src.equalShortcutCount; 
+    limitHitCount += src.limitHitCount; 
+  }
+};
+
+/// selection data of a single island
+struct sgpTourIslandData {
+  /// list of shapes, each is an array of entity indices
+  scDataNode shapeCollection;
+  /// probability of selecting each shape
+  scDataNode shapeDistrib;
+  /// built from shapeDistrib once per step, empty = all shapes are equally probable
+  sgpAliasSampler shapeSampler;
+  /// relative island size from experiment params
+  double sizeFactor;
+  /// number of entities to be selected from island
+  uint quota;
+  /// island is not empty and is in processed range
+  bool active;
+  sgpTourIslandData(): sizeFactor(0.0), quota(0), active(false) {}
+};
+
+/// indexed by island id
+typedef std::vector<sgpTourIslandData> sgpTourIslandDataList;
+
+/// part of selection quota processed by one parallel task
+struct sgpTourProbParBlock {
+  uint islandId;
+  /// SC_NULL = groups are selected by shape from the whole population
+  const sgpIslandPartition *islands;
+  const sgpTourIslandData *islandData;
+  uint tourSize;
+  bool dynamicTourType;
+  double staticTourProb;
+  uint quota;
+  /// indices of selected entities, in selection order
+  sgpEntityIndexList selected;
+  sgpTourMatchStats stats;
+};
+
+typedef std::vector<sgpTourProbParBlock> sgpTourProbParBlockList;
+
 // ----------------------------------------------------------------------------
 // Forward class definitions
 // ----------------------------------------------------------------------------
@@ -105,11 +165,43 @@ public:
   void setExperimentParams(const sgpGaExperimentParams *params);
   void setExperimentLog(sgpExperimentLog *value); 
   void setIslandTool(sgpEntityIslandToolIntf *value);
+  /// if enabled, selection quota is split into blocks processed concurrently,
+  /// each block with own random stream keyed by (seed, step, block number);
+  /// island quotas are split separately so island allocations stay exact
+  bool getParallel() const;
+  void setParallel(bool value);
+  /// number of worker threads in parallel mode, 0 = use OpenMP default
+  uint getThreadCount() const;
+  void setThreadCount(uint value);
+  /// seed of random streams, 0 = new seed is taken from global RNG on each execute
+  ulong64 getRandomSeed() const;
+  void setRandomSeed(ulong64 value);
+  /// if enabled, each match probability is also calculated by the reference per-objective code, 
+  /// scError is thrown if results are not bit-identical
+  bool getVerifyMatchKernel() const;
+  void setVerifyMatchKernel(bool value);
+  /// max number of match rounds played in a single group 
+  uint getMatchRoundLimit() const;
+  void setMatchRoundLimit(uint value);
+  // stats
+  void resetCounters();
+  void getCounters(scDataNode &output) const;
   // run
   virtual void execute(sgpGaGeneration &input, sgpGaGeneration &output, uint limit);
+  /// used by worker tasks, fills block.selected
+  void selectBlockPar(const sgpGaGeneration &input, sgpTourProbParBlock &block, sgpRandomSource &random);
 protected:
-  virtual void runMatchInGroup(sgpTournamentGroup &output, const sgpGaGeneration &input, const sgpTournamentGroup &group);
-  int runMatch(const sgpGaGeneration &input, uint first, uint second, double gravity, bool useProbOnlyForNonDomin);
+  virtual void runMatchInGroup(sgpTournamentGroup &output, const sgpGaGeneration &input, const sgpTournamentGroup &group,
+    sgpRandomSource &random, sgpTourMatchStats &stats);
+  int runMatch(const sgpGaGeneration &input, uint first, uint second, double gravity, bool useProbOnlyForNonDomin,
+    sgpRandomSource &random);
+  double calcMatchProb(const sgpGaGeneration &input, uint first, uint second, double gravity, double &sumLrk);
+  double calcMatchProbRef(const sgpGaGeneration &input, uint first, uint second, double gravity, double &sumLrk);
+  /// prepares per-island weights used by match kernel, 
+  /// should be overridden together with getObjectiveWeight
+  virtual void prepareMatchWeights();
+  const double *getMatchWeights(const sgpGaGeneration &input, uint first);
+  double getIslandObjectiveWeight(uint islandId, uint objIndex, double defValue);
   //tracing
   void traceMatchProb(ulong64 stepNo, ulong64 groupNo, 
       ulong64 matchNo,
@@ -118,44 +210,46 @@ protected:
   void traceTournamentFailedFor(sgpGaGeneration &input, uint itemIndex);
   virtual void genRandomGroupFromBlock(sgpTournamentGroup &output, const sgpGaGeneration &input, uint limit);
   void genRandomGroupOnIsland(sgpTournamentGroup &output, const sgpGaGeneration &input, 
-     const scDataNode &islandItems, uint limit);
+     const sgpIslandPartition &islands, uint islandId, uint limit, sgpRandomSource &random);
   virtual void genRandomGroupWithDistance(sgpTournamentGroup &output, const sgpGaGeneration &input, uint limit);
   virtual double getObjectiveWeight(const sgpGaGeneration &input, uint first, uint second,
     uint objIndex, double defValue);
   void prepareShapeCollectionByObj(const sgpGaGeneration &input, scDataNode &output);
   void prepareShapeCollectionByCluster(const sgpGaGeneration &input, scDataNode &output);
   void prepareShapeCollectionByCluster(const sgpGaGeneration &input, 
-    const scDataNode *itemList, uint islandId,
+    const sgpIslandPartition *islands, uint islandId,
     scDataNode &shapeList, scDataNode &shapeDistrib, double decFactor);
   void genRandomGroupByShape(sgpTournamentGroup &output, const sgpGaGeneration &input, uint limit, 
-    const scDataNode &shapeCollection, const scDataNode &shapeDistrib, double shapeDistribSum);
+    const scDataNode &shapeCollection, const sgpAliasSampler &shapeSampler, sgpRandomSource &random);
   /// \brief prepare shape collection defined using random objective (1 or 2)
   /// Probability of selecting given shape can be specified in island parameters.
   /// \param input collection of entities
-  /// \param itemList (optional) defines item set to be selected from
+  /// \param islands (optional) defines item set to be selected from (island "islandId")
   /// \param islandId island ID
   /// \param shapeList collection [shape-value] -> item-idx-1, item-idx-2; if 2 shape objs - two levels of shapes: [shape-val1][shape-val2] -> item-idx1, item-idx2...
   /// \param shapeDistrib contains probability of selecting shape no. x (one entry for each shape from lvl 1)
   /// \param decFactor specifies how flat is shape probability distribution depending on shape value
   void prepareShapeCollectionByObjDistrib(const sgpGaGeneration &input, 
-    const scDataNode *itemList, uint islandId,
+    const sgpIslandPartition *islands, uint islandId,
     scDataNode &shapeList, scDataNode &shapeDistrib, double decFactor);
   void genRandomGroupAndIsland(sgpTournamentGroup &output, const sgpGaGeneration &input, uint limit, 
-    const scDataNode &islandItems, const scDataNode &islandData, uint &islandId, scDataNode &newItems);
-  virtual void prepareIslands(const sgpGaGeneration &input, uint totalSize, scDataNode &islandItems, scDataNode &islandData);
+    const sgpIslandPartition &islands, const sgpTourIslandDataList &islandData, uint &islandId, 
+    const std::vector<uint> &islandAllocs);
+  virtual void prepareIslands(const sgpGaGeneration &input, uint totalSize, 
+    sgpIslandPartition &islands, sgpTourIslandDataList &islandData);
   virtual void prepareIslands(const sgpGaGeneration &input, uint beginIslandNo, uint endIslandNo, 
-    uint totalSize, scDataNode &islandItems, scDataNode &islandData);
-  virtual void prepareIslandMap(const sgpGaGeneration &input, 
-    uint beginIslandNo, uint endIslandNo, scDataNode &islandItems);
-  void prepareIslandData(const sgpGaGeneration &input, scDataNode &islandItems, scDataNode &islandData);
-  void normalizeIslandSize(uint totalSize, const scDataNode &islandItems, scDataNode &islandData);
+    uint totalSize, sgpIslandPartition &islands, sgpTourIslandDataList &islandData);
+  virtual void prepareIslandPartition(const sgpGaGeneration &input, sgpIslandPartition &islands);
+  void prepareIslandData(const sgpGaGeneration &input, uint beginIslandNo, uint endIslandNo, 
+    const sgpIslandPartition &islands, sgpTourIslandDataList &islandData);
+  void normalizeIslandSize(uint totalSize, const sgpIslandPartition &islands, sgpTourIslandDataList &islandData);
   void runMatchInGroupOnIsland(sgpTournamentGroup &output, const sgpGaGeneration &input, 
-    const sgpTournamentGroup &group, uint islandId);
+    const sgpTournamentGroup &group, uint islandId, sgpRandomSource &random, sgpTourMatchStats &stats);
   void intRunMatchInGroup(sgpTournamentGroup &output, const sgpGaGeneration &input, const sgpTournamentGroup &group,
-    double gravity, bool probOnlyForNonDomin, uint outSizeLimit);
-  void updateIslandAllocs(uint islandId, uint groupSize, scDataNode &newItems);
+    double gravity, bool probOnlyForNonDomin, uint outSizeLimit, sgpRandomSource &random, sgpTourMatchStats &stats);
+  void updateIslandAllocs(uint islandId, uint groupSize, std::vector<uint> &islandAllocs);
   bool getStaticTourProbForIsland(uint islandId, double &staticTourProb);
-  bool selectTourGroupSelTypeByShape(uint islandId);
+  bool selectTourGroupSelTypeByShape(uint islandId, sgpRandomSource &random);
   void traceItemSelected(uint inputIdx, uint outputIdx, 
     sgpTournamentGroup &traceUsedItems, sgpTraceEntityMoveMap &moveMap);
   void traceHandleMatchResult(const sgpTournamentGroup &inputGroup, const sgpTournamentGroup &outputGroup, 
@@ -165,17 +259,35 @@ protected:
     const sgpTraceEntityMoveMap &moveMap);  
   void executeOnIslandList(sgpGaGeneration &input, sgpGaGeneration &output, uint limit, uint firstIslandId, uint lastIslandId);
   void executeOnIsland(sgpGaGeneration &input, sgpGaGeneration &output, uint limit, uint islandId, 
-    const scDataNode &islandItems, scDataNode &islandData);
+    const sgpIslandPartition &islands, const sgpTourIslandData &islandData);
+  /// returns false if island cannot be processed
+  bool prepareIslandTour(const sgpGaGeneration &input, uint islandId, const sgpIslandPartition &islands, 
+    uint &tourSize, bool &dynamicTourType, double &staticTourProb);
+  /// select group from island and run a single tournament on it, winners are returned in workGroup
+  void runIslandTournament(sgpTournamentGroup &group, sgpTournamentGroup &workGroup, const sgpGaGeneration &input, 
+    uint tourSize, uint targetLimit, uint allocatedCount, 
+    uint islandId, const sgpIslandPartition &islands, const sgpTourIslandData &islandData,
+    bool dynamicTourType, double staticTourProb, sgpRandomSource &random, sgpTourMatchStats &stats);
   void genRandomGroupFromIsland(sgpTournamentGroup &output, const sgpGaGeneration &input, 
     uint groupLimit, uint targetLimit, uint allocatedCount,
-    uint islandId, const scDataNode &islandItems, const scDataNode &islandData);
+    uint islandId, const sgpIslandPartition &islands, const sgpTourIslandData &islandData, sgpRandomSource &random);
   void executeOnAll(sgpGaGeneration &input, sgpGaGeneration &output, uint limit);
-  virtual bool canProcessIsland(uint islandId, const scDataNode &islandItems);
+  bool isParallelEnabled() const;
+  void executeOnAllPar(sgpGaGeneration &input, sgpGaGeneration &output, uint limit);
+  void executeOnIslandListPar(sgpGaGeneration &input, sgpGaGeneration &output, uint firstIslandId, uint lastIslandId,
+    const sgpIslandPartition &islands, const sgpTourIslandDataList &islandData);
+  void addParBlocks(uint limit, const sgpTourProbParBlock &blockTemplate);
+  void executeParBlocks(sgpGaGeneration &input, sgpGaGeneration &output);
+  void prepareIslandIdCache(const sgpGaGeneration &input);
+  virtual bool canProcessIsland(uint islandId, const sgpIslandPartition &islands);
   void genRandomGroup(sgpTournamentGroup &output, const sgpGaGeneration &input, 
-    uint limit, uint islandId, const scDataNode &islandItems, const scDataNode &islandData);
+    uint limit, uint islandId, const sgpIslandPartition &islands, const sgpTourIslandData &islandData, sgpRandomSource &random);
   void genRandomGroupFromBlockByIds(sgpTournamentGroup &output, const sgpGaGeneration &input, 
-    const scDataNode &idList, uint limit);
+    const uint *idList, uint blockSize, uint limit, sgpRandomSource &random);
   void prepareShapeDistrib(const scDataNode &shapeListWithPriority, double decFactor, scDataNode &shapeDistrib);
+  /// builds shape sampler, output is empty if distribution is empty or invalid
+  void prepareShapeSampler(const scDataNode &shapeDistrib, sgpAliasSampler &output);
+  sgpShapeClusterer &getShapeClusterer(const sgpIslandPartition *islands, uint islandId);
   void selectShapeObj(uint islandId, bool &oneLevel, uint &shapeObjIdx);
 protected:  
   // config
@@ -195,8 +307,22 @@ protected:
   const sgpGaExperimentParams *m_experimentParams;
   sgpExperimentLog *m_experimentLog;
   sgpEntityIslandToolIntf *m_islandTool;
+  bool m_parallel;
+  ulong64 m_randomSeed;
+  bool m_verifyMatchKernel;
+  uint m_matchRoundLimit;
   // state
   sgpFitnessValue m_statsTopAvg;
+  uint m_stepNo;
+  sgpWorkStealScheduler m_scheduler;
+  sgpTourProbParBlockList m_parBlocks;
+  /// rescaled objective weights for each island, indexed by island id
+  std::vector<sgpWeightVector> m_islandMatchWeights;
+  sgpTourMatchStats m_matchStats;
+  sgpShapeClusterer m_shapeClusterer;
+  std::vector<sgpShapeClusterer> m_islandShapeClusterers;
+  std::vector<double> m_shapeColumn;
+  std::vector<double> m_shapeColumn2;
 };
 
 
@@ -0,0 +1,73 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        IslandPartition.h
+// Project:     sgpLib
+// Purpose:     Population split into islands, stored as index arrays.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SGPISLANDPARTITION_H__
+#define _SGPISLANDPARTITION_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/** \file IslandPartition.h
+\brief Population split into islands, stored as index arrays.
+
+Items of island "id" are getIslandItems(id)[0..getIslandSize(id)-1]
+(entity positions, ascending). Partition is built from a list of island
+ids (one per entity) in a single counting-sort pass, islands are
+addressed directly by id.
+*/
+
+// ----------------------------------------------------------------------------
+// Headers
+// ----------------------------------------------------------------------------
+#include "sc/dtypes.h"
+
+#include <vector>
+#include <cassert>
+
+// ----------------------------------------------------------------------------
+// Simple type definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Forward class definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Class definitions
+// ----------------------------------------------------------------------------
+class sgpIslandPartition {
+public:
+  sgpIslandPartition();
+  ~sgpIslandPartition() {}
+  // run
+  /// islandIds[i] is island of entity (firstItem + i), ids must be < islandCount 
+  /// (entities with other ids are skipped)
+  void build(const uint *islandIds, uint count, uint islandCount, uint firstItem = 0);
+  void build(const std::vector<uint> &islandIds, uint islandCount, uint firstItem = 0);
+  void clear();
+  // properties
+  uint getIslandCount() const { return m_start.size() - 1; }
+  uint getItemCount() const { return m_items.size(); }
+  /// returns 0 for unknown island
+  uint getIslandSize(uint islandId) const {
+    return (islandId < getIslandCount()) ? (m_start[islandId + 1] - m_start[islandId]) : 0;
+  }
+  bool isIslandEmpty(uint islandId) const { return (getIslandSize(islandId) == 0); }
+  /// returns SC_NULL if island is empty or unknown
+  const uint *getIslandItems(uint islandId) const { 
+    assert(islandId < getIslandCount());
+    return (getIslandSize(islandId) == 0) ? SC_NULL : (&m_items[0] + m_start[islandId]); 
+  }
+private:
+  std::vector<uint> m_start;
+  std::vector<uint> m_items;
+  std::vector<uint> m_fill;
+};
+
+#endif // _SGPISLANDPARTITION_H__
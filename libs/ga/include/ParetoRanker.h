@@ -0,0 +1,88 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        ParetoRanker.h
+// Project:     sgpLib
+// Purpose:     Non-dominated sorting of multi-objective fitness.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SGPPARETORANKER_H__
+#define _SGPPARETORANKER_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/** \file ParetoRanker.h
+\brief Non-dominated sorting of multi-objective fitness.
+
+Splits rows of fitness matrix into Pareto fronts (0 = non-dominated) and 
+calculates crowding distance of each row inside its front.
+Larger values are better, row A dominates B if it is not worse on any
+selected column and better on at least one.
+
+Uses efficient non-dominated sort with binary search (ENS-BS): rows are 
+sorted lexicographically, so a row can be dominated only by rows placed 
+before it - each row is compared only with members of O(log F) fronts.
+*/
+
+// ----------------------------------------------------------------------------
+// Headers
+// ----------------------------------------------------------------------------
+#include <vector>
+
+#include "sc/dtypes.h"
+
+#include "sgp/FitnessMatrix.h"
+
+// ----------------------------------------------------------------------------
+// Simple type definitions
+// ----------------------------------------------------------------------------
+typedef std::vector<uint> sgpParetoRowList;
+
+// ----------------------------------------------------------------------------
+// Forward class definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Constants
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Class definitions
+// ----------------------------------------------------------------------------
+class sgpParetoRanker {
+public:
+  sgpParetoRanker();
+  virtual ~sgpParetoRanker();
+  /// ranks all rows of matrix using selected columns
+  void rank(const sgpFitnessMatrix &fitness, const std::vector<uint> &columns);
+  /// ranks only listed rows, other rows get rank = getFrontCount()
+  void rank(const sgpFitnessMatrix &fitness, const std::vector<uint> &columns, const sgpParetoRowList &rows);
+  uint getFrontCount() const;
+  /// returns rows of a given front in ascending order
+  void getFront(uint frontNo, sgpParetoRowList &output) const;
+  /// returns front number of row
+  uint getRank(uint row) const;
+  /// returns crowding distance of row inside its front, boundary rows have infinite distance
+  double getCrowding(uint row) const;
+  /// returns true if first row dominates second one on selected columns
+  static bool dominates(const double *first, const double *second, const std::vector<uint> &columns);
+protected:
+  bool isDominatedByFront(uint row, uint frontNo) const;
+  void buildFronts();
+  void calcCrowding();
+private:
+  const sgpFitnessMatrix *m_fitness;
+  std::vector<uint> m_columns;
+  sgpParetoRowList m_order;
+  std::vector<sgpParetoRowList> m_workFronts;
+  uint m_frontCount;
+  std::vector<uint> m_ranks;
+  std::vector<double> m_crowding;
+  // fronts stored as: rows of front i = m_frontRows[m_frontStarts[i]..m_frontStarts[i+1])
+  std::vector<uint> m_frontStarts;
+  sgpParetoRowList m_frontRows;
+};
+
+#endif // _SGPPARETORANKER_H__
@@ -0,0 +1,109 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        PopulationStoreUInt.h
+// Project:     sgpLib
+// Purpose:     Contiguous storage of uint genomes & fitness for whole population.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SGPPOPSTOREUINT_H__
+#define _SGPPOPSTOREUINT_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/** \file PopulationStoreUInt.h
+\brief Contiguous storage of uint genomes & fitness for whole population.
+
+Storage is divided into slots, each slot keeps one genome (genomeSize uints)
+and one fitness vector (objectiveCount doubles). Genomes and fitness values are
+kept in separate row-major matrices, allocated in chunks so addresses of 
+rows never change. Free slots are reused lowest first, so live entities
+stay packed at the beginning of storage.
+Not thread-safe - slots should be allocated / released by one thread.
+*/
+
+// ----------------------------------------------------------------------------
+// Headers
+// ----------------------------------------------------------------------------
+#include <vector>
+#include <queue>
+#include <functional>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+
+#include "sc/dtypes.h"
+
+// ----------------------------------------------------------------------------
+// Simple type definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Forward class definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Constants
+// ----------------------------------------------------------------------------
+const uint SGP_POP_STORE_DEF_CHUNK_SIZE = 1024;
+
+// ----------------------------------------------------------------------------
+// Class definitions
+// ----------------------------------------------------------------------------
+class sgpPopulationStoreUInt {
+public:
+  // construct
+  sgpPopulationStoreUInt(uint genomeSize, uint objectiveCount, uint chunkSize = SGP_POP_STORE_DEF_CHUNK_SIZE);
+  virtual ~sgpPopulationStoreUInt();
+  // properties
+  uint getGenomeSize() const { return m_genomeSize; }
+  uint getObjectiveCount() const { return m_objectiveCount; }
+  uint getChunkSize() const { return m_chunkSize; }
+  /// number of chunks allocated
+  uint getChunkCount() const { return m_chunks.size(); }
+  /// number of slots in use
+  uint getUsedCount() const { return m_usedCount; }
+  // slots
+  uint allocSlot();
+  void releaseSlot(uint slot);
+  /// returns genome of a given slot, SC_NULL if genome size is zero
+  uint *getGenomeRow(uint slot) { 
+    return m_genomeSize ? &(m_chunks[slot / m_chunkSize].genomes[(slot % m_chunkSize) * m_genomeSize]) : SC_NULL;
+  }
+  const uint *getGenomeRow(uint slot) const { 
+    return m_genomeSize ? &(m_chunks[slot / m_chunkSize].genomes[(slot % m_chunkSize) * m_genomeSize]) : SC_NULL;
+  }
+  /// returns fitness of a given slot, SC_NULL if objective count is zero
+  double *getFitnessRow(uint slot) { 
+    return m_objectiveCount ? &(m_chunks[slot / m_chunkSize].fitness[(slot % m_chunkSize) * m_objectiveCount]) : SC_NULL;
+  }
+  const double *getFitnessRow(uint slot) const { 
+    return m_objectiveCount ? &(m_chunks[slot / m_chunkSize].fitness[(slot % m_chunkSize) * m_objectiveCount]) : SC_NULL;
+  }
+  /// returns whole genome matrix of a given chunk [chunkSize x genomeSize]
+  const uint *getChunkGenomes(uint chunkIndex) const;
+  /// returns whole fitness matrix of a given chunk [chunkSize x objectiveCount]
+  const double *getChunkFitness(uint chunkIndex) const;
+protected:
+  struct sgpPopulationStoreChunk {
+    std::vector<uint> genomes;
+    std::vector<double> fitness;
+  };
+  typedef boost::ptr_vector<sgpPopulationStoreChunk> sgpPopulationStoreChunkList;
+  typedef std::priority_queue<uint, std::vector<uint>, std::greater<uint> > sgpFreeSlotQueue;
+
+  void addChunk();
+private:
+  uint m_genomeSize;
+  uint m_objectiveCount;
+  uint m_chunkSize;
+  uint m_usedCount;
+  sgpPopulationStoreChunkList m_chunks;
+  sgpFreeSlotQueue m_freeSlots;
+};
+
+typedef boost::shared_ptr<sgpPopulationStoreUInt> sgpPopulationStoreUIntPtr;
+
+#endif // _SGPPOPSTOREUINT_H__
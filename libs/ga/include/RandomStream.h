@@ -0,0 +1,123 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        RandomStream.h
+// Project:     sgpLib
+// Purpose:     Counter-based random number streams for parallel operators.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SGPRANDOMSTREAM_H__
+#define _SGPRANDOMSTREAM_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/** \file RandomStream.h
+\brief Counter-based random number streams for parallel operators.
+
+sgpRandomStream is a Philox4x32-10 generator: n-th value of a stream is 
+a pure function of (seed, step, entity, operator, n), so each task
+(e.g. mutation of one entity in one step) can use its own stream and
+results do not depend on number of threads or order of execution.
+
+sgpRandomSource is the interface used by operators, sgpGlobalRandomSource
+forwards to global functions from base/rand.h (not thread-safe).
+*/
+
+// ----------------------------------------------------------------------------
+// Headers
+// ----------------------------------------------------------------------------
+#include "sc/dtypes.h"
+
+// ----------------------------------------------------------------------------
+// Simple type definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Forward class definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Constants
+// ----------------------------------------------------------------------------
+/// operator ids used as part of stream key
+enum sgpRandomStreamOper {
+  rsoNone = 0,
+  rsoMutate = 1,
+  rsoXOver = 2,
+  rsoSelect = 3,
+  rsoEvaluate = 4,
+  rsoUser = 100
+};
+
+// ----------------------------------------------------------------------------
+// Class definitions
+// ----------------------------------------------------------------------------
+class sgpRandomSource {
+public:
+  sgpRandomSource() {}
+  virtual ~sgpRandomSource() {}
+  /// returns random value from range <minValue, maxValue>
+  virtual int randomInt(int minValue, int maxValue) = 0;
+  /// returns random value from range <minValue, maxValue>
+  virtual uint randomUInt(uint minValue, uint maxValue) = 0;
+  /// returns random value from range <minValue, maxValue)
+  virtual double randomDouble(double minValue, double maxValue) = 0;
+  /// returns true with a given probability
+  virtual bool randomFlip(double prob) = 0;
+  /// returns string of a given length built from characters of charSet
+  virtual void randomString(const scString &charSet, uint len, scString &output) = 0;
+};
+
+/// forwards to global RNG
+class sgpGlobalRandomSource: public sgpRandomSource {
+public:
+  sgpGlobalRandomSource() {}
+  virtual ~sgpGlobalRandomSource() {}
+  virtual int randomInt(int minValue, int maxValue);
+  virtual uint randomUInt(uint minValue, uint maxValue);
+  virtual double randomDouble(double minValue, double maxValue);
+  virtual bool randomFlip(double prob);
+  virtual void randomString(const scString &charSet, uint len, scString &output);
+  /// shared instance
+  static sgpGlobalRandomSource &instance();
+};
+
+class sgpRandomStream: public sgpRandomSource {
+public:
+  sgpRandomStream();
+  sgpRandomStream(ulong64 seed, uint step, uint entity, uint oper);
+  virtual ~sgpRandomStream() {}
+  /// select stream, position is reset to zero
+  void reset(ulong64 seed, uint step, uint entity, uint oper);
+  /// number of 128-bit blocks already generated
+  uint getPosition() const;
+  /// jump to a given block number
+  void setPosition(uint blockNo);
+  /// next raw 32-bit value
+  uint nextUInt32();
+  virtual int randomInt(int minValue, int maxValue);
+  virtual uint randomUInt(uint minValue, uint maxValue);
+  virtual double randomDouble(double minValue, double maxValue);
+  virtual bool randomFlip(double prob);
+  virtual void randomString(const scString &charSet, uint len, scString &output);
+  /// fill array with uniform values from <minValue, maxValue)
+  void fillUniform(double *output, uint count, double minValue = 0.0, double maxValue = 1.0);
+  /// fill array with normally distributed values (Box-Muller)
+  void fillNormal(double *output, uint count, double mean = 0.0, double stdDev = 1.0);
+  /// fill array with raw 32-bit values
+  void fillUInt32(uint *output, uint count);
+  /// returns new seed drawn from global RNG
+  static ulong64 newSeed();
+protected:
+  void generateBlock();
+  inline double nextUnit();
+private:
+  uint m_key[2];
+  uint m_counter[4];
+  uint m_block[4];
+  uint m_blockPos;
+};
+
+#endif // _SGPRANDOMSTREAM_H__
@@ -0,0 +1,106 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        ShapeClusterer.h
+// Project:     sgpLib
+// Purpose:     K-means clustering of objective columns for shape detection.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SGPSHAPECLUSTERER_H__
+#define _SGPSHAPECLUSTERER_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/** \file ShapeClusterer.h
+\brief K-means clustering of objective columns for shape detection.
+
+Works on contiguous columns of objective values. Result is stored as
+compact index arrays: items of cluster "c" are
+getClusterItems(c)[0..getClusterSize(c)-1], values are positions in
+input column.
+
+One column is clustered exactly (optimal k-means on sorted distinct values,
+dynamic programming with divide & conquer, O(k * n * log n)).
+Two columns are clustered with Lloyd's algorithm which starts from
+centroids of previous call, so one object should be kept for each
+population (island) between steps. Clusters left empty by moved population
+are re-seeded with items farthest from their centers.
+Empty clusters are not included in result.
+*/
+
+// ----------------------------------------------------------------------------
+// Headers
+// ----------------------------------------------------------------------------
+#include "sc/dtypes.h"
+
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// Simple type definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Forward class definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Class definitions
+// ----------------------------------------------------------------------------
+class sgpShapeClusterer {
+public:
+  sgpShapeClusterer();
+  ~sgpShapeClusterer() {}
+  // run
+  /// exact clustering of a single column, NaN values are added to the last cluster
+  void execute(const double *values, uint count, uint clusterLimit);
+  /// Lloyd's algorithm on two columns, warm-started if cluster count did not change,
+  /// items with NaN on any column are added to the last cluster
+  void execute(const double *values, const double *values2, uint count, uint clusterLimit, uint stepLimit);
+  /// clear result and warm-start centroids
+  void clear();
+  // result
+  uint getClusterCount() const { return m_centroids.size(); }
+  uint getClusterSize(uint clusterNo) const { return m_clusterStart[clusterNo + 1] - m_clusterStart[clusterNo]; }
+  const uint *getClusterItems(uint clusterNo) const { return &m_clusterItems[m_clusterStart[clusterNo]]; }
+  /// cluster center on first column
+  double getCentroid(uint clusterNo) const { return m_centroids[clusterNo]; }
+  /// number of Lloyd steps performed by last call, zero for single column
+  uint getStepCount() const { return m_stepCount; }
+protected:
+  void prepareSortedValues(const double *values, uint count);
+  double calcRangeCost(uint first, uint last) const;
+  void calcOptimalSplit(uint clusterCount);
+  void calcSplitRow(uint rowNo, int firstCol, int lastCol, uint firstSplit, uint lastSplit);
+  void initCentroids(const double *values, const double *values2, uint clusterCount);
+  bool reseedEmptyClusters(const double *values, const double *values2, uint clusterCount);
+  void buildFromLabels(uint clusterCount);
+private:
+  // work, single column
+  std::vector<uint> m_order;
+  std::vector<uint> m_nanItems;
+  std::vector<uint> m_uniqEnd;
+  std::vector<double> m_sumW;
+  std::vector<double> m_sum1;
+  std::vector<double> m_sum2;
+  std::vector<double> m_costPrev;
+  std::vector<double> m_costCur;
+  std::vector<uint> m_splitAt;
+  double m_shift;
+  // work, two columns
+  std::vector<uint> m_validItems;
+  std::vector<uint> m_labels;
+  // squared distance of each valid item to its center
+  std::vector<double> m_itemDist;
+  std::vector<double> m_warmCentroids;
+  std::vector<double> m_clusterSum;
+  std::vector<uint> m_clusterCnt;
+  // result
+  std::vector<uint> m_clusterStart;
+  std::vector<uint> m_clusterItems;
+  std::vector<double> m_centroids;
+  uint m_stepCount;
+};
+
+#endif // _SGPSHAPECLUSTERER_H__
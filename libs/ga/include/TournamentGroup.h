@@ -0,0 +1,146 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        TournamentGroup.h
+// Project:     sgpLib
+// Purpose:     Small sorted set of entity indices used by tournaments.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SGPTOURNAMENTGROUP_H__
+#define _SGPTOURNAMENTGROUP_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/** \file TournamentGroup.h
+\brief Small sorted set of entity indices used by tournaments.
+
+Replacement for std::set<uint> with the same iteration order (ascending,
+unique values). Items are kept in a sorted array stored inside the object,
+so typical tournament groups do not allocate at all. Bigger groups
+(e.g. trace lists) are moved to a heap buffer which is kept after clear().
+Random pick is O(1) by position.
+*/
+
+// ----------------------------------------------------------------------------
+// Headers
+// ----------------------------------------------------------------------------
+#include "sc/dtypes.h"
+
+#include <vector>
+#include <algorithm>
+
+// ----------------------------------------------------------------------------
+// Simple type definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Forward class definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Constants
+// ----------------------------------------------------------------------------
+/// number of items stored without heap allocation
+const uint SGP_TOUR_GROUP_INLINE_SIZE = 16;
+
+// ----------------------------------------------------------------------------
+// Class definitions
+// ----------------------------------------------------------------------------
+class sgpTournamentGroup {
+public:
+  typedef uint value_type;
+  typedef const uint *const_iterator;
+  // construct
+  sgpTournamentGroup(): m_size(0), m_onHeap(false) {}
+  sgpTournamentGroup(const sgpTournamentGroup &src): m_size(0), m_onHeap(false) { assign(src); }
+  ~sgpTournamentGroup() {}
+  sgpTournamentGroup &operator=(const sgpTournamentGroup &src) { if (this != &src) assign(src); return *this; }
+  // properties
+  uint size() const { return m_size; }
+  bool empty() const { return (m_size == 0); }
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + m_size; }
+  /// n-th item in ascending order
+  uint operator[](uint index) const { return data()[index]; }
+  /// returns end() if value not found
+  const_iterator find(uint value) const;
+  bool contains(uint value) const { return (find(value) != end()); }
+  // run
+  /// returns false if value was already included
+  bool insert(uint value);
+  void erase(const_iterator it);
+  bool erase(uint value);
+  void clear() { m_size = 0; }
+  void swap(sgpTournamentGroup &other);
+protected:
+  const uint *data() const { return m_onHeap ? &m_heap[0] : m_inline; }
+  uint *data() { return m_onHeap ? &m_heap[0] : m_inline; }
+  void assign(const sgpTournamentGroup &src);
+  void grow();
+private:
+  uint m_inline[SGP_TOUR_GROUP_INLINE_SIZE];
+  std::vector<uint> m_heap;
+  uint m_size;
+  bool m_onHeap;
+};
+
+inline sgpTournamentGroup::const_iterator sgpTournamentGroup::find(uint value) const
+{
+  const_iterator first = begin();
+  const_iterator last = end();
+  const_iterator it = std::lower_bound(first, last, value);
+  if ((it != last) && (*it == value))
+    return it;
+  else
+    return last;
+}
+
+inline bool sgpTournamentGroup::insert(uint value)
+{
+  uint *items = data();
+
+  // items are often added in ascending order
+  if ((m_size > 0) && (items[m_size - 1] >= value)) {
+    uint *pos = std::lower_bound(items, items + m_size, value);
+    if (*pos == value)
+      return false;
+
+    uint offset = pos - items;
+    if (m_size == (m_onHeap ? m_heap.size() : SGP_TOUR_GROUP_INLINE_SIZE)) {
+      grow();
+      items = data();
+    }
+    std::copy_backward(items + offset, items + m_size, items + m_size + 1);
+    items[offset] = value;
+  } else {
+    if (m_size == (m_onHeap ? m_heap.size() : SGP_TOUR_GROUP_INLINE_SIZE)) {
+      grow();
+      items = data();
+    }
+    items[m_size] = value;
+  }
+
+  m_size++;
+  return true;
+}
+
+inline void sgpTournamentGroup::erase(const_iterator it)
+{
+  uint *items = data();
+  uint offset = it - items;
+  std::copy(items + offset + 1, items + m_size, items + offset);
+  m_size--;
+}
+
+inline bool sgpTournamentGroup::erase(uint value)
+{
+  const_iterator it = find(value);
+  if (it == end())
+    return false;
+  erase(it);
+  return true;
+}
+
+#endif // _SGPTOURNAMENTGROUP_H__
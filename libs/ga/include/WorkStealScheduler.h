@@ -0,0 +1,99 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        WorkStealScheduler.h
+// Project:     sgpLib
+// Purpose:     Work-stealing scheduler for fine-grained parallel tasks
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SGPWORKSTEALSCHED_H__
+#define _SGPWORKSTEALSCHED_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/// \file WorkStealScheduler.h
+///
+/// Scheduler for tasks with highly varying cost (e.g. fitness evaluation).
+/// Tasks are identified by number [0..taskCount). Each worker starts with 
+/// own contiguous block of tasks (deque), takes tasks from its back 
+/// and when empty - steals half of remaining tasks from front of other worker's deque.
+/// Requires USE_OPENMP, otherwise all tasks are executed on caller's thread.
+
+// ----------------------------------------------------------------------------
+// Headers
+// ----------------------------------------------------------------------------
+//std
+#include <vector>
+
+//sc
+#include "sc/dtypes.h"
+
+// ----------------------------------------------------------------------------
+// Simple type definitions
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Forward class definitions
+// ----------------------------------------------------------------------------
+class sgpWorkStealQueue;
+
+// ----------------------------------------------------------------------------
+// Constants
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// Class definitions
+// ----------------------------------------------------------------------------
+/// Task interface, runTask is called concurrently with different task numbers
+class sgpWorkStealTask {
+public:
+  virtual ~sgpWorkStealTask() {}
+  virtual void runTask(uint workerNo, uint taskNo) = 0;
+};
+
+/// Accumulated statistics of a single worker
+struct sgpWorkStealWorkerStats {
+  ulong64 taskCount;
+  ulong64 stealCount;     ///< number of successful steals
+  ulong64 stealTaskCount; ///< number of tasks received by stealing
+  double busyTime;        ///< wall time spent inside runTask, in seconds, not measured without USE_OPENMP
+};
+
+typedef std::vector<sgpWorkStealWorkerStats> sgpWorkStealStatsList;
+
+class sgpWorkStealScheduler {
+public:
+  // construct
+  sgpWorkStealScheduler();
+  virtual ~sgpWorkStealScheduler();
+  // properties
+  /// number of workers, 0 = OpenMP default
+  uint getWorkerCount() const;
+  void setWorkerCount(uint value);
+  /// returns number of workers used by next execute
+  uint calcWorkerCount() const;
+  // run
+  /// execute all tasks, exceptions from tasks are rethrown as scError after all workers finish
+  void execute(uint taskCount, sgpWorkStealTask &task);
+  // stats
+  const sgpWorkStealStatsList &getStats() const;
+  void resetStats();
+  /// returns stats as: total values + one child per worker, 
+  /// busy-time and balance are reported only with USE_OPENMP
+  void getCounters(scDataNode &output) const;
+protected:
+  void prepareQueues(uint workerCount, uint taskCount);
+  void runWorker(uint workerNo, sgpWorkStealTask &task);
+  bool stealTasks(uint workerNo);
+  void handleTaskError(const scString &msg);
+private:
+  uint m_workerCount;
+  std::vector<sgpWorkStealQueue *> m_queues;
+  sgpWorkStealStatsList m_stats;
+  volatile bool m_aborted;
+  scString m_errorMsg;
+};
+
+#endif // _SGPWORKSTEALSCHED_H__
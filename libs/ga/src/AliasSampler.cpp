@@ -0,0 +1,161 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        AliasSampler.cpp
+// Project:     sgpLib
+// Purpose:     Discrete distribution sampler using alias method.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+//std
+#include <cmath>
+
+//sc
+#include "sc/dtypes.h"
+
+//sgp
+#include "sgp/AliasSampler.h"
+#include "sgp/RandomStream.h"
+
+#ifdef DEBUG_MEM
+#include "sc/DebugMem.h"
+#endif
+
+using namespace dtp;
+
+// ----------------------------------------------------------------------------
+// sgpAliasSampler
+// ----------------------------------------------------------------------------
+sgpAliasSampler::sgpAliasSampler()
+{
+}
+
+bool sgpAliasSampler::build(const double *weights, uint count)
+{
+  m_work.resize(count);
+
+  double sum = 0.0;
+  for(uint i = 0; i != count; i++)
+  {
+    m_work[i] = weights[i];
+    sum += weights[i];
+  }
+
+  return buildFromWork(sum);
+}
+
+bool sgpAliasSampler::build(const std::vector<double> &weights)
+{
+  if (weights.empty()) {
+    clear();
+    return false;
+  }
+  return build(&weights[0], weights.size());
+}
+
+void sgpAliasSampler::clear()
+{
+  m_prob.clear();
+  m_alias.clear();
+}
+
+uint sgpAliasSampler::size() const
+{
+  return m_prob.size();
+}
+
+bool sgpAliasSampler::empty() const
+{
+  return m_prob.empty();
+}
+
+// Vose: scale weights to mean 1.0, then pair each column below 1.0 with
+// a column above 1.0 which donates the missing part
+bool sgpAliasSampler::buildFromWork(double sum)
+{
+  clear();
+
+  uint count = m_work.size();
+  if ((count == 0) || !(sum > 0.0) || (sum - sum != 0.0))
+    return false;
+
+  for(uint i = 0; i != count; i++)
+    if (!(m_work[i] >= 0.0))
+      return false;
+
+  double scale = static_cast<double>(count) / sum;
+
+  m_prob.resize(count);
+  m_alias.resize(count);
+  m_small.clear();
+  m_large.clear();
+
+  for(uint i = 0; i != count; i++)
+  {
+    m_work[i] *= scale;
+    if (m_work[i] < 1.0)
+      m_small.push_back(i);
+    else
+      m_large.push_back(i);
+  }
+
+  uint smallIdx, largeIdx;
+
+  while(!m_small.empty() && !m_large.empty())
+  {
+    smallIdx = m_small.back();
+    m_small.pop_back();
+    largeIdx = m_large.back();
+
+    m_prob[smallIdx] = m_work[smallIdx];
+    m_alias[smallIdx] = largeIdx;
+
+    m_work[largeIdx] = (m_work[largeIdx] + m_work[smallIdx]) - 1.0;
+    if (m_work[largeIdx] < 1.0) {
+      m_large.pop_back();
+      m_small.push_back(largeIdx);
+    }
+  }
+
+  // leftovers are 1.0 up to rounding errors
+  for(uint i = 0, epos = m_large.size(); i != epos; i++)
+  {
+    m_prob[m_large[i]] = 1.0;
+    m_alias[m_large[i]] = m_large[i];
+  }
+
+  for(uint i = 0, epos = m_small.size(); i != epos; i++)
+  {
+    m_prob[m_small[i]] = 1.0;
+    m_alias[m_small[i]] = m_small[i];
+  }
+
+  return true;
+}
+
+uint sgpAliasSampler::sample(sgpRandomSource &random) const
+{
+  uint count = m_prob.size();
+  double u = random.randomDouble(0.0, static_cast<double>(count));
+  uint column = static_cast<uint>(u);
+
+  if (column >= count)
+    column = count - 1;
+
+  if (u - static_cast<double>(column) < m_prob[column])
+    return column;
+  else
+    return m_alias[column];
+}
+
+uint sgpAliasSampler::sample() const
+{
+  return sample(sgpGlobalRandomSource::instance());
+}
+
+void sgpAliasSampler::sample(sgpRandomSource &random, uint count, std::vector<uint> &output) const
+{
+  output.reserve(output.size() + count);
+  for(uint i = 0; i != count; i++)
+    output.push_back(sample(random));
+}
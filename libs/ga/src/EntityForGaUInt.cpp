@@ -31,6 +31,8 @@ void sgpEntityForGaUInt::getGenomeAsNode(scDataNode &output, int offset, int cou
 }
     
 void sgpEntityForGaUInt::setGenomeAsNode(const scDataNode &genome) {
+  m_genomeChanged = true;
+  invalidateIslandId();
   m_genome.clear();
   m_genome.reserve(genome.size());
   for(int i = 0, epos = genome.size(); i != epos; ++i) {
@@ -0,0 +1,90 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        EntityForGaUIntView.cpp
+// Project:     sgpLib
+// Purpose:     GA entity with uint genome kept in population store.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+//std
+#include <algorithm>
+
+#include "sc/utils.h"
+
+#include "sgp/EntityForGaUIntView.h"
+
+using namespace dtp;
+
+// ----------------------------------------------------------------------------
+// sgpEntityForGaUIntView
+// ----------------------------------------------------------------------------
+sgpEntityForGaUIntView::sgpEntityForGaUIntView(const sgpPopulationStoreUIntPtr &store): 
+  inherited(), m_store(store)
+{
+  bindToStore();
+  std::fill(m_genome, m_genome + m_genomeSize, 0);
+}
+
+sgpEntityForGaUIntView::sgpEntityForGaUIntView(const sgpEntityForGaUIntView &src): 
+  inherited(), m_store(src.m_store)
+{
+  bindToStore();
+  std::copy(src.m_genome, src.m_genome + m_genomeSize, m_genome);
+  m_fitness = src.m_fitness;
+  m_genomeChanged = src.m_genomeChanged;
+  copyCachedIslandId(src);
+}
+
+sgpEntityForGaUIntView::~sgpEntityForGaUIntView()
+{
+  m_store->releaseSlot(m_slot);
+}
+
+sgpEntityForGaUIntView &sgpEntityForGaUIntView::operator=(const sgpEntityForGaUIntView &src)
+{
+  if (&src != this) {
+    checkGenomeSize(src.m_genomeSize);
+    std::copy(src.m_genome, src.m_genome + m_genomeSize, m_genome);
+    m_fitness = src.m_fitness;
+    m_genomeChanged = src.m_genomeChanged;
+    copyCachedIslandId(src);
+  }
+  return *this;
+}
+
+void sgpEntityForGaUIntView::bindToStore()
+{
+  m_slot = m_store->allocSlot();
+  m_genomeSize = m_store->getGenomeSize();
+  m_genome = m_store->getGenomeRow(m_slot);
+  if (m_store->getObjectiveCount() > 0) 
+    m_fitness.bind(m_store->getFitnessRow(m_slot), m_store->getObjectiveCount());
+}
+
+void sgpEntityForGaUIntView::checkGenomeSize(uint value) const
+{
+  if (value != m_genomeSize)
+    throw scError("Wrong genome size: "+toString(value)+", expected: "+toString(m_genomeSize));
+}
+
+void sgpEntityForGaUIntView::getGenomeAsNode(scDataNode &output, int offset, int count) const
+{
+ // --
+ // -- Note: whole genome is returned, because offset is related to genome no, not values inside genome
+ // --
+  output.clear();
+  output.setAsArray(vt_uint);
+
+  for(uint i = 0; i != m_genomeSize; ++i) 
+    output.push_back(m_genome[i]);
+}
+    
+void sgpEntityForGaUIntView::setGenomeAsNode(const scDataNode &genome) 
+{
+  checkGenomeSize(genome.size());
+  m_genomeChanged = true;
+  invalidateIslandId();
+  for(uint i = 0; i != m_genomeSize; ++i) 
+    m_genome[i] = genome.get<uint>(i);
+}
@@ -30,6 +30,8 @@ void sgpEntityForGaVarType::getGenomeAsNode(scDataNode &output, int offset, int
 }
     
 void sgpEntityForGaVarType::setGenomeAsNode(const scDataNode &genome) {
+  m_genomeChanged = true;
+  invalidateIslandId();
   m_genome.clear();
   m_genome.reserve(genome.size());
   for(int i = 0, epos = genome.size(); i != epos; ++i) {
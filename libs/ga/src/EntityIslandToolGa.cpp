@@ -30,48 +30,24 @@ void sgpEntityIslandToolGa::setBitSize(uint value)
   m_bitSize = value;
 }
 
-void sgpEntityIslandToolGa::prepareIslandMap(const sgpGaGeneration &newGeneration, scDataNode &output)
+void sgpEntityIslandToolGa::prepareIslandPartition(const sgpGaGeneration &newGeneration, sgpIslandPartition &output)
 {
-  uint islandId, lastIslandId;
-  const sgpEntityBase *workInfo;
-  scString islandName;
-  scDataNode genome;
+  uint islandId;
   scDataNode islandNode;
-  std::vector<scString> islandNames;
-  uint islancCnt = 0;
-
-  lastIslandId = UINT_MAX;
 
   assert(m_islandLimit > 0);
+
+  m_islandIds.clear();
+  m_islandIds.reserve(newGeneration.endPos() - newGeneration.beginPos());
+
   for(uint i = newGeneration.beginPos(), epos = newGeneration.endPos(); i != epos; i++)
   {
-    workInfo = newGeneration.atPtr(i);
-    if (!intGetIslandId(*workInfo, islandNode, islandId))
+    if (!intGetIslandId(*newGeneration.atPtr(i), islandNode, islandId))
       islandId = 0;
-    
-    if (islandId != lastIslandId)
-    {
-      if (islancCnt <= islandId)
-      {
-        islandNames.resize(islandId+1);
-        islancCnt = islandNames.size();
-      }
-
-      islandName = islandNames[islandId];
-      if (islandName.empty()) {
-        islandName = toString(islandId);
-        islandNames[islandId] = islandName;
-      }
-
-      if (!output.hasChild(islandName)) {
-        output.addChild(islandName, new scDataNode(ict_array, vt_uint));
-      }
-
-      lastIslandId = islandId;
-    }
-
-    output[islandName].addItemAsUInt(i);  
+    m_islandIds.push_back(islandId);
   }    
+
+  output.build(m_islandIds, m_islandLimit, newGeneration.beginPos());
 }
 
 bool sgpEntityIslandToolGa::getIslandId(const sgpEntityBase &entity, uint &output)
@@ -80,16 +56,34 @@ bool sgpEntityIslandToolGa::getIslandId(const sgpEntityBase &entity, uint &outpu
   return intGetIslandId(entity, value, output);
 }
 
+// Decoded gene value is cached on entity, keyed by gene position and bit size. 
+// For uint genomes key includes raw gene value, so direct writes to genome data are detected too.
+// Other genomes use key 0 and rely on entity invalidating the cache when
+// island gene is set.
 bool sgpEntityIslandToolGa::intGetIslandId(const sgpEntityBase &entity, scDataNode &workNode, uint &output)
 {
   assert(m_islandIdPos >= 0);
   uint islandId;
-  entity.getGenomeItem(0, m_islandIdPos, workNode);
+  uint itemCount;
+  const uint *genomeData = entity.getGenomeData(0, itemCount);
+
+  if (genomeData != SC_NULL) {
+    assert(static_cast<uint>(m_islandIdPos) < itemCount);
+    uint gene = genomeData[m_islandIdPos];
+    if (!entity.getCachedIslandId(m_islandIdPos, m_bitSize, gene, islandId)) {
+      islandId = grayToBin(gene, m_bitSize);
+      entity.setCachedIslandId(m_islandIdPos, m_bitSize, gene, islandId);
+    }
+  } else if (!entity.getCachedIslandId(m_islandIdPos, m_bitSize, 0, islandId)) {
+    entity.getGenomeItem(0, m_islandIdPos, workNode);
 
-  if (workNode.getValueType() == vt_string)
-    islandId = bitStringToInt<uint>(workNode.getAsString());
-  else
-    islandId = grayToBin(workNode.getAsUInt(), m_bitSize);
+    if (workNode.getValueType() == vt_string)
+      islandId = bitStringToInt<uint>(workNode.getAsString());
+    else
+      islandId = grayToBin(workNode.getAsUInt(), m_bitSize);
+
+    entity.setCachedIslandId(m_islandIdPos, m_bitSize, 0, islandId);
+  }
   
   islandId = islandId % m_islandLimit;
   output = islandId;
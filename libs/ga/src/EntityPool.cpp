@@ -0,0 +1,99 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        EntityPool.cpp
+// Project:     sgpLib
+// Purpose:     Free-list pool of entity objects shared by generations.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+//sc
+#include "sc/utils.h"
+
+//sgp
+#include "sgp/EntityPool.h"
+
+#ifdef DEBUG_MEM
+#include "sc/DebugMem.h"
+#endif
+
+using namespace dtp;
+
+// ----------------------------------------------------------------------------
+// sgpEntityPool
+// ----------------------------------------------------------------------------
+sgpEntityPool::sgpEntityPool(uint capacity): m_capacity(capacity), m_reuseCount(0), m_allocCount(0)
+{
+}
+
+sgpEntityPool::~sgpEntityPool()
+{
+  clear();
+}
+
+sgpEntityBase *sgpEntityPool::acquire()
+{
+  if (m_items.empty()) {
+    m_allocCount++;
+    return SC_NULL;
+  }
+
+  sgpEntityBase *res = m_items.back();
+  m_items.pop_back();
+  res->setPool(shared_from_this());
+  m_reuseCount++;
+  return res;
+}
+
+void sgpEntityPool::attach(sgpEntityBase *entity)
+{
+  entity->setPool(shared_from_this());
+}
+
+void sgpEntityPool::release(sgpEntityBase *entity)
+{
+  // pool is not referenced by free entities - no ownership cycle
+  entity->setPool(sgpEntityPoolPtr());
+
+  if ((m_capacity > 0) && (m_items.size() >= m_capacity))
+    delete entity;
+  else
+    m_items.push_back(entity);
+}
+
+void sgpEntityPool::dispose(sgpEntityBase *entity)
+{
+  if (entity == SC_NULL)
+    return;
+
+  // keep pool alive while entity is returned, entity can hold last reference
+  sgpEntityPoolPtr pool(entity->getPool());
+  if (pool)
+    pool->release(entity);
+  else
+    delete entity;
+}
+
+void sgpEntityPool::clear()
+{
+  for(std::vector<sgpEntityBase *>::iterator it = m_items.begin(), epos = m_items.end(); it != epos; ++it)
+    delete *it;
+  m_items.clear();
+}
+
+void sgpEntityPool::setCapacity(uint value)
+{
+  m_capacity = value;
+  if ((m_capacity > 0) && (m_items.size() > m_capacity)) {
+    for(uint i = m_capacity, epos = m_items.size(); i != epos; i++)
+      delete m_items[i];
+    m_items.resize(m_capacity);
+  }
+}
+
+void sgpEntityPool::getCounters(scDataNode &output) const
+{
+  output.addChild("gx-epool-reuse", new scDataNode(m_reuseCount));
+  output.addChild("gx-epool-alloc", new scDataNode(m_allocCount));
+  output.addChild("gx-epool-size", new scDataNode(static_cast<uint>(m_items.size())));
+}
@@ -0,0 +1,274 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        FitnessCache.cpp
+// Project:     sgpLib
+// Purpose:     Cache of fitness values indexed by genome hash.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+#include "sc/defs.h"
+
+//std
+#include <cstring>
+
+//sc
+#include "sc/utils.h"
+
+//sgp
+#include "sgp/FitnessCache.h"
+#include "sgp/EntityForGaVarType.h"
+
+#ifdef DEBUG_MEM
+#include "sc/DebugMem.h"
+#endif
+
+using namespace dtp;
+
+// ----------------------------------------------------------------------------
+// local functions
+// ----------------------------------------------------------------------------
+namespace {
+
+/// Calculates two independent hashes in one pass: FNV-1a & multiply-rotate
+class sgpGenomeHasher {
+public:
+  sgpGenomeHasher() {
+    m_hash = 14695981039346656037ULL;
+    m_check = 0x9E3779B97F4A7C15ULL;
+  }
+
+  void addUInt64(ulong64 value) {
+    m_hash = (m_hash ^ value) * 1099511628211ULL;
+    m_check = (m_check ^ value) * 0xC2B2AE3D27D4EB4FULL;
+    m_check = (m_check << 31) | (m_check >> 33);
+  }
+
+  void addUInt(uint value) {
+    addUInt64(value);
+  }
+
+  void addDouble(double value) {
+    ulong64 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    addUInt64(bits);
+  }
+
+  void addString(const scString &value) {
+    addUInt64(value.length());
+    for(uint i=0, epos = value.length(); i != epos; i++)
+      addUInt(static_cast<unsigned char>(value[i]));
+  }
+
+  void addValue(const scDataNodeValue &value) {
+    dnValueType vt = value.getValueType();
+    addUInt(vt);
+    switch (vt) {
+      case vt_int:
+      case vt_byte:
+      case vt_uint:
+        addUInt(value.getAsUInt());
+        break;
+      case vt_int64:
+      case vt_uint64:
+        addUInt64(value.getAsUInt64());
+        break;
+      case vt_float:
+      case vt_double:
+      case vt_xdouble:
+        addDouble(value.getAsDouble());
+        break;
+      default:
+        addString(value.getAsString());
+    }
+  }
+
+  void getKey(sgpGenomeKey &output) const {
+    output.hash = finalize(m_hash);
+    output.check = finalize(m_check);
+  }
+
+private:
+  static ulong64 finalize(ulong64 value) {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ULL;
+    value ^= value >> 33;
+    return value;
+  }
+
+private:
+  ulong64 m_hash;
+  ulong64 m_check;
+};
+
+}
+
+// ----------------------------------------------------------------------------
+// sgpFitnessCache
+// ----------------------------------------------------------------------------
+sgpFitnessCache::sgpFitnessCache(uint capacity)
+{
+  m_capacity = SC_MAX(1u, capacity);
+  m_clockHand = 0;
+  m_hitCount = m_missCount = 0;
+}
+
+sgpFitnessCache::~sgpFitnessCache()
+{
+}
+
+uint sgpFitnessCache::getCapacity() const
+{
+  return m_capacity;
+}
+
+void sgpFitnessCache::setCapacity(uint value)
+{
+  m_capacity = SC_MAX(1u, value);
+  clear();
+}
+
+uint sgpFitnessCache::size() const
+{
+  return m_entries.size();
+}
+
+void sgpFitnessCache::clear()
+{
+  m_entries.clear();
+  m_index.clear();
+  m_clockHand = 0;
+}
+
+ulong64 sgpFitnessCache::getHitCount() const
+{
+  return m_hitCount;
+}
+
+ulong64 sgpFitnessCache::getMissCount() const
+{
+  return m_missCount;
+}
+
+void sgpFitnessCache::resetCounters()
+{
+  m_hitCount = m_missCount = 0;
+}
+
+void sgpFitnessCache::getCounters(scDataNode &output) const
+{
+  output.addChild("gx-fcache-hits", new scDataNode(m_hitCount));
+  output.addChild("gx-fcache-misses", new scDataNode(m_missCount));
+  output.addChild("gx-fcache-size", new scDataNode(size()));
+}
+
+void sgpFitnessCache::calcKey(const sgpEntityBase &entity, sgpGenomeKey &output, sgpGaGenome &genomeBuffer)
+{
+  sgpGenomeHasher hasher;
+  uint genomeCount = entity.getGenomeCount();
+  const uint *uintData;
+  uint itemCount;
+  const sgpEntityForGaVarType *varTypeEntity = SC_NULL;
+
+  hasher.addUInt(genomeCount);
+
+  for(uint genomeNo = 0; genomeNo != genomeCount; genomeNo++)
+  {
+    uintData = entity.getGenomeData(genomeNo, itemCount);
+    if (uintData != SC_NULL) {
+      // uint genome - hash directly
+      hasher.addUInt(itemCount);
+      for(uint i=0; i != itemCount; i++)
+        hasher.addUInt(uintData[i]);
+      continue;
+    } 
+
+    if (genomeCount == 1)
+      varTypeEntity = dynamic_cast<const sgpEntityForGaVarType *>(&entity);
+
+    const sgpGaGenome *genome;
+    if (varTypeEntity != SC_NULL) {
+      genome = &(varTypeEntity->getGenome());
+    } else {
+      entity.getGenome(genomeNo, genomeBuffer);
+      genome = &genomeBuffer;
+    }
+
+    hasher.addUInt(genome->size());
+    for(uint i=0, epos = genome->size(); i != epos; i++)
+      hasher.addValue((*genome)[i]);
+  }
+
+  hasher.getKey(output);
+}
+
+bool sgpFitnessCache::find(const sgpEntityBase &entity, sgpFitnessValue &fitness)
+{
+  sgpGenomeKey key;
+  return find(entity, fitness, key);
+}
+
+bool sgpFitnessCache::find(const sgpEntityBase &entity, sgpFitnessValue &fitness, sgpGenomeKey &key)
+{
+  calcKey(entity, key, m_genomeBuffer);
+
+  sgpFitnessCacheIndex::const_iterator it = m_index.find(key.hash);
+  if (it != m_index.end()) {
+    sgpFitnessCacheEntry &entry = m_entries[it->second];
+    if (entry.key.check == key.check) {
+      entry.referenced = true;
+      fitness = entry.fitness;
+      m_hitCount++;
+      return true;
+    }
+  }
+
+  m_missCount++;
+  return false;
+}
+
+void sgpFitnessCache::insert(const sgpEntityBase &entity, const sgpFitnessValue &fitness)
+{
+  sgpGenomeKey key;
+  calcKey(entity, key, m_genomeBuffer);
+  insert(key, fitness);
+}
+
+void sgpFitnessCache::insert(const sgpGenomeKey &key, const sgpFitnessValue &fitness)
+{
+  uint entryIndex;
+  sgpFitnessCacheIndex::const_iterator it = m_index.find(key.hash);
+
+  if (it != m_index.end()) {
+    // same hash, possibly different genome - replace
+    entryIndex = it->second;
+  } else {
+    entryIndex = allocEntry();
+    m_index.insert(std::make_pair(key.hash, entryIndex));
+  }
+
+  sgpFitnessCacheEntry &entry = m_entries[entryIndex];
+  entry.key = key;
+  entry.fitness = fitness;
+  entry.referenced = false;
+}
+
+// returns index of free entry, removes the oldest unreferenced one if cache is full
+uint sgpFitnessCache::allocEntry()
+{
+  if (m_entries.size() < m_capacity) {
+    m_entries.push_back(sgpFitnessCacheEntry());
+    return m_entries.size() - 1;
+  }
+
+  while(m_entries[m_clockHand].referenced) {
+    m_entries[m_clockHand].referenced = false;
+    m_clockHand = (m_clockHand + 1) % m_entries.size();
+  }
+
+  uint res = m_clockHand;
+  m_index.erase(m_entries[res].key.hash);
+  m_clockHand = (m_clockHand + 1) % m_entries.size();
+  return res;
+}
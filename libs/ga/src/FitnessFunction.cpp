@@ -12,6 +12,21 @@
 // ----------------------------------------------------------------------------
 // sgpFitnessFunction
 // ----------------------------------------------------------------------------
+bool sgpFitnessFunction::calcBatch(const sgpFitnessBatch &batch, sgpFitnessMatrix &output) const
+{
+  bool res = true;
+  sgpFitnessValue fitness;
+
+  for(uint i = 0; i != batch.count; i++)
+  {
+    if (!calc(batch.entityIndices[i], batch.entities[i], fitness))
+      res = false;
+    output.setRow(i, fitness);
+  }
+
+  return res;
+}
+
 void sgpFitnessFunction::getObjectiveWeights(sgpWeightVector &output) const
 {
   // base version returns all weights equal, so all objectives are equally important
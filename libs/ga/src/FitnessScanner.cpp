@@ -7,7 +7,12 @@
 // Created:     13/07/2013
 /////////////////////////////////////////////////////////////////////////////
 
+//std
+#include <algorithm>
+
 #include "sgp\FitnessScanner.h"
+#include "sgp/FitnessMatrix.h"
+#include "sgp/ParetoRanker.h"
 #include "sc\utils.h"
 
 class sgpFitnessStorage {
@@ -15,6 +20,12 @@ public:
   sgpFitnessStorage() {}
   virtual ~sgpFitnessStorage() {}
   virtual void getFitness(uint itemIndex, sgpFitnessValue &output) const = 0;
+  /// returns reference to stored fitness vector or to helper filled with it
+  virtual const sgpFitnessValue &getFitnessRef(uint itemIndex, sgpFitnessValue &helper) const 
+  { 
+    getFitness(itemIndex, helper); 
+    return helper; 
+  }
   virtual double getFitness(uint itemIndex, int objIndex) const = 0;
   virtual double getFitness(uint itemIndex) const = 0;
   virtual uint size() = 0;
@@ -33,6 +44,7 @@ public:
   virtual ~sgpFitnessStorageForGeneration();
   // properties
   virtual void getFitness(uint itemIndex, sgpFitnessValue &output) const;
+  virtual const sgpFitnessValue &getFitnessRef(uint itemIndex, sgpFitnessValue &helper) const;
   virtual double getFitness(uint itemIndex, int objIndex) const;
   virtual double getFitness(uint itemIndex) const;
   virtual uint size();
@@ -75,6 +87,11 @@ void sgpFitnessStorageForGeneration::getFitness(uint itemIndex, sgpFitnessValue
   element.getFitness(output);
 }
 
+const sgpFitnessValue &sgpFitnessStorageForGeneration::getFitnessRef(uint itemIndex, sgpFitnessValue &helper) const
+{
+  return (*m_fitnessValues)[itemIndex].getFitnessVector();
+}
+
 double sgpFitnessStorageForGeneration::getFitness(uint itemIndex, int objIndex) const
 {
   const sgpEntityBase &element = (*m_fitnessValues)[itemIndex];
@@ -150,29 +167,89 @@ sgpFitnessScanner::~sgpFitnessScanner()
 {
 }
 
-void sgpFitnessScanner::getTopGenomesByObjective(int limit, uint objectiveIndex, sgpEntityIndexList &indices)
+void sgpFitnessScanner::getTopGenomesByObjective(int limit, uint objectiveIndex, sgpEntityIndexList &indices, sgpTopTieMode tieMode)
 {
-  int leftCnt = std::min<uint>(limit, m_storage->size());
-  uint lastIdx = m_storage->size();
-  uint maxIdx;
-  double maxFit;
+  getTopIndicesByObjective(SC_MAX(0, limit), objectiveIndex, tieMode, indices);
+}
 
-  indices.clear();
-  if (m_storage->empty()) 
-    return;
+// value desc, index asc
+static bool fitscan_sort_top_pred(const UIntDoublePair& left, const UIntDoublePair& right)
+{
+  if (left.second != right.second)
+    return left.second > right.second;
+  return left.first < right.first;
+}
 
-  maxIdx = getBestGenomeIndexByObjective(objectiveIndex, false);
-  
-  while(leftCnt > 0) {
-    maxFit = m_storage->getFitness(maxIdx, objectiveIndex);
-    indices.push_back(maxIdx);
-    lastIdx = maxIdx;
-    leftCnt--;
-    if (!getBestGenomeIndexByObjective(objectiveIndex, maxFit, maxIdx))
-      break;
+// Returns first limit items in (value desc, index asc) order. 
+// Window of best items is selected with nth_element and sorted - O(n + k log k).
+// In distinct mode window is extended (from not yet sorted part) until it contains limit different values.
+static void fitscan_select_top(std::vector<UIntDoublePair> &items, uint limit, sgpTopTieMode tieMode, sgpEntityIndexList &output)
+{
+  uint itemCount = items.size();
+  uint windowSize = SC_MIN(limit, itemCount);
+  uint sortedSize = 0;
+
+  output.clear();
+
+  while((sortedSize < windowSize) && (output.size() < limit)) {
+    if (windowSize < itemCount)
+      std::nth_element(items.begin() + sortedSize, items.begin() + windowSize, items.end(), fitscan_sort_top_pred);
+    std::sort(items.begin() + sortedSize, items.begin() + windowSize, fitscan_sort_top_pred);
+
+    for(uint i = sortedSize; (i != windowSize) && (output.size() < limit); i++)
+      if ((tieMode == ttmKeepAll) || (i == 0) || (items[i].second != items[i - 1].second))
+        output.push_back(items[i].first);
+
+    sortedSize = windowSize;
+    windowSize = SC_MIN(2 * windowSize, itemCount);
   }
 }
 
+void sgpFitnessScanner::getTopIndicesByObjective(uint limit, uint objectiveIndex, sgpTopTieMode tieMode, sgpEntityIndexList &indices) const
+{
+  std::vector<UIntDoublePair> column;
+  double fitValue;
+
+  column.reserve(m_storage->size());
+
+  for(uint i=0, epos = m_storage->size(); i != epos; i++) 
+  {
+    fitValue = m_storage->getFitness(i, objectiveIndex);
+    // NaN values are not comparable
+    if (fitValue == fitValue)
+      column.push_back(std::make_pair(i, fitValue));
+  }   
+
+  fitscan_select_top(column, limit, tieMode, indices);
+}
+
+void sgpFitnessScanner::getTopIndicesByObjectives(uint limit, const std::vector<uint> &objectiveIndices, sgpTopTieMode tieMode, 
+  std::vector<sgpEntityIndexList> &indices) const
+{
+  uint objCount = objectiveIndices.size();
+  std::vector<std::vector<UIntDoublePair> > columns(objCount);
+  sgpFitnessValue helper;
+  double fitValue;
+
+  for(uint j=0; j != objCount; j++) 
+    columns[j].reserve(m_storage->size());
+
+  for(uint i=0, epos = m_storage->size(); i != epos; i++) 
+  {
+    const sgpFitnessValue &fitVector = m_storage->getFitnessRef(i, helper);
+    for(uint j=0; j != objCount; j++) 
+    {
+      fitValue = fitVector.getValue(objectiveIndices[j]);
+      if (fitValue == fitValue)
+        columns[j].push_back(std::make_pair(i, fitValue));
+    }
+  }   
+
+  indices.resize(objCount);
+  for(uint j=0; j != objCount; j++) 
+    fitscan_select_top(columns[j], limit, tieMode, indices[j]);
+}
+
 uint sgpFitnessScanner::getBestGenomeIndexByObjective(uint objIndex, bool searchForMin) const
 {
   double maxFit = 0.0;
@@ -240,27 +317,27 @@ void sgpFitnessScanner::getTopGenomesByWeights(int limit,
     const sgpWeightVector &weights, sgpEntityIndexList &indices,
     const sgpEntityIndexSet *requiredItems)
 {
-  sgpEntityIndexSet workIndices;
-
   int leftCnt = std::min<uint>(limit, m_storage->size());
-  uint maxIdx;
 
   indices.clear();  
   
   if (m_storage->size() == 0) 
     return;
-                                 
-  sgpEntityIndexSet ignoreSet;
-  maxIdx = findBestWithWeights(weights, requiredItems, ignoreSet, false);  
-  
-  while(leftCnt > 0) {
-    indices.push_back(maxIdx);
-    workIndices.insert(maxIdx);
-    leftCnt--;
-    maxIdx = findBestWithWeights(weights, requiredItems, workIndices, true); 
-    if (maxIdx >= m_storage->size()) 
-      break;
+
+  // single objective - the same order as repeated findBestSingleObj
+  if ((weights.size() < 3) && (requiredItems == SC_NULL)) {
+    getTopIndicesByObjective(leftCnt, sgpFitnessValue::SGP_OBJ_OFFSET + 0, ttmKeepAll, indices);
+    return;
   }
+                                 
+  for(uint i = 0, epos = m_storage->size(); i != epos; i++)
+    if ((requiredItems == SC_NULL) || (requiredItems->find(i) != requiredItems->end()))
+      indices.push_back(i);
+
+  sortByWeightLevels(weights, leftCnt, indices);
+
+  if (indices.size() > static_cast<uint>(leftCnt))
+    indices.resize(leftCnt);
 }    
 
 uint sgpFitnessScanner::findBestWithWeights(const sgpWeightVector &weights, const sgpEntityIndexSet *requiredItems) const
@@ -306,24 +383,23 @@ void sgpFitnessScanner::findBestSingleObj(uint &bestIndex, uint &bestCount, cons
     return;
   }
 
-  double bestFit, objValue;
-  sgpFitnessValue fitVector;
+  double bestFit = 0.0;
+  double objValue;
 
   const uint fitObjIdx = sgpFitnessValue::SGP_OBJ_OFFSET + 0;
 
-  bestFit = m_storage->getFitness(0, fitObjIdx);
   sgpEntityIndexSet::iterator ignoreEpos = ignoreSet.end();
   bool ignoreEmpty = ignoreSet.empty();
 
-  //uint 
-  bestIndex = 0;
-  bestCount = 1;
+  bestIndex = m_storage->size();
+  bestCount = 0;
 
-  for(uint i = 1, epos = m_storage->size(); i != epos; i++) {
+  for(uint i = 0, epos = m_storage->size(); i != epos; i++) {
     if (ignoreEmpty || (ignoreSet.find(i) == ignoreEpos))
     {
       objValue = m_storage->getFitness(i, fitObjIdx);
-      if (objValue > bestFit)
+      // first not ignored item is the initial best one
+      if ((bestCount == 0) || (objValue > bestFit))
       {
         bestIndex = i;
         bestFit = objValue;
@@ -343,9 +419,8 @@ void sgpFitnessScanner::findBestWithWeightsMultiObj(uint &bestIndex, uint *bestC
   if (locBestIndex >= m_storage->size())
     locBestCount = 0;
   else {
-    sgpFitnessValue bestValues;
-    m_storage->getFitness(locBestIndex, bestValues);
-    locBestCount = countEntitiesWithFitness(bestValues);
+    sgpFitnessValue helper;
+    locBestCount = countEntitiesWithFitness(m_storage->getFitnessRef(locBestIndex, helper));
   }
 
   bestIndex = locBestIndex;
@@ -353,135 +428,109 @@ void sgpFitnessScanner::findBestWithWeightsMultiObj(uint &bestIndex, uint *bestC
     *bestCount = locBestCount;
 }
 
+// includeFront is not used: items from the same front are kept together by Pareto ranks
 uint sgpFitnessScanner::findBestWithWeightsMultiObj(const sgpWeightVector &weights, const sgpEntityIndexSet *requiredItems, const sgpEntityIndexSet &ignoreSet, bool includeFront) const
 {
-  double wLevel = 0.0;
-  double nextLevel = 0.0;
-  bool wLevelIsNull = true;
-  bool nextLevelIsNull;
-  uint objCnt = weights.size();
-  std::set<uint> workGroup;
-  std::set<uint> newWorkGroup;
-  sgpFitnessValue bestValues, fitVector;
-  uint bestIndex;    
-  int minusCnt;
-  int plusCnt;
-  int zeroCnt;
-  int maxCnt;
-  int compRes;
-  
+  sgpEntityIndexList items;
+
   for(uint i = 0, epos = m_storage->size(); i != epos; i++) {
-    if (ignoreSet.find(i) == ignoreSet.end())
-      workGroup.insert(i);
+    if (
+         (ignoreSet.find(i) == ignoreSet.end())
+         &&
+         ((requiredItems == SC_NULL) || (requiredItems->find(i) != requiredItems->end()))
+       )
+      items.push_back(i);
   }
-  
-  if (requiredItems != SC_NULL)
-  {
-    newWorkGroup.clear();
-    for(std::set<uint>::iterator it = workGroup.begin(), epos = workGroup.end(); it != epos; ++it)
-    {
-      if (requiredItems->find(*it) != requiredItems->end())
-        newWorkGroup.insert(*it);
-    }
-    workGroup = newWorkGroup;    
+
+  if (items.empty())
+    return m_storage->size();
+
+  sortByWeightLevels(weights, 1, items);
+  return items[0];
+}
+
+// Objectives are grouped in levels by weight - level L uses objectives with weight <= L.
+// Items are split into Pareto fronts using objectives of the first level, then each group
+// (front) which intersects with first limit positions is split again using next level.
+void sgpFitnessScanner::sortByWeightLevels(const sgpWeightVector &weights, uint limit, sgpEntityIndexList &items) const
+{
+  uint itemCount = items.size();
+  uint objCnt = weights.size();
+
+  if (itemCount < 2)
+    return;
+
+  std::sort(items.begin(), items.end());
+
+  // row r of matrix = items[r]
+  sgpFitnessMatrix fitness(itemCount, objCnt);
+  sgpFitnessValue helper;
+
+  for(uint r = 0; r != itemCount; r++) {
+    const sgpFitnessValue &fitVector = m_storage->getFitnessRef(items[r], helper);
+    for(uint i = sgpFitnessValue::SGP_OBJ_OFFSET; i != objCnt; i++)
+      fitness.set(r, i, fitVector.getValue(i));
   }
-  
-  while(workGroup.size() > 1) {
-    // find minimal weight value > current wLevel
-    nextLevelIsNull = true;
-    maxCnt = 0;
-    for(uint i=sgpFitnessValue::SGP_OBJ_OFFSET,epos = objCnt; i!=epos; i++) {
-      if (wLevelIsNull || (wLevel < weights[i])) {
-        if (nextLevelIsNull || (nextLevel > weights[i])) {
-          nextLevel = weights[i];
-          nextLevelIsNull = false;
-        }  
-      }
-    }
-    
-    if (nextLevelIsNull)
-      break; // last level processed
-      
-    // next level found
-    wLevel = nextLevel;
-    wLevelIsNull = false;
-    
-    // find element with best set of values in work group
-    bestIndex = *workGroup.begin();
-    bestValues.clear();
-    m_storage->getFitness(bestIndex, bestValues);
-    
-    // find set of best objective values
-    for(std::set<uint>::const_iterator it = workGroup.begin(), epos=workGroup.end(); it != epos; ++it)
-    {
-      m_storage->getFitness(*it, fitVector);
-      
-      maxCnt = minusCnt = plusCnt = zeroCnt = 0;
-      
-      for(uint i=sgpFitnessValue::SGP_OBJ_OFFSET,epos = objCnt; i!=epos; i++) {
-        if (weights[i] <= wLevel) {
-          maxCnt++;
-          compRes = fpComp(fitVector[i], bestValues[i]);
-
-          if (compRes < 0) {
-            minusCnt++;
-          } else if (compRes > 0) {  
-            plusCnt++;
-          } else {
-            zeroCnt++;
-          }
-        }
-      }
-      
-      if ((minusCnt == 0) && (plusCnt > 0)) 
-      {
-        bestValues = fitVector; 
-        bestIndex = *it;
-      }
-    } // for whole workgroup
-    
-    // find all items with compatible with found bestValues
-    newWorkGroup.clear();
-    for(std::set<uint>::const_iterator it = workGroup.begin(),epos=workGroup.end(); it != epos; ++it)
-    {
-      m_storage->getFitness(*it, fitVector);
 
-      minusCnt = plusCnt = zeroCnt = 0;
-      
-      for(uint i=sgpFitnessValue::SGP_OBJ_OFFSET,epos = objCnt; i!=epos; i++) {
-        if (weights[i] <= wLevel) {
-          compRes = fpComp(fitVector[i], bestValues[i]);
-
-          if (compRes < 0) {
-            minusCnt++;
-          } else if (compRes > 0) {  
-            plusCnt++;
-          } else {
-            zeroCnt++;
-          }
-        }
+  std::vector<double> levels;
+  for(uint i = sgpFitnessValue::SGP_OBJ_OFFSET; i != objCnt; i++)
+    levels.push_back(weights[i]);
+  std::sort(levels.begin(), levels.end());
+  levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+
+  sgpParetoRanker ranker;
+  sgpParetoRowList order(itemCount);
+  sgpParetoRowList groupRows;
+  std::vector<uint> columns;
+  // group i = order[groupStarts[i]..groupStarts[i+1])
+  std::vector<uint> groupStarts, newGroupStarts;
+  uint groupBegin, groupEnd, pos;
+
+  for(uint r = 0; r != itemCount; r++)
+    order[r] = r;
+
+  groupStarts.push_back(0);
+  groupStarts.push_back(itemCount);
+
+  for(uint l = 0, lpos = levels.size(); l != lpos; l++) {
+    columns.clear();
+    for(uint i = sgpFitnessValue::SGP_OBJ_OFFSET; i != objCnt; i++)
+      if (weights[i] <= levels[l])
+        columns.push_back(i);
+
+    newGroupStarts.clear();
+    newGroupStarts.push_back(0);
+
+    for(uint g = 0, gpos = groupStarts.size() - 1; g != gpos; g++) {
+      groupBegin = groupStarts[g];
+      groupEnd = groupStarts[g + 1];
+
+      if ((groupBegin >= limit) || (groupEnd - groupBegin < 2)) {
+        newGroupStarts.push_back(groupEnd);
+        continue;
       }
-      
-      if (
-          (zeroCnt == maxCnt) 
-          || 
-          (!includeFront && (minusCnt == 0))
-          ||
-          (includeFront && (plusCnt > 0))
-         )
-      // includeFront - use "in some places better, in some worse" items
-      {
-        newWorkGroup.insert(*it);
+
+      groupRows.assign(order.begin() + groupBegin, order.begin() + groupEnd);
+      ranker.rank(fitness, columns, groupRows);
+
+      // fronts are returned with rows in ascending order = entity index order
+      pos = groupBegin;
+      for(uint f = 0, fpos = ranker.getFrontCount(); f != fpos; f++) {
+        ranker.getFront(f, groupRows);
+        std::copy(groupRows.begin(), groupRows.end(), order.begin() + pos);
+        pos += groupRows.size();
+        newGroupStarts.push_back(pos);
       }
-    } // for whole workgroup
+    }
 
-    workGroup = newWorkGroup;    
-  } // while not one in workgroup
-  
-  if (workGroup.empty())
-    return m_storage->size();
-  else  
-    return *workGroup.begin();  
+    groupStarts.swap(newGroupStarts);
+  }
+
+  // order contains matrix rows, convert to entity indices
+  sgpEntityIndexList sortedItems(itemCount);
+  for(uint r = 0; r != itemCount; r++)
+    sortedItems[r] = items[order[r]];
+  items.swap(sortedItems);
 }
 
 uint sgpFitnessScanner::findEqual(const scDataNode &searchItem)
@@ -490,11 +539,11 @@ uint sgpFitnessScanner::findEqual(const scDataNode &searchItem)
   bool found;
 
   uint res = m_storage->size();
-  sgpFitnessValue fitVector;
+  sgpFitnessValue helper;
     
   for(uint i=0, epos = m_storage->size(); i != epos; i++) 
   {
-    m_storage->getFitness(i, fitVector);      
+    const sgpFitnessValue &fitVector = m_storage->getFitnessRef(i, helper);      
 
     found = true;
     for(uint j=0, eposj = SC_MIN(fitVector.size(), srcObjSize); (j != eposj) && found; j++)
@@ -606,12 +655,11 @@ uint sgpFitnessScanner::countEntitiesWithFitness(const sgpFitnessValue &fitValue
 {
   uint res = 0;
 
-  sgpFitnessValue checkValue;
+  sgpFitnessValue helper;
 
   for(uint i=0, epos = m_storage->size(); i != epos; i++) 
   {
-    m_storage->getFitness(i, checkValue);
-    if (fitValue.compare(checkValue) == 0)
+    if (fitValue.compare(m_storage->getFitnessRef(i, helper)) == 0)
       res++;
   }
   return res;
@@ -19,6 +19,7 @@
 #include "sc/utils.h"
 
 #include "sgp/GaEvolver.h"
+#include "sgp/RandomStream.h"
 
 #include "sc/ompdefs.h"
 
@@ -484,6 +485,16 @@ void sgpGaExperimentParamsStored::setDouble(uint groupId, uint paramId, double v
   }  
 }
 
+// ----------------------------------------------------------------------------
+// sgpGaOperatorEvaluate
+// ----------------------------------------------------------------------------
+void sgpGaOperatorEvaluate::setIncrementalMode(bool value)
+{
+  // fitness of unchanged entities would be processed again
+  if (value)
+    throw scError("Incremental evaluation not supported by evaluation operator");
+}
+
 // ----------------------------------------------------------------------------
 // sgpGaOperatorElite
 // ----------------------------------------------------------------------------
@@ -649,6 +660,12 @@ void sgpGaOperatorInit::getRandomRanged(const scDataNode &minValue, const scData
 }
 
 void sgpGaOperatorInit::getRandomRanged(const scDataNode &startValue, const scDataNode &minValue, const scDataNode &maxValue, scDataNode &output)
+{
+  getRandomRanged(startValue, minValue, maxValue, output, sgpGlobalRandomSource::instance());
+}
+
+void sgpGaOperatorInit::getRandomRanged(const scDataNode &startValue, const scDataNode &minValue, const scDataNode &maxValue, scDataNode &output,
+  sgpRandomSource &random)
 {
   switch (minValue.getValueType()) {
     case vt_int: {
@@ -656,7 +673,7 @@ void sgpGaOperatorInit::getRandomRanged(const scDataNode &startValue, const scDa
       int iMaxValue = maxValue.getAsInt();
       int iStart = startValue.getAsInt();
 
-      double randomFrac = randomDouble(0.0, 1.0) - 0.5;
+      double randomFrac = random.randomDouble(0.0, 1.0) - 0.5;
       int outValue;
       
       if (randomFrac < 0.0) {
@@ -672,7 +689,7 @@ void sgpGaOperatorInit::getRandomRanged(const scDataNode &startValue, const scDa
       double dMinValue = minValue.getAsDouble();
       double dMaxValue = maxValue.getAsDouble();
       double dStart = startValue.getAsDouble();
-      double outValue = randomDouble(0.0, 1.0) - 0.5;
+      double outValue = random.randomDouble(0.0, 1.0) - 0.5;
       if (outValue < 0.0) {
         outValue = dStart + (dStart - dMinValue) * outValue;
       } else {
@@ -697,6 +714,7 @@ sgpGaEvolver::sgpGaEvolver()
 {
   m_populationSize = SGP_GA_DEF_POPSIZE;
   m_eliteLimit = 1;
+  m_incrementalEval = false;
 }
 
 sgpGaEvolver::~sgpGaEvolver()
@@ -877,31 +895,21 @@ void sgpGaEvolver::getTopGenomes(const sgpGaGeneration &input, int limit,
 void sgpGaEvolver::getTopGenomes(const sgpGaGeneration &input, int limit, 
     sgpGaGenomeList &output, sgpEntityIndexList &indices)
 {
-  int leftCnt = limit;
-  uint lastIdx = input.size();
-  uint maxIdx;
-  double maxFit;
-
+  sgpEntityIndexList topIndices;
   scDataNode genome;
   
   output.clear();  
   output.setAsList();
   
-  if (input.size() == 0) 
+  if ((input.size() == 0) || (limit <= 0))
     return;
 
-  sgpFitnessScanner scanner(&input);
-  maxIdx = scanner.getBestGenomeIndex();
+  sgpFitnessScanner(&input).getTopIndicesByObjective(limit, 0, ttmDistinct, topIndices);
   
-  while(leftCnt > 0) {
-    input.at(maxIdx).getGenomeAsNode(genome);
-    maxFit = input.at(maxIdx).getFitness();
+  for(uint i = 0, epos = topIndices.size(); i != epos; i++) {
+    input.at(topIndices[i]).getGenomeAsNode(genome);
     output.addElement(genome);
-    indices.push_back(maxIdx);
-    lastIdx = maxIdx;
-    leftCnt--;
-    if (!scanner.getBestGenomeIndex(lastIdx, maxFit, maxIdx))
-      break;
+    indices.push_back(topIndices[i]);
   }
 }
 
@@ -966,6 +974,16 @@ void sgpGaEvolver::setEliteLimit(uint a_limit)
   m_eliteLimit = a_limit;
 }
 
+void sgpGaEvolver::setIncrementalEval(bool value)
+{
+  m_incrementalEval = value;
+}
+
+bool sgpGaEvolver::getIncrementalEval() const
+{
+  return m_incrementalEval;
+}
+
 sgpGaOperator *sgpGaEvolver::getOperator(const scString &operatorType) const
 {
   sgpGaOperator *res = getOperatorFromReg(operatorType);
@@ -1512,6 +1530,8 @@ bool sgpGaEvolver::runEvaluate(uint stepNo, bool useCurrGener)
   sgpGaOperator *genOperator = getOperator(SGP_GA_OPERATOR_EVAL);
   if (genOperator != SC_NULL) {
     sgpGaOperatorEvaluate *oper = checked_cast<sgpGaOperatorEvaluate *>(genOperator);
+    // current generation is evaluated from scratch
+    oper->setIncrementalMode(m_incrementalEval && !useCurrGener);
     res = oper->execute(stepNo, !useCurrGener, *target);
   }    
     
@@ -1529,7 +1549,8 @@ bool sgpGaEvolver::isPrepared()
 void sgpGaEvolver::prepare()
 {
   m_generation.reset(newGeneration());
-  m_newGeneration.reset(newGeneration());
+  // shares entity pool (or population store) with current generation
+  m_newGeneration.reset(m_generation->newEmpty());
   initOperators();
 }
 
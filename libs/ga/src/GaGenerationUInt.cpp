@@ -16,29 +16,47 @@
 // sgpGaGenerationUInt
 // ----------------------------------------------------------------------------
 sgpEntityBase *sgpGaGenerationUInt::cloneItem(int index) const {
-  return new sgpEntityForGaUInt(
-    *(
-        checked_cast<sgpEntityForGaUInt *>(
-          &(const_cast<sgpGaGenerationUInt *>(this)->m_items[index])
-        )
-     )
-  );
+  return newItem(m_items[index]);
 }  
 
 sgpEntityBase *sgpGaGenerationUInt::newItem() const {
-  return new sgpEntityForGaUInt();
+  sgpEntityForGaUInt *res = acquireItem();
+  if (res != SC_NULL)
+    // reset recycled entity, genome buffer is kept
+    *res = sgpEntityForGaUInt();
+  else
+    res = attachItem(new sgpEntityForGaUInt());
+  return res;
 }  
 
 sgpEntityBase *sgpGaGenerationUInt::newItem(const sgpEntityBase &src) const {
-  return new sgpEntityForGaUInt(
+  const sgpEntityForGaUInt &srcItem = 
     *(
         checked_cast<sgpEntityForGaUInt *>(
           &const_cast<sgpEntityBase &>(src)
         )
-     )
-  );
+     );
+
+  sgpEntityForGaUInt *res = acquireItem();
+  if (res != SC_NULL)
+    *res = srcItem;
+  else
+    res = attachItem(new sgpEntityForGaUInt(srcItem));
+  return res;
 }  
 
+sgpEntityForGaUInt *sgpGaGenerationUInt::acquireItem() const {
+  if (!m_pool)
+    return SC_NULL;
+  return checked_cast<sgpEntityForGaUInt *>(m_pool->acquire());
+}
+
+sgpEntityForGaUInt *sgpGaGenerationUInt::attachItem(sgpEntityForGaUInt *item) const {
+  if (m_pool)
+    m_pool->attach(item);
+  return item;
+}
+
 class StructureWriterForGaGenUIntCode: public base::StructureWriterIntf {
 public:
   StructureWriterForGaGenUIntCode(const sgpGaGenerationUInt &source, const scDataNode &beforeValues): 
@@ -65,21 +83,23 @@ protected:
 
   virtual void writeGenCode(base::StructureOutputIntf &output) {
 
-    const sgpEntityForGaUInt *entity;
+    const sgpEntityBase *entity;
+    const uint *genomeData;
     uint value = 0;
     uint genomeLen;
 
     for(uint i=0, epos=m_source.size(); i != epos; ++i)
     {
-      entity = &static_cast<const sgpEntityForGaUInt &>(m_source[i]);
-      genomeLen = entity->getGenomeSize(0);
+      entity = &m_source[i];
+      genomeData = entity->getGenomeData(0, genomeLen);
       if (genomeLen > 0)
       {
+        assert(genomeData != SC_NULL);
         output.beginArrayOf(value, genomeLen);
        
         for(uint j=0, eposj = genomeLen; j != eposj; ++j)
         {
-          entity->getGenomeItem(0, j, value);
+          value = genomeData[j];
           output.writeValue(value);
         }
 
@@ -186,13 +206,13 @@ public:
 
   virtual void writeGenFit(base::StructureOutputIntf &output) 
   {
-    const sgpEntityForGaUInt *entity;
+    const sgpEntityBase *entity;
     double value = 0.0;
     uint fitnessLen;
 
     for(uint i=0, epos=m_source.size(); i != epos; ++i)
     {
-      entity = &static_cast<const sgpEntityForGaUInt &>(m_source[i]);
+      entity = &m_source[i];
       fitnessLen = entity->getFitnessSize();
       if (fitnessLen > 0)
       {
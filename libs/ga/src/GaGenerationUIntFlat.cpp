@@ -0,0 +1,53 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        GaGenerationUIntFlat.cpp
+// Project:     sgpLib
+// Purpose:     Entity container for GA algorithms - uint items in flat storage.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#include "sc/utils.h"
+
+#include "sgp/GaGenerationUIntFlat.h"
+#include "sgp/EntityForGaUIntView.h"
+
+// ----------------------------------------------------------------------------
+// sgpGaGenerationUIntFlat
+// ----------------------------------------------------------------------------
+sgpGaGenerationUIntFlat::sgpGaGenerationUIntFlat(uint genomeSize, uint objectiveCount, uint chunkSize): 
+  inherited(sgpEntityPoolPtr()), 
+  m_store(new sgpPopulationStoreUInt(genomeSize, objectiveCount, chunkSize))
+{
+}
+
+sgpGaGenerationUIntFlat::sgpGaGenerationUIntFlat(const sgpPopulationStoreUIntPtr &store): 
+  inherited(sgpEntityPoolPtr()), m_store(store)
+{
+}
+
+sgpGaGenerationUIntFlat::~sgpGaGenerationUIntFlat()
+{
+}
+
+sgpEntityBase *sgpGaGenerationUIntFlat::cloneItem(int index) const {
+  return newItem(m_items[index]);
+}  
+
+sgpEntityBase *sgpGaGenerationUIntFlat::newItem() const {
+  return new sgpEntityForGaUIntView(m_store);
+}  
+
+sgpEntityBase *sgpGaGenerationUIntFlat::newItem(const sgpEntityBase &src) const {
+  const sgpEntityForGaUIntView *view = dynamic_cast<const sgpEntityForGaUIntView *>(&src);
+  if ((view != SC_NULL) && (view->getStore() == m_store))
+    return new sgpEntityForGaUIntView(*view);
+
+  std::auto_ptr<sgpEntityForGaUIntView> res(new sgpEntityForGaUIntView(m_store));
+  sgpGaGenome genome;
+  src.getGenome(0, genome);
+  res->setGenome(genome);
+  res->setFitness(src.getFitnessVector());
+  res->setGenomeChanged(src.isGenomeChanged());
+  return res.release();
+}  
@@ -16,26 +16,44 @@
 // sgpGaGenerationVarType
 // ----------------------------------------------------------------------------
 sgpEntityBase *sgpGaGenerationVarType::cloneItem(int index) const {
-  return new sgpEntityForGaVarType(
-    *(
-        checked_cast<sgpEntityForGaVarType *>(
-          &(const_cast<sgpGaGenerationVarType *>(this)->m_items[index])
-        )
-     )
-  );
+  return newItem(m_items[index]);
 }  
 
 sgpEntityBase *sgpGaGenerationVarType::newItem() const {
-  return new sgpEntityForGaVarType();
+  sgpEntityForGaVarType *res = acquireItem();
+  if (res != SC_NULL)
+    // reset recycled entity, genome buffer is kept
+    *res = sgpEntityForGaVarType();
+  else
+    res = attachItem(new sgpEntityForGaVarType());
+  return res;
 }  
 
 sgpEntityBase *sgpGaGenerationVarType::newItem(const sgpEntityBase &src) const {
-  return new sgpEntityForGaVarType(
+  const sgpEntityForGaVarType &srcItem = 
     *(
         checked_cast<sgpEntityForGaVarType *>(
           &const_cast<sgpEntityBase &>(src)
         )
-     )
-  );
+     );
+
+  sgpEntityForGaVarType *res = acquireItem();
+  if (res != SC_NULL)
+    *res = srcItem;
+  else
+    res = attachItem(new sgpEntityForGaVarType(srcItem));
+  return res;
 }  
 
+sgpEntityForGaVarType *sgpGaGenerationVarType::acquireItem() const {
+  if (!m_pool)
+    return SC_NULL;
+  return checked_cast<sgpEntityForGaVarType *>(m_pool->acquire());
+}
+
+sgpEntityForGaVarType *sgpGaGenerationVarType::attachItem(sgpEntityForGaVarType *item) const {
+  if (m_pool)
+    m_pool->attach(item);
+  return item;
+}
+
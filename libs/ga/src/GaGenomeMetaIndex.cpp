@@ -0,0 +1,79 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        GaGenomeMetaIndex.cpp
+// Project:     sgpLib
+// Purpose:     Index of gene offsets for genome meta information.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+//std
+#include <algorithm>
+
+//sgp
+#include "sgp/GaGenomeMetaIndex.h"
+
+#ifdef DEBUG_MEM
+#include "sc/DebugMem.h"
+#endif
+
+// ----------------------------------------------------------------------------
+// sgpGaGenomeMetaIndex
+// ----------------------------------------------------------------------------
+sgpGaGenomeMetaIndex::sgpGaGenomeMetaIndex()
+{
+}
+
+void sgpGaGenomeMetaIndex::clear()
+{
+  m_offsets.clear();
+  m_pointToVar.clear();
+  m_emptyVar.clear();
+}
+
+void sgpGaGenomeMetaIndex::build(const sgpGaGenomeMetaList &list)
+{
+  uint offset = 0;
+
+  clear();
+  m_offsets.reserve(list.size() + 1);
+  m_emptyVar.reserve(list.size());
+
+  for(sgpGaGenomeMetaList::const_iterator it = list.begin(), epos = list.end(); it != epos; ++it)
+  {
+    m_offsets.push_back(offset);
+    m_emptyVar.push_back(it->genSize == 0);
+    offset += it->genSize;
+  }
+  m_offsets.push_back(offset);
+
+  if (offset <= SGP_GA_META_INDEX_DIRECT_LIMIT) {
+    m_pointToVar.reserve(offset);
+    for(uint i = 0, epos = list.size(); i != epos; i++)
+      m_pointToVar.insert(m_pointToVar.end(), list[i].genSize, i);
+  }
+}
+
+uint sgpGaGenomeMetaIndex::findVar(uint point) const
+{
+  if (point >= getPointCount())
+    return getVarCount();
+
+  if (!m_pointToVar.empty())
+    return m_pointToVar[point];
+
+  // last variable starting at or before point - empty variables before it have the same offset
+  std::vector<uint>::const_iterator it = std::upper_bound(m_offsets.begin(), m_offsets.end(), point);
+  return (it - m_offsets.begin()) - 1;
+}
+
+uint sgpGaGenomeMetaIndex::findVarFrom(uint point) const
+{
+  uint varCount = getVarCount();
+  uint res = std::lower_bound(m_offsets.begin(), m_offsets.begin() + varCount, point) - m_offsets.begin();
+
+  while((res < varCount) && m_emptyVar[res])
+    res++;
+
+  return res;
+}
@@ -11,6 +11,8 @@
 //std
 #include <set>
 #include <cmath>
+#include <algorithm>
+#include <typeinfo>
 
 //base
 #include "base/rand.h"
@@ -27,6 +29,9 @@
 //sgp
 #include "sgp/GaOperatorBasic.h"
 #include "sgp\GaStatistics.h"
+#include "sgp/FitnessCache.h"
+#include "sgp/FitnessScanner.h"
+#include "sgp/AliasSampler.h"
 
 #ifdef TRACE_ENTITY_BIO
 #include "sgp\GpEntityTracer.h"
@@ -87,12 +92,52 @@ void sgpGaOperatorInitGen::execute(uint limit, sgpGaGeneration &newGeneration)
   }  
 }
 
+// ----------------------------------------------------------------------------
+// sgpMutateParTask
+// ----------------------------------------------------------------------------
+/// Mutates single entity per task, each entity uses own random stream
+class sgpMutateParTask: public sgpWorkStealTask {
+public:
+  sgpMutateParTask(sgpGaOperatorMutateBasic *owner, sgpGaGeneration &generation, const sgpEntityIndexList &itemList, 
+    ulong64 seed, uint stepNo):
+    m_owner(owner), m_generation(generation), m_itemList(itemList), m_seed(seed), m_stepNo(stepNo),
+    m_changed(itemList.size(), 0)
+  {
+  }
+
+  virtual void runTask(uint workerNo, uint taskNo) {
+    uint entityIndex = m_itemList[taskNo];
+    sgpRandomStream random(m_seed, m_stepNo, entityIndex, rsoMutate);
+
+    if (m_owner->mutateEntityPar(m_generation, entityIndex, workerNo, random))
+      m_changed[taskNo] = 1;
+  }
+
+  bool isChanged(uint taskNo) const {
+    return (m_changed[taskNo] != 0);
+  }
+
+private:
+  sgpGaOperatorMutateBasic *m_owner;
+  sgpGaGeneration &m_generation;
+  const sgpEntityIndexList &m_itemList;
+  ulong64 m_seed;
+  uint m_stepNo;
+  // not vector<bool> - written concurrently
+  std::vector<char> m_changed;
+};
+
 // ----------------------------------------------------------------------------
 // sgpGaOperatorMutateBasic
 // ----------------------------------------------------------------------------
 sgpGaOperatorMutateBasic::sgpGaOperatorMutateBasic()
 {
   m_probability = SGP_GA_DEF_OPER_PROB_MUTATE;
+  m_skipSampling = false;
+  m_parallel = false;
+  m_parallelActive = false;
+  m_randomSeed = 0;
+  m_stepNo = 0;
 }
   
 sgpGaOperatorMutateBasic::~sgpGaOperatorMutateBasic()
@@ -118,17 +163,52 @@ void sgpGaOperatorMutateBasic::setProbability(double aValue)
 {
   m_probability = aValue;
 }  
-  
+
+bool sgpGaOperatorMutateBasic::getSkipSampling() const
+{
+  return m_skipSampling;
+}
+
+void sgpGaOperatorMutateBasic::setSkipSampling(bool value)
+{
+  m_skipSampling = value;
+}
+
+bool sgpGaOperatorMutateBasic::getParallel() const
+{
+  return m_parallel;
+}
+
+void sgpGaOperatorMutateBasic::setParallel(bool value)
+{
+  m_parallel = value;
+}
+
+uint sgpGaOperatorMutateBasic::getThreadCount() const
+{
+  return m_scheduler.getWorkerCount();
+}
+
+void sgpGaOperatorMutateBasic::setThreadCount(uint value)
+{
+  m_scheduler.setWorkerCount(value);
+}
+
+ulong64 sgpGaOperatorMutateBasic::getRandomSeed() const
+{
+  return m_randomSeed;
+}
+
+void sgpGaOperatorMutateBasic::setRandomSeed(ulong64 value)
+{
+  m_randomSeed = value;
+}
+
 void sgpGaOperatorMutateBasic::setMetaInfo(const sgpGaGenomeMetaList &list)
 {
   sgpGaOperatorMutate::setMetaInfo(list);
-  uint genomeSize = 0;
-  
-  for(sgpGaGenomeMetaList::const_iterator it =list.begin(), epos = list.end(); it != epos; it++)
-  {
-    genomeSize += it->genSize;
-  }  
-  m_genomeSize = genomeSize;
+  m_metaIndex.build(list);
+  m_genomeSize = m_metaIndex.getPointCount();
 }
 
 void sgpGaOperatorMutateBasic::beforeExecute(sgpGaGeneration &newGeneration)
@@ -143,48 +223,259 @@ void sgpGaOperatorMutateBasic::beforeExecute(sgpGaGeneration &newGeneration)
 
 void sgpGaOperatorMutateBasic::execute(sgpGaGeneration &newGeneration)
 {
-  sgpGaGenome genome;
-
   beforeExecute(newGeneration);
 
-  for(int i = newGeneration.beginPos(), epos = newGeneration.endPos(); i != epos; i++)
+  // overridden hooks are not used by parallel pass
+  m_parallelActive = m_parallel && hasDefaultHooks();
+
+  if (!m_skipSampling && !m_parallelActive) {
+    for(int i = newGeneration.beginPos(), epos = newGeneration.endPos(); i != epos; i++)
+    {
+      processEntity(i, newGeneration.at(i));
+      invokeNextEntity();
+    }  
+    return;
+  }
+
+  prepareEntities(newGeneration);
+
+  if (m_skipSampling) {
+    sampleMutationCounts(newGeneration, m_taskList);
+  } else {
+    m_taskList.resize(newGeneration.size());
+    for(uint i = 0, epos = m_taskList.size(); i != epos; i++)
+      m_taskList[i] = i;
+  }
+
+  if (m_parallelActive) {
+    executeParallel(newGeneration, m_taskList);
+  } else {
+    for(uint i = 0, epos = m_taskList.size(); i != epos; i++)
+    {
+      processEntity(m_taskList[i], newGeneration.at(m_taskList[i]));
+      invokeNextEntity();
+    }  
+  }
+}
+
+void sgpGaOperatorMutateBasic::prepareEntities(sgpGaGeneration &newGeneration)
+{
+  uint entityCount = newGeneration.size();
+
+  m_entityChangeProbs.resize(entityCount);
+  m_entityPointLimits.resize(entityCount);
+
+  for(uint i = 0; i != entityCount; i++)
   {
-    newGeneration.at(i).getGenome(0, genome);
-    processGenome(i, genome);
-    newGeneration.at(i).setGenome(0, genome);
-    invokeNextEntity();
-  }  
+    prepareEntity(i);
+    m_entityChangeProbs[i] = getEntityChangeProb();
+    m_entityPointLimits[i] = SC_MAX(1u, getChangePointLimit());
+  }
+}
+
+// Each entity has up to L trial slots, first K ~ U(1, L) of them are active, 
+// active slot is a mutation with probability p (as in per-entity mode).
+// Candidate slots are drawn for whole population with max(p) using geometric gaps,
+// then accepted with p / max(p) - so per-entity probabilities (islands) are kept.
+void sgpGaOperatorMutateBasic::sampleMutationCounts(sgpGaGeneration &newGeneration, sgpEntityIndexList &output)
+{
+  uint entityCount = newGeneration.size();
+  double maxProb = 0.0;
+  uint maxPointLimit = 1;
+
+  output.clear();
+  m_entityMutationCounts.assign(entityCount, 0);
+
+  for(uint i = 0; i != entityCount; i++)
+  {
+    maxProb = SC_MAX(maxProb, m_entityChangeProbs[i]);
+    maxPointLimit = SC_MAX(maxPointLimit, m_entityPointLimits[i]);
+  }
+
+  if ((maxProb <= 0.0) || (m_genomeSize == 0))
+    return;
+
+  maxProb = SC_MIN(maxProb, 1.0);
+
+  const double logMissProb = (maxProb < 1.0) ? log(1.0 - maxProb) : 0.0;
+  const double slotCount = static_cast<double>(entityCount) * static_cast<double>(maxPointLimit);
+  const uint NO_ENTITY = static_cast<uint>(-1);
+  double slot = -1.0;
+  double gap, u;
+  uint entityIndex, slotNo;
+  uint activeEntity = NO_ENTITY;
+  uint activeSlotCount = 0;
+
+  for(;;) {
+    // number of missed slots before next candidate
+    if (maxProb < 1.0) {
+      u = randomDouble(0.0, 1.0);
+      gap = (u > 0.0) ? floor(log(u) / logMissProb) : slotCount;
+    } else {
+      gap = 0.0;
+    }
+
+    slot += gap + 1.0;
+    if (slot >= slotCount)
+      break;
+
+    entityIndex = static_cast<uint>(slot / maxPointLimit);
+    slotNo = static_cast<uint>(slot - static_cast<double>(entityIndex) * maxPointLimit);
+
+    if (entityIndex != activeEntity) {
+      activeEntity = entityIndex;
+      activeSlotCount = 
+        (m_entityPointLimits[entityIndex] > 1) ? randomUInt(1, m_entityPointLimits[entityIndex]) : 1;
+    }
+
+    if (slotNo >= activeSlotCount)
+      continue;
+
+    if (
+         (m_entityChangeProbs[entityIndex] >= maxProb) 
+         || 
+         (randomDouble(0.0, 1.0) * maxProb < m_entityChangeProbs[entityIndex])
+       )
+    {
+      if (m_entityMutationCounts[entityIndex] == 0)
+        output.push_back(entityIndex);
+      m_entityMutationCounts[entityIndex]++;
+    }
+  }
+}
+
+void sgpGaOperatorMutateBasic::executeParallel(sgpGaGeneration &newGeneration, const sgpEntityIndexList &itemList)
+{
+  if (itemList.empty())
+    return;
+
+  m_workerGenomeBuffers.resize(SC_MAX(1u, m_scheduler.calcWorkerCount()));
+
+  ulong64 seed = (m_randomSeed != 0) ? m_randomSeed : sgpRandomStream::newSeed();
+
+  sgpMutateParTask task(this, newGeneration, itemList, seed, m_stepNo++);
+  m_scheduler.execute(itemList.size(), task);
+
+  for(uint i = 0, epos = itemList.size(); i != epos; i++)
+    if (task.isChanged(i))
+      finishEntity(itemList[i], newGeneration.at(itemList[i]));
+
+  // yield signal is not thread-safe, invoke it once per list
+  invokeNextEntity();
+}
+
+bool sgpGaOperatorMutateBasic::mutateEntityPar(sgpGaGeneration &generation, uint entityIndex, uint workerNo, 
+  sgpRandomSource &random)
+{
+  return mutateEntity(entityIndex, generation.at(entityIndex), m_workerGenomeBuffers[workerNo], random);
 }
 
+uint sgpGaOperatorMutateBasic::getTrialCount(uint entityIndex, sgpRandomSource &random)
+{
+  if (m_skipSampling) 
+    return m_entityMutationCounts[entityIndex];
+
+  uint pointCountLimit = m_parallelActive ? m_entityPointLimits[entityIndex] : getChangePointLimit();
+  pointCountLimit = SC_MAX(1u, pointCountLimit);
+  return random.randomUInt(1, pointCountLimit);
+}
+
+bool sgpGaOperatorMutateBasic::isTrialHit(uint entityIndex, sgpRandomSource &random)
+{
+  if (m_skipSampling)
+    return true;
+
+  double p = random.randomDouble(0.0, 1.0);
+  return (p < (m_parallelActive ? m_entityChangeProbs[entityIndex] : getEntityChangeProb()));
+}
+
+// processEntity() & processGenome() can be overridden in unknown subclasses
+bool sgpGaOperatorMutateBasic::hasDefaultHooks() const
+{
+  return (typeid(*this) == typeid(sgpGaOperatorMutateBasic));
+}
+
+bool sgpGaOperatorMutateBasic::processEntity(uint entityIndex, sgpEntityBase &entity)
+{
+  uint itemCount;
+
+  if (hasDefaultHooks() && (entity.getGenomeData(0, itemCount) != SC_NULL))
+    return processGenomeData(entityIndex, entity, sgpGlobalRandomSource::instance());
+
+  entity.getGenome(0, m_genomeBuffer);
+  // keep "genome changed" flag untouched if nothing was mutated
+  if (!processGenome(entityIndex, m_genomeBuffer))
+    return false;
+
+  entity.setGenome(0, m_genomeBuffer);
+  return true;
+}
+
+bool sgpGaOperatorMutateBasic::mutateEntity(uint entityIndex, sgpEntityBase &entity, sgpGaGenome &genomeBuffer, 
+  sgpRandomSource &random)
+{
+  uint itemCount;
+
+  if (entity.getGenomeData(0, itemCount) != SC_NULL)
+    return processGenomeData(entityIndex, entity, random);
+
+  entity.getGenome(0, genomeBuffer);
+  // keep "genome changed" flag untouched if nothing was mutated
+  if (!mutateGenome(entityIndex, genomeBuffer, random))
+    return false;
+
+  entity.setGenome(0, genomeBuffer);
+  return true;
+}
+
+bool sgpGaOperatorMutateBasic::processGenomeData(uint entityIndex, sgpEntityBase &entity, sgpRandomSource &random)
+{
+  bool res = false;
+  uint *genome = SC_NULL;
+  uint itemCount;
+  uint pointCount = getTrialCount(entityIndex, random);
+  
+  while(pointCount--) {
+    if (isTrialHit(entityIndex, random)) {
+      uint mutPoint = random.randomInt(0, m_genomeSize - 1);
+      uint mutVar = m_metaIndex.findVar(mutPoint);
+    
+      if (mutVar < m_meta.size())
+      {
+        // entity is marked as changed only if something is mutated
+        if (genome == SC_NULL)
+          genome = entity.modifyGenomeData(0, itemCount);
+        mutateVarUInt(m_meta[mutVar], mutPoint - m_metaIndex.getVarOffset(mutVar), genome[mutVar], random);
+      }
+    
+      res = true;
+    }
+  }
+  return res;
+}  
+
 bool sgpGaOperatorMutateBasic::processGenome(uint entityIndex, sgpGaGenome &genome)
 {
-  double p;
+  return mutateGenome(entityIndex, genome, sgpGlobalRandomSource::instance());
+}
+
+bool sgpGaOperatorMutateBasic::mutateGenome(uint entityIndex, sgpGaGenome &genome, sgpRandomSource &random)
+{
   bool res = false;
-  uint pointCountLimit = getChangePointLimit();
-  pointCountLimit = SC_MAX(1u, pointCountLimit);
-  uint pointCount = randomUInt(1, pointCountLimit);
+  uint pointCount = getTrialCount(entityIndex, random);
   
   while(pointCount--) {
-    p = randomDouble(0.0, 1.0);
-    if (p < getEntityChangeProb()) {
-      uint mutPoint = randomInt(0, m_genomeSize - 1);
-      uint curOffset = 0;
-      uint mutVar;
+    if (isTrialHit(entityIndex, random)) {
+      uint mutPoint = random.randomInt(0, m_genomeSize - 1);
+      uint mutVar = m_metaIndex.findVar(mutPoint);
       scDataNode element;
     
-      for(sgpGaGenomeMetaList::const_iterator it = m_meta.begin(), epos = m_meta.end(); it != epos; it++)
+      if (mutVar < m_meta.size())
       {
-        if ((mutPoint < curOffset + it->genSize) && (it->genSize > 0))
-        {
-          mutVar = it - m_meta.begin();
-          element = genome[mutVar];
-          mutateVar(*it, mutPoint-curOffset, element);
-          genome[mutVar] = element;
-          break;
-        } else {
-          curOffset += it->genSize;
-        } 
-      } // for
+        element = genome[mutVar];
+        mutateVar(m_meta[mutVar], mutPoint - m_metaIndex.getVarOffset(mutVar), element, random);
+        genome[mutVar] = element;
+      }
     
       res = true;
     }
@@ -192,7 +483,8 @@ bool sgpGaOperatorMutateBasic::processGenome(uint entityIndex, sgpGaGenome &geno
   return res;
 }  
 
-inline void sgpGaOperatorMutateBasic::mutateVar(const sgpGaGenomeMetaInfo &metaInfo, uint offset, scDataNode &var)
+inline void sgpGaOperatorMutateBasic::mutateVar(const sgpGaGenomeMetaInfo &metaInfo, uint offset, scDataNode &var, 
+  sgpRandomSource &random)
 {
   switch (metaInfo.genType) {
     case gagtConst:
@@ -203,24 +495,14 @@ inline void sgpGaOperatorMutateBasic::mutateVar(const sgpGaGenomeMetaInfo &metaI
       case vt_int:
       case vt_byte:
       case vt_uint: {
-        uint range = metaInfo.maxValue.getAsUInt() - metaInfo.minValue.getAsUInt();
-        uint bitCnt = getActiveBitSize(range);
-        uint bitNo = randomUInt(0, bitCnt - 1);
-        uint bitMask;
-        if (bitNo > 0)
-          bitMask = 1 << bitNo;
-        else
-          bitMask = 1;
-        uint rawValue = var.getAsUInt() - metaInfo.minValue.getAsUInt();
-        rawValue = rawValue ^ bitMask;
-        var.setAsUInt(rawValue);
+        var.setAsUInt(flipRangedBit(metaInfo, var.getAsUInt(), random));
         break;
       }
       case vt_int64:
       case vt_uint64: {
         uint64 range = metaInfo.maxValue.getAsUInt64() - metaInfo.minValue.getAsUInt64();
         uint bitCnt = getActiveBitSize(range);
-        uint bitNo = randomUInt(0, bitCnt - 1);
+        uint bitNo = random.randomUInt(0, bitCnt - 1);
         uint64 bitMask;
         if (bitNo > 0)
           bitMask = 1 << bitNo;
@@ -234,7 +516,7 @@ inline void sgpGaOperatorMutateBasic::mutateVar(const sgpGaGenomeMetaInfo &metaI
       case vt_float:
       case vt_double:
       case vt_xdouble: {
-          sgpGaOperatorInit::getRandomRanged(var, metaInfo.minValue, metaInfo.maxValue, var);
+          sgpGaOperatorInit::getRandomRanged(var, metaInfo.minValue, metaInfo.maxValue, var, random);
           break;
       }
       default:
@@ -247,7 +529,7 @@ inline void sgpGaOperatorMutateBasic::mutateVar(const sgpGaGenomeMetaInfo &metaI
       scString newChar;
       if (offset > value.length())
         throw scError("Invalid string offset: "+toString(offset));
-      randomString(metaInfo.minValue.getAsString(), 1, newChar);  
+      random.randomString(metaInfo.minValue.getAsString(), 1, newChar);  
       value[offset] = newChar[0];      
       var.setAsString(value);
       break;
@@ -257,6 +539,38 @@ inline void sgpGaOperatorMutateBasic::mutateVar(const sgpGaGenomeMetaInfo &metaI
   }
 }
 
+inline void sgpGaOperatorMutateBasic::mutateVarUInt(const sgpGaGenomeMetaInfo &metaInfo, uint offset, uint &var, 
+  sgpRandomSource &random)
+{
+  switch (metaInfo.genType) {
+    case gagtConst:
+      break;
+    case gagtRanged: 
+      var = flipRangedBit(metaInfo, var, random);
+      break;
+    default: {
+      scDataNode element(var);
+      mutateVar(metaInfo, offset, element, random);
+      var = element.getAsUInt();
+      break;
+    }
+  }
+}
+
+inline uint sgpGaOperatorMutateBasic::flipRangedBit(const sgpGaGenomeMetaInfo &metaInfo, uint value, sgpRandomSource &random)
+{
+  uint range = metaInfo.maxValue.getAsUInt() - metaInfo.minValue.getAsUInt();
+  uint bitCnt = getActiveBitSize(range);
+  uint bitNo = random.randomUInt(0, bitCnt - 1);
+  uint bitMask;
+  if (bitNo > 0)
+    bitMask = 1 << bitNo;
+  else
+    bitMask = 1;
+  uint rawValue = value - metaInfo.minValue.getAsUInt();
+  return rawValue ^ bitMask;
+}
+
 // ----------------------------------------------------------------------------
 // sgpGaOperatorMutateWithYield
 // ----------------------------------------------------------------------------
@@ -280,10 +594,24 @@ void sgpGaOperatorMutateWithYield::invokeNextEntity()
     m_yieldSignal->execute();
 }
 
+bool sgpGaOperatorMutateWithYield::hasDefaultHooks() const
+{
+  return (typeid(*this) == typeid(sgpGaOperatorMutateWithYield));
+}
+
 
 // ----------------------------------------------------------------------------
 // sgpGaOperatorEvaluateBasic
 // ----------------------------------------------------------------------------
+sgpGaOperatorEvaluateBasic::sgpGaOperatorEvaluateBasic(): sgpGaOperatorEvaluate()
+{
+  m_fitnessFunc = SC_NULL;
+  m_operatorMonitor = SC_NULL;
+  m_fitnessCache = SC_NULL;
+  m_incrementalMode = false;
+  m_batchSize = SGP_GA_DEF_EVAL_BATCH_SIZE;
+}
+
 void sgpGaOperatorEvaluateBasic::setFitnessFunc(sgpFitnessFunction *value)
 {
   m_fitnessFunc = value;
@@ -294,6 +622,26 @@ void sgpGaOperatorEvaluateBasic::setOperatorMonitor(sgpGaOperatorEvalMonitorIntf
   m_operatorMonitor = value;
 }
 
+void sgpGaOperatorEvaluateBasic::setFitnessCache(sgpFitnessCache *value)
+{
+  m_fitnessCache = value;
+}
+
+void sgpGaOperatorEvaluateBasic::setIncrementalMode(bool value)
+{
+  m_incrementalMode = value;
+}
+
+uint sgpGaOperatorEvaluateBasic::getBatchSize() const
+{
+  return m_batchSize;
+}
+
+void sgpGaOperatorEvaluateBasic::setBatchSize(uint value)
+{
+  m_batchSize = SC_MAX(1u, value);
+}
+
 bool sgpGaOperatorEvaluateBasic::execute(uint stepNo, bool isNewGen, sgpGaGeneration &generation)
 {
 #ifdef DEBUG_OPER_EVAL
@@ -305,10 +653,15 @@ bool sgpGaOperatorEvaluateBasic::execute(uint stepNo, bool isNewGen, sgpGaGenera
   if (m_fitnessFunc == SC_NULL) 
     return res;
 
+  sgpFitnessFunctionEx *fitEx = dynamic_cast<sgpFitnessFunctionEx *>(m_fitnessFunc);
+
+  // unchanged entities keep fitness already post-processed in previous step
+  if (m_incrementalMode && (fitEx != SC_NULL) && !fitEx->isIncrementalSupported())
+    throw scError("Incremental evaluation not supported by fitness function");
+
   if (m_operatorMonitor != SC_NULL)  
     m_operatorMonitor->handleBeforeEvaluate(stepNo, generation);
 
-  sgpFitnessFunctionEx *fitEx = dynamic_cast<sgpFitnessFunctionEx *>(m_fitnessFunc);
   if (fitEx)
     fitEx->initProcess(generation);    
 
@@ -357,23 +710,184 @@ bool sgpGaOperatorEvaluateBasic::evaluateAll(sgpGaGeneration *generation)
 }
 
 bool sgpGaOperatorEvaluateBasic::evaluateRange(sgpGaGeneration *generation, int first, int last)
+{
+  bool res = prepareEvalList(generation, first, last, m_evalList);
+  bool evalRes = evaluateList(generation, m_evalList);
+
+  copyDuplicateFitness(generation, evalRes);
+
+  // failed calculation (e.g. stop request) leaves stale fitness - 
+  // entities stay marked as changed and are not cached
+  if (evalRes) {
+    for(uint i = 0, epos = m_evalList.size(); i != epos; i++)
+      generation->at(m_evalList[i]).setGenomeChanged(false);
+
+    if (m_fitnessCache != SC_NULL)
+      storeInCache(generation, m_evalList);
+  }
+
+  Counter::inc(COUNTER_EVAL, m_evalList.size());
+  return res && evalRes;
+}
+
+bool sgpGaOperatorEvaluateBasic::prepareEvalList(sgpGaGeneration *generation, int first, int last, sgpEntityIndexList &output)
 {
   bool res = true;
-  bool evalRes;
+
+  output.clear();
+  m_evalKeys.clear();
+  m_evalDuplicates.clear();
+
+  if (last < first)
+    return res;
+
+  if ((m_fitnessCache == SC_NULL) && !m_incrementalMode) {
+    output.resize(last - first + 1);
+    for(int i = first; i <= last; i++)
+      output[i - first] = i;
+    return res;
+  }
+
   sgpFitnessValue fitValueVector;
+  sgpGenomeKey key;
+  boost::unordered_map<ulong64, uint>::const_iterator keyIt;
+
+  m_evalKeyIndex.clear();
+  output.reserve(last - first + 1);
 
   for(int i = first; i <= last; i++)
   {
-    evalRes = m_fitnessFunc->calc(i, &(generation->at(i)), fitValueVector);
-    generation->at(i).setFitness(fitValueVector);
+    sgpEntityBase &entity = generation->at(i);
+
+    // unchanged entity already has valid fitness
+    if (m_incrementalMode && !entity.isGenomeChanged())
+      continue;
+
+    if (m_fitnessCache == SC_NULL) {
+      output.push_back(i);
+      continue;
+    }
+
+    if (m_fitnessCache->find(entity, fitValueVector, key)) {
+      entity.setFitness(fitValueVector);
+      entity.setGenomeChanged(false);
+      continue;
+    }
+
+    // genome already listed in this pass - calculate it once
+    keyIt = m_evalKeyIndex.find(key.hash);
+    if ((keyIt != m_evalKeyIndex.end()) && (m_evalKeys[keyIt->second].check == key.check)) {
+      m_evalDuplicates.push_back(std::make_pair(static_cast<uint>(i), keyIt->second));
+      continue;
+    }
+
+    m_evalKeyIndex.insert(std::make_pair(key.hash, static_cast<uint>(output.size())));
+    output.push_back(i);
+    m_evalKeys.push_back(key);
+  }
+
+  return res;
+}
+
+bool sgpGaOperatorEvaluateBasic::evaluateList(sgpGaGeneration *generation, const sgpEntityIndexList &itemList)
+{
+  bool res = true;
+  bool evalRes;
+  sgpFitnessValue fitValueVector;
+  uint entityIndex;
+
+  if (m_fitnessFunc->isBatchSupported()) {
+    uint count;
+    for(uint i = 0, epos = itemList.size(); i < epos; i += count)
+    {
+      count = SC_MIN(m_batchSize, epos - i);
+      if (!evaluateBatch(generation, &itemList[i], count, m_batchBuffer))
+        res = false;
+      invokeNextEntity();
+    }
+    return res;
+  }
+
+  for(uint i = 0, epos = itemList.size(); i != epos; i++)
+  {
+    entityIndex = itemList[i];
+    evalRes = m_fitnessFunc->calc(entityIndex, &(generation->at(entityIndex)), fitValueVector);
+    generation->at(entityIndex).setFitness(fitValueVector);
 
     invokeNextEntity();
     res = res && evalRes;
   }
-  Counter::inc(COUNTER_EVAL, last - first + 1);
   return res;
 }
 
+bool sgpGaOperatorEvaluateBasic::evaluateBatch(sgpGaGeneration *generation, const uint *itemIndices, uint count, 
+  sgpEvalBatchBuffer &buffer) const
+{
+  sgpFitnessBatch batch;
+  const uint *genomeData;
+  uint genomeSize = 0;
+  uint itemCount;
+  bool useGenomes = true;
+
+  buffer.entities.resize(count);
+  for(uint i = 0; i != count; i++)
+    buffer.entities[i] = &(generation->at(itemIndices[i]));
+
+  // copy uint genomes to one buffer if all have the same size 
+  for(uint i = 0; (i != count) && useGenomes; i++)
+  {
+    genomeData = buffer.entities[i]->getGenomeData(0, itemCount);
+    if ((genomeData == SC_NULL) || (buffer.entities[i]->getGenomeCount() != 1)) {
+      useGenomes = false;
+    } else if (i == 0) {
+      genomeSize = itemCount;
+      buffer.genomes.resize(count * genomeSize);
+    } else if (itemCount != genomeSize) {
+      useGenomes = false;
+    }
+
+    if (useGenomes)
+      std::copy(genomeData, genomeData + genomeSize, buffer.genomes.begin() + i * genomeSize);
+  }
+
+  batch.count = count;
+  batch.entityIndices = itemIndices;
+  batch.entities = &buffer.entities[0];
+  batch.genomes = (useGenomes && !buffer.genomes.empty()) ? &buffer.genomes[0] : SC_NULL;
+  batch.genomeSize = useGenomes ? genomeSize : 0;
+
+  buffer.fitness.resize(count, m_fitnessFunc->getObjectiveCount());
+
+  bool res = m_fitnessFunc->calcBatch(batch, buffer.fitness);
+
+  for(uint i = 0; i != count; i++)
+  {
+    buffer.fitness.getRow(i, buffer.fitValue);
+    generation->at(itemIndices[i]).setFitness(buffer.fitValue);
+  }
+
+  return res;
+}
+
+void sgpGaOperatorEvaluateBasic::copyDuplicateFitness(sgpGaGeneration *generation, bool evalRes)
+{
+  for(uint i = 0, epos = m_evalDuplicates.size(); i != epos; i++)
+  {
+    sgpEntityBase &entity = generation->at(m_evalDuplicates[i].first);
+    entity.setFitness(generation->at(m_evalList[m_evalDuplicates[i].second]).getFitnessVector());
+    if (evalRes)
+      entity.setGenomeChanged(false);
+  }
+}
+
+// keys were calculated by prepareEvalList
+void sgpGaOperatorEvaluateBasic::storeInCache(sgpGaGeneration *generation, const sgpEntityIndexList &itemList)
+{
+  assert(m_evalKeys.size() == itemList.size());
+  for(uint i = 0, epos = itemList.size(); i != epos; i++)
+    m_fitnessCache->insert(m_evalKeys[i], generation->at(itemList[i]).getFitnessVector());
+}
+
 // ----------------------------------------------------------------------------
 // sgpGaOperatorEvaluateWithYield
 // ----------------------------------------------------------------------------
@@ -400,63 +914,139 @@ void sgpGaOperatorEvaluateWithYield::invokeNextEntity()
 // ----------------------------------------------------------------------------
 // sgpGaOperatorSelectBasic
 // ----------------------------------------------------------------------------
+sgpGaOperatorSelectBasic::sgpGaOperatorSelectBasic(): sgpGaOperatorSelect()
+{
+  m_susMode = false;
+}
+
+bool sgpGaOperatorSelectBasic::getSusMode() const
+{
+  return m_susMode;
+}
+
+void sgpGaOperatorSelectBasic::setSusMode(bool value)
+{
+  m_susMode = value;
+}
+
 void sgpGaOperatorSelectBasic::execute(sgpGaGeneration &input, sgpGaGeneration &output, uint limit)
 {
   if ((input.size() == 0) || (limit == 0))
     return;
 
   double fitSum = 0.0;
-  double fitMin = 0.0;
-  double p;
-  double fit;
+  std::vector<double> fitArr(input.size());
 
-  fitMin = input.at(0).getFitness();
-  
-  // calculate total fitness sum and min value
-  for(int i = input.beginPos(), epos = input.endPos(); i != epos; i++)
+  // collect weights & total fitness sum
+  for(uint j = 0, eposj = input.size(); j != eposj; j++)
   {
-    fit = input.at(i).getFitness();
-    fitSum += fit;
-    if (fit < fitMin)
-      fitMin = fit;
+    fitArr[j] = input.at(j).getFitness();
+    fitSum += fitArr[j];
   }
 
   // select new generation  
+  selectByWeights(input, output, limit, fitArr, fitSum, "select");
+}
+
+// roulette selection: alias table for non-negative weights, cumulative scan otherwise
+void sgpGaOperatorSelectBasic::selectByWeights(sgpGaGeneration &input, sgpGaGeneration &output, uint limit,
+  const std::vector<double> &weights, double weightSum, const char *traceName)
+{
+  if (m_susMode && selectUniversal(input, output, limit, weights, traceName))
+    return;
+
   uint j;
-  uint eposj = input.size() - 1;
+  sgpAliasSampler sampler;
+
+  if (sampler.build(weights)) {
+    for(uint i=0,epos=limit; i != epos; i++)
+    { 
+      j = sampler.sample();
+      output.insert(input.cloneItem(j));
+#ifdef TRACE_ENTITY_BIO
+      sgpEntityTracer::handleEntityMoved(j, output.size() - 1, traceName);
+#endif                             
+    }
+    return;
+  }
+
+  double p;
+  uint eposj = weights.size() - 1;
 
   std::vector<double> partSumArr(eposj+1);
-  partSumArr[0] = input.at(0).getFitness();
+  partSumArr[0] = weights[0];
   j = 0; 
   while(j < eposj) {
     j++; 
-    partSumArr[j] = partSumArr[j-1] + input.at(j).getFitness();
+    partSumArr[j] = partSumArr[j-1] + weights[j];
   } // while j
 
   for(uint i=0,epos=limit; i != epos; i++)
   { 
-    p = randomDouble(0.0, 1.0) * fitSum;
+    p = randomDouble(0.0, 1.0) * weightSum;
     j = 0; 
     while(j != eposj) {
-      if (p <= partSumArr[j]) {
-        output.insert(input.cloneItem(j));
-#ifdef TRACE_ENTITY_BIO
-    sgpEntityTracer::handleEntityMoved(j, output.size() - 1, "select");
-#endif                             
+      if (p <= partSumArr[j]) 
         break;
-      } else {
-        j++; 
-      } // if p      
+      j++; 
     } // while j
-    if (j == eposj) {
-      output.insert(input.cloneItem(eposj));    
+    output.insert(input.cloneItem(j));
 #ifdef TRACE_ENTITY_BIO
-    sgpEntityTracer::handleEntityMoved(eposj, output.size() - 1, "select");
+    sgpEntityTracer::handleEntityMoved(j, output.size() - 1, traceName);
 #endif                             
-    }  
   } // for i              
 }
 
+// one spin, "limit" pointers spaced by sum / limit, single pass over prefix sums
+bool sgpGaOperatorSelectBasic::selectUniversal(sgpGaGeneration &input, sgpGaGeneration &output, uint limit,
+  const std::vector<double> &weights, const char *traceName)
+{
+  uint count = weights.size();
+  std::vector<double> partSumArr(count);
+  double sum = 0.0;
+
+  for(uint j = 0; j != count; j++)
+  {
+    if (!(weights[j] >= 0.0))
+      return false;
+    sum += weights[j];
+    partSumArr[j] = sum;
+  }
+
+  if (!(sum > 0.0) || (sum - sum != 0.0))
+    return false;
+
+  double step = sum / static_cast<double>(limit);
+  double start = randomDouble(0.0, step);
+  double pointer;
+  uint j = 0;
+  uint lastPos = count - 1;
+  std::vector<uint> selected(limit);
+
+  for(uint i = 0; i != limit; i++)
+  {
+    pointer = start + step * static_cast<double>(i);
+    while((j < lastPos) && (pointer >= partSumArr[j]))
+      j++;
+    selected[i] = j;
+  }
+
+  // pointers return items in population order, shuffle them so that 
+  // neighbours in output (e.g. crossover pairs) are not correlated
+  for(uint i = limit - 1; i > 0; i--)
+    std::swap(selected[i], selected[randomUInt(0, i)]);
+
+  for(uint i = 0; i != limit; i++)
+  {
+    output.insert(input.cloneItem(selected[i]));
+#ifdef TRACE_ENTITY_BIO
+    sgpEntityTracer::handleEntityMoved(selected[i], output.size() - 1, traceName);
+#endif                             
+  }
+
+  return true;
+}
+
 // ----------------------------------------------------------------------------
 // sgpGaOperatorSelectPrec
 // ----------------------------------------------------------------------------
@@ -472,7 +1062,6 @@ void sgpGaOperatorSelectPrec::execute(sgpGaGeneration &input, sgpGaGeneration &o
   
   double fitSum = 0.0;
   double fitMin, fitMax, newFit;
-  double p;
   double fit;
   
   std::vector<double> rfit;
@@ -516,39 +1105,7 @@ void sgpGaOperatorSelectPrec::execute(sgpGaGeneration &input, sgpGaGeneration &o
   }  
       
   // select new generation
-  uint j;
-  uint eposj = input.size() - 1;
-
-  std::vector<double> partSumArr(eposj+1);
-  partSumArr[0] = rfit[0];
-  j = 0; 
-  while(j < eposj) {
-    j++; 
-    partSumArr[j] = partSumArr[j-1] + rfit[j];
-  } // while j
-
-  for(uint i=0,epos=limit; i != epos; i++)
-  { 
-    p = randomDouble(0.0, 1.0) * fitSum;
-    j = 0; 
-    while(j != eposj) {
-      if (p <= partSumArr[j]) {
-        output.insert(input.cloneItem(j));
-#ifdef TRACE_ENTITY_BIO
-    sgpEntityTracer::handleEntityMoved(j, output.size() - 1, "sel-prec");
-#endif                             
-        break;
-      } else {
-        j++; 
-      } // if p      
-    } // while j
-    if (j == eposj) {
-      output.insert(input.cloneItem(eposj));    
-#ifdef TRACE_ENTITY_BIO
-    sgpEntityTracer::handleEntityMoved(eposj, output.size() - 1, "sel-prec");
-#endif                             
-    }  
-  } // for i            
+  selectByWeights(input, output, limit, rfit, fitSum, "sel-prec");
 }
 
 // ----------------------------------------------------------------------------
@@ -577,22 +1134,17 @@ void sgpGaOperatorSelectTournament::setTemperature(double value)
 
 void sgpGaOperatorSelectTournament::execute(sgpGaGeneration &input, sgpGaGeneration &output, uint limit)
 {
-  std::set<uint> group;
+  sgpTournamentGroup group;
   uint tourSize = std::min<uint>(input.size(), m_tournamentSize);
-  uint idx, maxIdx;
+  uint maxIdx;
   double maxFit, fit;
     
   for(uint i=0,epos=limit; i != epos; i++)
   { 
-    group.clear();
-    while(group.size() < tourSize) {
-      idx = randomInt(0, input.size() - 1);
-      if (group.find(idx) == group.end()) 
-        group.insert(idx);
-    }
+    genRandomGroup(group, input, tourSize);
     maxIdx = *group.begin();
     maxFit = input[*group.begin()].getFitness();
-    for(std::set<uint>::const_iterator it=group.begin(),epos=group.end(); it != epos; ++it)
+    for(sgpTournamentGroup::const_iterator it=group.begin(),epos=group.end(); it != epos; ++it)
     { 
       fit = input[*it].getFitness();
       if (fit > maxFit) {
@@ -603,14 +1155,8 @@ void sgpGaOperatorSelectTournament::execute(sgpGaGeneration &input, sgpGaGenerat
 
     if ((m_temperature > 0.0) && randomFlip(m_temperature)) {
     // select random value, not best
-      group.erase(group.find(maxIdx));
-      uint setIdx = randomInt(0, group.size()-1);
-      std::set<uint>::const_iterator it = group.begin();
-      while(setIdx > 0) {
-        ++it;
-        setIdx--;
-      }  
-      maxIdx = *it;  
+      group.erase(maxIdx);
+      getRandomElement(maxIdx, group);
     } 
     
     output.insert(input.cloneItem(maxIdx));
@@ -629,13 +1175,12 @@ void sgpGaOperatorSelectTournament::genRandomGroup(sgpTournamentGroup &output, c
 
 void sgpGaOperatorSelectTournament::getRandomElement(uint &output, const sgpTournamentGroup &group)
 {
-  uint setIdx = randomInt(0, group.size()-1);
-  sgpTournamentGroup::const_iterator it = group.begin();
-  while(setIdx > 0) {
-    ++it;
-    setIdx--;
-  }  
-  output = *it;  
+  output = group[randomInt(0, group.size()-1)];
+}
+
+void sgpGaOperatorSelectTournament::getRandomElement(uint &output, const sgpTournamentGroup &group, sgpRandomSource &random)
+{
+  output = group[random.randomUInt(0, group.size()-1)];
 }
 
 // ----------------------------------------------------------------------------
@@ -700,7 +1245,8 @@ uint sgpGaOperatorSelectTournamentMF::findBestInGroup(const sgpGaGeneration &inp
   sgpTournamentGroup workGroupData;
   sgpTournamentGroup newWorkGroup;
   bool match;
-  sgpFitnessValue bestValues, fitVector;
+  const sgpFitnessValue *bestValues;
+  const sgpFitnessValue *fitVector;
   uint bestIndex;
   const uint UNSET_IDX = -1;
   uint lastFound = UNSET_IDX;
@@ -725,18 +1271,17 @@ uint sgpGaOperatorSelectTournamentMF::findBestInGroup(const sgpGaGeneration &inp
     wLevelIsNull = false;
     
     // find element with best set of values in work group
-    bestIndex = *workGroupPtr->cbegin();
-    bestValues.clear();
-    input.at(bestIndex).getFitness(bestValues);
+    bestIndex = *workGroupPtr->begin();
+    bestValues = &input.at(bestIndex).getFitnessVector();
     
     for(sgpTournamentGroup::const_iterator it = workGroupPtr->begin(),epos=workGroupPtr->end(); it != epos; ++it)
     {
-      input.at(*it).getFitness(fitVector);
+      fitVector = &input.at(*it).getFitnessVector();
       
       match = true;
       for(uint i=sgpFitnessValue::SGP_OBJ_OFFSET,epos = objCnt; i!=epos; i++) {
         if (weights[i] <= wLevel) {
-          if (bestValues[i] > fitVector[i]) {
+          if ((*bestValues)[i] > (*fitVector)[i]) {
             match = false;
             break;
           }  
@@ -753,12 +1298,12 @@ uint sgpGaOperatorSelectTournamentMF::findBestInGroup(const sgpGaGeneration &inp
     newWorkGroup.clear();
     for(sgpTournamentGroup::const_iterator it = workGroupPtr->begin(),epos=workGroupPtr->end(); it != epos; ++it)
     {
-      input.at(*it).getFitness(fitVector);
+      fitVector = &input.at(*it).getFitnessVector();
       
       match = true;
       for(uint i=sgpFitnessValue::SGP_OBJ_OFFSET,epos = objCnt; i!=epos; i++) {
         if (weights[i] <= wLevel) {
-          if (bestValues[i] > fitVector[i]) {
+          if ((*bestValues)[i] > (*fitVector)[i]) {
             match = false;
             break;
           }  
@@ -772,7 +1317,7 @@ uint sgpGaOperatorSelectTournamentMF::findBestInGroup(const sgpGaGeneration &inp
     } // for whole workgroup
 
     workGroupPtr = &workGroupData;
-    workGroupData = newWorkGroup;    
+    workGroupData.swap(newWorkGroup);
   } // while not one in workgroup
 
   if (lastFound == UNSET_IDX)
@@ -792,67 +1337,20 @@ void sgpGaOperatorEliteBasic::execute(sgpGaGeneration &input, sgpGaGeneration &o
   if ((input.size() == 0) || (limit == 0))
     return;
     
-  double maxFit, newMaxFit;
-  uint maxIdx, newMaxIdx, addedCnt;
-  double fit;
-  bool found;
-  
-  maxFit = input.at(0).getFitness();
-  maxIdx = 0;
-  addedCnt = 0;
+  // best entities with distinct fitness, lower index wins ties
+  sgpEntityIndexList idList;
+  uint entityIndex;
 
-  for(uint i = 0, epos = input.size(); i != epos; i++)
-  {
-    fit = input.at(i).getFitness();
-    if (fit > maxFit) {
-      maxFit = fit;
-      maxIdx = i;
-    }
-  }
-    
-  output.insert(output.newItem(input.at(maxIdx)));
-  addedCnt++;
-    
-  while(addedCnt < limit) {
-    found = false;
+  sgpFitnessScanner(&input).getTopIndicesByObjective(limit, 0, ttmDistinct, idList);
 
-    newMaxFit = input.at(0).getFitness();
-    newMaxIdx = 0;
-    
-    for(uint i = 0, epos = input.size(); i != epos; i++)
-    {
-      fit = input.at(i).getFitness();
-      if (!found || (fit > newMaxFit))
-      {
-        if (
-          (fit < maxFit)
-          ||
-          (
-            equDouble(fit, maxFit)
-            &&
-            (i < maxIdx)
-          )
-        )
-        {
-          newMaxFit = fit;
-          newMaxIdx = i;
-          found = true;
-        }    
-      }    
-    } // for i
-    
-    if (found) {
-      maxIdx = newMaxIdx;
-      maxFit = newMaxFit;      
-      output.insert(output.newItem(input.at(maxIdx)));
+  for(uint i = 0, epos = idList.size(); i != epos; i++)
+  {
+    entityIndex = idList[i];
+    output.insert(output.newItem(input.at(entityIndex)));
 #ifdef TRACE_ENTITY_BIO
-    sgpEntityTracer::handleEntityMoved(maxIdx, output.size() - 1, "elite");
+    sgpEntityTracer::handleEntityMoved(entityIndex, output.size() - 1, "elite");
 #endif                  
-      addedCnt++;    
-    } else {
-      break;
-    }
-  } // while    
+  }
 }
 
 // ----------------------------------------------------------------------------
@@ -924,12 +1422,48 @@ void sgpGaOperatorEliteByWeights::execute(sgpGaGeneration &input, sgpGaGeneratio
   }
 }
 
+// ----------------------------------------------------------------------------
+// sgpXOverParTask
+// ----------------------------------------------------------------------------
+/// Crosses single pair per task, each pair uses own random stream
+class sgpXOverParTask: public sgpWorkStealTask {
+public:
+  sgpXOverParTask(sgpGaOperatorXOverBasic *owner, sgpGaGeneration &generation, const sgpEntityIndexList &pairList, 
+    ulong64 seed, uint stepNo):
+    m_owner(owner), m_generation(generation), m_pairList(pairList), m_seed(seed), m_stepNo(stepNo)
+  {
+  }
+
+  uint getTaskCount() const {
+    return m_pairList.size() / 2;
+  }
+
+  virtual void runTask(uint workerNo, uint taskNo) {
+    uint first = m_pairList[2 * taskNo];
+    uint second = m_pairList[2 * taskNo + 1];
+    sgpRandomStream random(m_seed, m_stepNo, first, rsoXOver);
+
+    m_owner->crossGenomesPar(m_generation, first, second, random);
+  }
+
+private:
+  sgpGaOperatorXOverBasic *m_owner;
+  sgpGaGeneration &m_generation;
+  const sgpEntityIndexList &m_pairList;
+  ulong64 m_seed;
+  uint m_stepNo;
+};
+
 // ----------------------------------------------------------------------------
 // sgpGaOperatorXOverBasic
 // ----------------------------------------------------------------------------
 sgpGaOperatorXOverBasic::sgpGaOperatorXOverBasic()
 {
   m_probability = SGP_GA_DEF_OPER_PROB_XOVER;
+  m_inPlaceSupported = true;
+  m_parallel = false;
+  m_randomSeed = 0;
+  m_stepNo = 0;
 }
 
 sgpGaOperatorXOverBasic::~sgpGaOperatorXOverBasic()
@@ -944,62 +1478,194 @@ void sgpGaOperatorXOverBasic::setProbability(double aValue)
 void sgpGaOperatorXOverBasic::setMetaInfo(const sgpGaGenomeMetaList &list)
 {
   sgpGaOperatorXOver::setMetaInfo(list);
-  uint genomeSize = 0;
+  m_metaIndex.build(list);
+  m_genomeSize = m_metaIndex.getPointCount();
+
+  // alpha strings are crossed on text form of genome
+  m_inPlaceSupported = true;
+  for(uint i = 0, epos = list.size(); i != epos; i++)
+    if (list[i].genType == gagtAlphaString)
+      m_inPlaceSupported = false;
+}
+
+bool sgpGaOperatorXOverBasic::getParallel() const
+{
+  return m_parallel;
+}
+
+void sgpGaOperatorXOverBasic::setParallel(bool value)
+{
+  m_parallel = value;
+}
+
+uint sgpGaOperatorXOverBasic::getThreadCount() const
+{
+  return m_scheduler.getWorkerCount();
+}
+
+void sgpGaOperatorXOverBasic::setThreadCount(uint value)
+{
+  m_scheduler.setWorkerCount(value);
+}
+
+ulong64 sgpGaOperatorXOverBasic::getRandomSeed() const
+{
+  return m_randomSeed;
+}
+
+void sgpGaOperatorXOverBasic::setRandomSeed(ulong64 value)
+{
+  m_randomSeed = value;
+}
+
+void sgpGaOperatorXOverBasic::execute(sgpGaGeneration &newGeneration)
+{
+  if (m_meta.size() > 1) {
+    // overridden crossGenomes() is not used by parallel pass
+    if (m_parallel && hasDefaultHooks())
+      executeParallel(m_probability, newGeneration);
+    else
+      executeWithProb(m_probability, newGeneration);
+  }    
+}
+
+// Pairs are selected in the same way as in executeWithProb. 
+// Entities of a pair are not used by any other pair, so pair acceptance 
+// (canCrossGenomes) does not depend on crossing of previous pairs.
+void sgpGaOperatorXOverBasic::executeParallel(double aProb, sgpGaGeneration &newGeneration)
+{
+  double p;
+  int parentNo = 0;
+  int first = 0;
+
+  m_pairList.clear();
   
-  for(sgpGaGenomeMetaList::const_iterator it =list.begin(), epos = list.end(); it != epos; it++)
+  if (!canExecute()) 
+    return;
+
+  for(int i = newGeneration.beginPos(), epos = newGeneration.endPos(); i != epos; i++)
   {
-    genomeSize += it->genSize;
-  }  
-  m_genomeSize = genomeSize;
+    p = randomDouble(0.0, 1.0);
+    if (p < aProb) {
+      if(parentNo % 2 == 1) {
+        if (canCrossGenomes(newGeneration, first, i)) {
+          m_pairList.push_back(first);
+          m_pairList.push_back(i);
+          parentNo = 0;
+        }  
+      } else {
+        parentNo++;
+        first = i;
+      }        
+    }
+  }
+
+  if (m_pairList.empty())
+    return;
+
+  ulong64 seed = (m_randomSeed != 0) ? m_randomSeed : sgpRandomStream::newSeed();
+
+  sgpXOverParTask task(this, newGeneration, m_pairList, seed, m_stepNo++);
+  m_scheduler.execute(task.getTaskCount(), task);
 }
 
-void sgpGaOperatorXOverBasic::execute(sgpGaGeneration &newGeneration)
+bool sgpGaOperatorXOverBasic::crossGenomesPar(sgpGaGeneration &newGeneration, uint first, uint second, sgpRandomSource &random)
+{
+  return doCrossGenomes(newGeneration, first, second, random);
+}
+
+// crossGenomes() can be overridden in unknown subclasses
+bool sgpGaOperatorXOverBasic::hasDefaultHooks() const
+{
+  return (typeid(*this) == typeid(sgpGaOperatorXOverBasic));
+}
+
+bool sgpGaOperatorXOverBasic::canCrossGenomes(sgpGaGeneration &newGeneration, uint first, uint second)
 {
-  if (m_meta.size() > 1) 
-    executeWithProb(m_probability, newGeneration);
+  return true;
 }
 
 bool sgpGaOperatorXOverBasic::crossGenomes(sgpGaGeneration &newGeneration, uint first, uint second)
+{
+  if (!canCrossGenomes(newGeneration, first, second))
+    return false;
+
+  return doCrossGenomes(newGeneration, first, second, sgpGlobalRandomSource::instance());
+}
+
+bool sgpGaOperatorXOverBasic::doCrossGenomes(sgpGaGeneration &newGeneration, uint first, uint second, sgpRandomSource &random)
 {
   uint point, beg, end;
   
   if (m_meta.size() == 2) 
     point = m_meta[0].genSize;
   else 
-    point = randomInt(0, m_genomeSize - 1);  
+    point = random.randomInt(0, m_genomeSize - 1);  
   
   beg = point;
   end = m_genomeSize;
 
-  uint i = 0, epos = m_meta.size();
-  uint xpoint = 0;
+  uint epos = m_meta.size();
+  // first non-empty variable starting at or after crossover point
+  uint i = m_metaIndex.findVarFrom(beg);
+  uint xpoint = m_metaIndex.getVarOffset(i);
   uint endPoint;
-  
-  while((i < epos) && ((xpoint < beg) || (m_meta[i].genSize == 0))) {
-    xpoint += m_meta[i].genSize;
-    i++;
-  }
 
   // this operator works only with single-genome entities
   assert(newGeneration.at(first).getGenomeCount() == 1);
 
+  sgpEntityBase &firstEntity = newGeneration.at(first);
+  sgpEntityBase &secondEntity = newGeneration.at(second);
+
   sgpGaGenome firstGenome, secondGenome;
-  newGeneration.at(first).getGenome(0, firstGenome);
-  newGeneration.at(second).getGenome(0, secondGenome);
+  uint firstSize, secondSize;
+  const uint *firstConstData = firstEntity.getGenomeData(0, firstSize);
+  const uint *secondConstData = secondEntity.getGenomeData(0, secondSize);
+  uint *firstData = SC_NULL;
+  uint *secondData = SC_NULL;
+
+  // uint genomes are swapped in-place
+  bool useData = 
+    m_inPlaceSupported
+    &&
+    (firstConstData != SC_NULL) 
+    && 
+    (secondConstData != SC_NULL) 
+    && 
+    (firstSize == secondSize);
+
+  if (!useData) {
+    firstEntity.getGenome(0, firstGenome);
+    secondEntity.getGenome(0, secondGenome);
+  }
        
   while((i < epos) && (xpoint < end)) {
     if (xpoint + m_meta[i].genSize >= end)
       endPoint = end - xpoint;
     else 
       endPoint = xpoint + m_meta[i].genSize;    
-    if (m_meta[i].genSize > 0)  
-      crossVars(firstGenome, secondGenome, i, endPoint);  
+    if (m_meta[i].genSize > 0) {
+      if (!useData) {
+        crossVars(firstGenome, secondGenome, i, endPoint);  
+      } else if ((m_meta[i].genType == gagtRanged) && (firstConstData[i] != secondConstData[i])) {
+        // write access marks entities as changed - requested only if genes are really swapped
+        if (firstData == SC_NULL) {
+          firstData = firstEntity.modifyGenomeData(0, firstSize);
+          secondData = secondEntity.modifyGenomeData(0, secondSize);
+          firstConstData = firstData;
+          secondConstData = secondData;
+        }
+        crossVarsUInt(firstData, secondData, i);  
+      }
+    }  
     xpoint += m_meta[i].genSize;
     i++;  
   }    
 
-  newGeneration.at(first).setGenome(0, firstGenome);
-  newGeneration.at(second).setGenome(0, secondGenome);
+  if (!useData) {
+    firstEntity.setGenome(0, firstGenome);
+    secondEntity.setGenome(0, secondGenome);
+  }
   
   return true;
 }
@@ -1033,10 +1699,20 @@ void sgpGaOperatorXOverBasic::crossVars(sgpGaGenome &firstGenome, sgpGaGenome &s
    }
 }
 
+void sgpGaOperatorXOverBasic::crossVarsUInt(uint *firstGenome, uint *secondGenome, uint genIndex)
+{
+  std::swap(firstGenome[genIndex], secondGenome[genIndex]);
+}
+
 // ----------------------------------------------------------------------------
 // sgpGaOperatorXOverSpecies
 // ----------------------------------------------------------------------------
 
+bool sgpGaOperatorXOverSpecies::hasDefaultHooks() const
+{
+  return (typeid(*this) == typeid(sgpGaOperatorXOverSpecies));
+}
+
 void sgpGaOperatorXOverSpecies::setMatchThreshold(double aValue) 
 {
   m_matchThreshold = aValue;
@@ -1076,12 +1752,9 @@ void sgpGaOperatorXOverSpecies::checkCompareTool()
     m_compareTool.reset(new sgpGaGenomeCompareToolForGa());  
 }
 
-bool sgpGaOperatorXOverSpecies::crossGenomes(sgpGaGeneration &newGeneration, uint first, uint second)
+bool sgpGaOperatorXOverSpecies::canCrossGenomes(sgpGaGeneration &newGeneration, uint first, uint second)
 {
-  if ((m_genomeSize == 0) || (m_compareTool->calcGenomeDiff(newGeneration, first, second) <= m_matchThreshold))
-    return sgpGaOperatorXOverBasic::crossGenomes(newGeneration, first, second);
-  else
-    return false;
+  return ((m_genomeSize == 0) || (m_compareTool->calcGenomeDiff(newGeneration, first, second) <= m_matchThreshold));
 }      
 
 
@@ -1236,7 +1909,14 @@ void selectProbItem(const scDataNode &list, double probSum, std::vector<uint> &o
 
   if (list.empty())
     return;
-    
+
+  sgpAliasSampler sampler;
+  if (sampler.build(list)) {
+    sampler.sample(sgpGlobalRandomSource::instance(), limit, output);
+    return;
+  }
+
+  // weights not usable by sampler (negative values), use cumulative scan
   uint endPos = list.size();
   endPos--;
     
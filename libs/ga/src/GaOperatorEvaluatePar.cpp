@@ -0,0 +1,162 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        GaOperatorEvaluatePar.cpp
+// Project:     sgpLib
+// Purpose:     Evaluation operator running fitness function on several threads
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+#include "sc/defs.h"
+
+//sc
+#include "sc/utils.h"
+
+//sgp
+#include "sgp/GaOperatorEvaluatePar.h"
+
+#ifdef DEBUG_MEM
+#include "sc/DebugMem.h"
+#endif
+
+using namespace dtp;
+
+// ----------------------------------------------------------------------------
+// sgpEvaluateParTask
+// ----------------------------------------------------------------------------
+/// Evaluates single entity per task, first error stops the processing
+class sgpEvaluateParTask: public sgpWorkStealTask {
+public:
+  sgpEvaluateParTask(const sgpFitnessFunction *fitnessFunc, sgpGaGeneration *generation, const sgpEntityIndexList &itemList, uint workerCount):
+    m_fitnessFunc(fitnessFunc), m_generation(generation), m_itemList(itemList),
+    m_fitValues(workerCount), m_failedCounts(workerCount, 0)
+  {
+  }
+
+  virtual void runTask(uint workerNo, uint taskNo) {
+    uint entityIndex = m_itemList[taskNo];
+    // fitness buffer private for each worker
+    sgpFitnessValue &fitValueVector = m_fitValues[workerNo];
+
+    if (!m_fitnessFunc->calc(entityIndex, &(m_generation->at(entityIndex)), fitValueVector))
+      m_failedCounts[workerNo]++;
+    m_generation->at(entityIndex).setFitness(fitValueVector);
+  }
+
+  uint getFailedCount() const {
+    uint res = 0;
+    for(uint i=0, epos = m_failedCounts.size(); i != epos; i++)
+      res += m_failedCounts[i];
+    return res;
+  }
+
+private:
+  const sgpFitnessFunction *m_fitnessFunc;
+  sgpGaGeneration *m_generation;
+  const sgpEntityIndexList &m_itemList;
+  std::vector<sgpFitnessValue> m_fitValues;
+  std::vector<uint> m_failedCounts;
+};
+
+// ----------------------------------------------------------------------------
+// sgpEvaluateParBatchTask
+// ----------------------------------------------------------------------------
+/// Evaluates one batch of entities per task
+class sgpEvaluateParBatchTask: public sgpWorkStealTask {
+public:
+  sgpEvaluateParBatchTask(const sgpGaOperatorEvaluatePar *owner, sgpGaGeneration *generation, const sgpEntityIndexList &itemList, 
+    uint batchSize, uint workerCount):
+    m_owner(owner), m_generation(generation), m_itemList(itemList), m_batchSize(batchSize),
+    m_buffers(workerCount), m_failedCounts(workerCount, 0)
+  {
+  }
+
+  uint getTaskCount() const {
+    return (m_itemList.size() + m_batchSize - 1) / m_batchSize;
+  }
+
+  virtual void runTask(uint workerNo, uint taskNo) {
+    uint first = taskNo * m_batchSize;
+    uint count = SC_MIN(m_batchSize, m_itemList.size() - first);
+
+    if (!m_owner->evaluateBatchPar(m_generation, &m_itemList[first], count, m_buffers[workerNo]))
+      m_failedCounts[workerNo]++;
+  }
+
+  uint getFailedCount() const {
+    uint res = 0;
+    for(uint i=0, epos = m_failedCounts.size(); i != epos; i++)
+      res += m_failedCounts[i];
+    return res;
+  }
+
+private:
+  const sgpGaOperatorEvaluatePar *m_owner;
+  sgpGaGeneration *m_generation;
+  const sgpEntityIndexList &m_itemList;
+  uint m_batchSize;
+  std::vector<sgpEvalBatchBuffer> m_buffers;
+  std::vector<uint> m_failedCounts;
+};
+
+// ----------------------------------------------------------------------------
+// sgpGaOperatorEvaluatePar
+// ----------------------------------------------------------------------------
+sgpGaOperatorEvaluatePar::sgpGaOperatorEvaluatePar(): inherited()
+{
+}
+
+sgpGaOperatorEvaluatePar::~sgpGaOperatorEvaluatePar()
+{
+}
+
+uint sgpGaOperatorEvaluatePar::getThreadCount() const
+{
+  return m_scheduler.getWorkerCount();
+}
+
+void sgpGaOperatorEvaluatePar::setThreadCount(uint value)
+{
+  m_scheduler.setWorkerCount(value);
+}
+
+bool sgpGaOperatorEvaluatePar::evaluateBatchPar(sgpGaGeneration *generation, const uint *itemIndices, uint count, 
+  sgpEvalBatchBuffer &buffer) const
+{
+  return evaluateBatch(generation, itemIndices, count, buffer);
+}
+
+void sgpGaOperatorEvaluatePar::getCounters(scDataNode &output)
+{
+  m_scheduler.getCounters(output);
+}
+
+void sgpGaOperatorEvaluatePar::resetCounters()
+{
+  m_scheduler.resetStats();
+}
+
+bool sgpGaOperatorEvaluatePar::evaluateList(sgpGaGeneration *generation, const sgpEntityIndexList &itemList)
+{
+  uint workerCount = m_scheduler.calcWorkerCount();
+
+  if ((workerCount < 2) || (itemList.size() < 2))
+    return inherited::evaluateList(generation, itemList);
+
+  if (m_fitnessFunc->isBatchSupported()) {
+    // split list so that each worker gets at least one batch
+    uint batchSize = (itemList.size() + workerCount - 1) / workerCount;
+    batchSize = SC_MIN(getBatchSize(), batchSize);
+    sgpEvaluateParBatchTask batchTask(this, generation, itemList, batchSize, workerCount);
+    m_scheduler.execute(batchTask.getTaskCount(), batchTask);
+    invokeNextEntity();
+    return (batchTask.getFailedCount() == 0);
+  }
+
+  sgpEvaluateParTask task(m_fitnessFunc, generation, itemList, workerCount);
+
+  m_scheduler.execute(itemList.size(), task);
+
+  // yield signal is not thread-safe, invoke it once per list
+  invokeNextEntity();
+  return (task.getFailedCount() == 0);
+}
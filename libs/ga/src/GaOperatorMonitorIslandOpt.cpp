@@ -17,6 +17,7 @@
 //sgp
 #include "sgp/GaStatistics.h"
 #include "sgp/GaOperatorMonitorIslandOpt.h"
+#include "sgp/FitnessScanner.h"
 
 #ifdef DEBUG_MEM
 #include "sc/DebugMem.h"
@@ -142,9 +143,14 @@ void sgpGaOperatorMonitorIslandOpt::rateIslands(const sgpGaGeneration &input, sc
     islandRating.addChild(toString(i), new scDataNode(0.0));
   }  
 
-  for(sgpObjectiveIndexSet::const_iterator it = m_ratingObjs.begin(), epos = m_ratingObjs.end(); it != epos; ++it)
+  std::vector<uint> ratingObjs(m_ratingObjs.begin(), m_ratingObjs.end());
+  std::vector<sgpEntityIndexList> topIdLists;
+
+  getTopGenomesByObjectives(input, ratingObjs, topIdLists);
+
+  for(uint i=0, epos = ratingObjs.size(); i != epos; i++)
   { 
-    addIslandRatingForObjective(islandRating, input, *it);
+    addIslandRatingForObjective(islandRating, input, ratingObjs[i], topIdLists[i]);
   }
   
   double rating;
@@ -168,84 +174,75 @@ void sgpGaOperatorMonitorIslandOpt::rateIslands(const sgpGaGeneration &input, sc
 
 void sgpGaOperatorMonitorIslandOpt::calcIslandsSize(const sgpGaGeneration &input, scDataNode &islandSize)
 {
+  sgpIslandPartition islands;
+
+  m_islandTool->prepareIslandPartition(input, islands);
+
   islandSize.clear();
 
   for(uint i=0, epos = m_islandLimit; i != epos; i++)
   {
     islandSize.addChild(new scDataNode(toString(i), 0));
+    islandSize.setUInt(i, islands.getIslandSize(i));
   }  
-
-  sgpEntityBase *entity;
-  scString islandName;
-  uint islandId;
-
-  for(uint i=0, epos = input.size(); i != epos; i++)  
-  {
-    entity = &(const_cast<sgpEntityBase &>(input[i]));
-    if (m_islandTool->getIslandId(*entity, islandId))
-    {
-      islandName = toString(islandId);   
-
-      islandSize.setUInt(islandName, islandSize.getUInt(islandName, 0) + 1);
-    }
-  }    
 }
 
 // calculate avg pos in top for a given objective for each island, add result to existing island rating
-void sgpGaOperatorMonitorIslandOpt::addIslandRatingForObjective(scDataNode &islandRating, const sgpGaGeneration &input, uint objectiveIndex)
+void sgpGaOperatorMonitorIslandOpt::addIslandRatingForObjective(scDataNode &islandRating, const sgpGaGeneration &input, uint objectiveIndex,
+  const sgpEntityIndexList &topIdList)
 {
   const double DIV_HELPER = 1.0;
-  scDataNode topIslandSum, topIslandSize;
-  scDataNode topIslandIds;
+  std::vector<double> topIslandSum;
+  std::vector<uint> topIslandSize;
+  std::vector<uint> topIslandIds;
   
-  getTopGenomesByObjective(input, objectiveIndex, topIslandIds);
+  prepareIslandIds(input, topIdList, topIslandIds);
     
   // add positions & calc number of items per each island
   calcTopIslandStats(input, topIslandIds, topIslandSum, topIslandSize);
   double objRating;
-  scString islandName;
 
   std::auto_ptr<scDataNode> rowGuard;
   
-  // update total rating
-  for(uint i=0, epos = topIslandSum.size(); i != epos; i++)
+  // update total rating, islandRating contains islands 0..m_islandLimit-1 in id order
+  for(uint islandId=0, epos = SC_MIN(topIslandSum.size(), islandRating.size()); islandId != epos; islandId++)
   {
-    islandName = topIslandSum.getElementName(i);
+    if (topIslandSize[islandId] == 0)
+      continue;
     // island sum contains positions, 0 - best, 19 - worst, so we need to invert it
     // 0 -> 1
     // 1 -> 1/2
     // 2 -> 1/3    
-    objRating = 1.0/(DIV_HELPER + (topIslandSum.getDouble(i) / static_cast<double>(topIslandSize.getUInt(islandName))));
-    islandRating.setDouble(islandName, islandRating.getDouble(islandName) + objRating);
+    objRating = 1.0/(DIV_HELPER + (topIslandSum[islandId] / static_cast<double>(topIslandSize[islandId])));
+    islandRating.setDouble(islandId, islandRating.getDouble(islandId) + objRating);
 
     rowGuard.reset(new scDataNode);
     rowGuard->setAsParent();    
     rowGuard->addChild("step", new scDataNode(m_activeStepNo));
     rowGuard->addChild("obj-idx", new scDataNode(objectiveIndex));
-    rowGuard->addChild("island", new scDataNode(islandName));
-    rowGuard->addChild("sum", new scDataNode(topIslandSum.getDouble(i)));
-    rowGuard->addChild("size", new scDataNode(topIslandSize.getUInt(islandName)));     
+    rowGuard->addChild("island", new scDataNode(toString(islandId)));
+    rowGuard->addChild("sum", new scDataNode(topIslandSum[islandId]));
+    rowGuard->addChild("size", new scDataNode(topIslandSize[islandId]));     
     rowGuard->addChild("obj-rating", new scDataNode(objRating));     
-    rowGuard->addChild("curr-total-rating", new scDataNode(islandRating.getDouble(islandName)));     
+    rowGuard->addChild("curr-total-rating", new scDataNode(islandRating.getDouble(islandId)));     
     m_experimentLog->addLineToCsvFile(*rowGuard, "rating_stats", "csv");
   }
 }
 
-void sgpGaOperatorMonitorIslandOpt::getTopGenomesByObjective(const sgpGaGeneration &input, uint objectiveIndex, 
-  scDataNode &topIslandIds)
+void sgpGaOperatorMonitorIslandOpt::getTopGenomesByObjectives(const sgpGaGeneration &input, const std::vector<uint> &objectiveIndices, 
+  std::vector<sgpEntityIndexList> &topIdLists)
 {
-  sgpEntityIndexList topIdList;
-  sgpGaEvolver::getTopGenomesByObjective(input, MAX_ISLAND_TOP_SIZE, objectiveIndex, topIdList); 
-  prepareIslandIds(input, topIdList, topIslandIds);
+  sgpFitnessScanner(&input).getTopIndicesByObjectives(MAX_ISLAND_TOP_SIZE, objectiveIndices, ttmDistinct, topIdLists); 
 }  
 
 void sgpGaOperatorMonitorIslandOpt::prepareIslandIds(const sgpGaGeneration &input, const sgpEntityIndexList &topIdList, 
-  scDataNode &topIslandIds)
+  std::vector<uint> &topIslandIds)
 {
   sgpEntityBase *entity; 
   uint islandId;
 
-  topIslandIds.setAsArray(vt_uint);
+  topIslandIds.clear();
+  topIslandIds.reserve(topIdList.size());
   for(uint i=0, epos = topIdList.size(); i != epos; i++)  
   {
     entity = &(const_cast<sgpEntityBase &>(input[topIdList[i]]));
@@ -253,36 +250,31 @@ void sgpGaOperatorMonitorIslandOpt::prepareIslandIds(const sgpGaGeneration &inpu
     if (!m_islandTool->getIslandId(*entity, islandId))
       islandId = m_islandLimit;
 
-    topIslandIds.addItem(scDataNode(islandId));  
+    topIslandIds.push_back(islandId);  
   }  
 }
 
+// sum of positions in top list and number of top items for each island, indexed by island id
 void sgpGaOperatorMonitorIslandOpt::calcTopIslandStats(const sgpGaGeneration &input, 
-  const scDataNode &topIslandIds,
-  scDataNode &topIslandSum, scDataNode &topIslandSize)
+  const std::vector<uint> &topIslandIds,
+  std::vector<double> &topIslandSum, std::vector<uint> &topIslandSize)
 {  
-  scString islandName;
-  uint islandId, islandPos;
+  uint islandId;
+
+  topIslandSum.assign(m_islandLimit + 1, 0.0);
+  topIslandSize.assign(m_islandLimit + 1, 0);
 
   for(uint i=0, epos = topIslandIds.size(); i != epos; i++)  
   {
-    if (topIslandIds.size() > 0) {
-      islandId = topIslandIds.getElement(i).getUInt(0);    
-      islandPos = topIslandIds.getElement(i).getUInt(1);    
-    } else {
-      islandId = topIslandIds.getUInt(i);    
-      islandPos = i;
-    }  
-    islandName = toString(islandId);  
-
-    if (!topIslandSum.hasChild(islandName))
-    {
-      topIslandSum.addChild(islandName, new scDataNode(0.0));
-      topIslandSize.addChild(islandName, new scDataNode((uint)0));        
+    islandId = topIslandIds[i];    
+
+    if (islandId >= topIslandSum.size()) {
+      topIslandSum.resize(islandId + 1, 0.0);
+      topIslandSize.resize(islandId + 1, 0);
     }
 
-    topIslandSum.setDouble(islandName, topIslandSum.getDouble(islandName) + static_cast<double>(islandPos));
-    topIslandSize.setUInt(islandName, topIslandSize.getUInt(islandName) + 1);
+    topIslandSum[islandId] += static_cast<double>(i);
+    topIslandSize[islandId]++;
   }  
 }
 
@@ -11,6 +11,7 @@
 //std
 #include <set>
 #include <cmath>
+#include <typeinfo>
 
 //base
 #include "base/rand.h"
@@ -83,6 +84,7 @@ void sgpGaOperatorMutateEx::beforeExecute(sgpGaGeneration &newGeneration)
   m_activeGeneration = &newGeneration;
   m_activeIslandId = 0;
   m_lastIslandId = static_cast<uint>(-1);
+  m_entityIslandIds.resize(newGeneration.size());
 }
 
 void sgpGaOperatorMutateEx::updateIslandId(uint entityIndex)
@@ -142,22 +144,22 @@ void sgpGaOperatorMutateEx::invokeNextEntity()
     m_yieldSignal->execute();
 }
 
-bool sgpGaOperatorMutateEx::processGenome(uint entityIndex, sgpGaGenome &genome) {
+bool sgpGaOperatorMutateEx::processEntity(uint entityIndex, sgpEntityBase &entity) {
   updateIslandId(entityIndex);
 
   bool protectIslandId = ((m_features & gmfProtectIslandId) != 0);
   uint oldIslandId = 0;
 
   if (protectIslandId)
-    m_islandTool->getIslandId(m_activeGeneration->at(entityIndex), oldIslandId);
+    m_islandTool->getIslandId(entity, oldIslandId);
 
-  bool res = inherited::processGenome(entityIndex, genome);
+  bool res = inherited::processEntity(entityIndex, entity);
   if (res) {
     if (protectIslandId) {
       uint newIslandId;
-      m_islandTool->getIslandId(m_activeGeneration->at(entityIndex), newIslandId);
+      m_islandTool->getIslandId(entity, newIslandId);
       if (newIslandId != oldIslandId)
-        m_islandTool->setIslandId(m_activeGeneration->at(entityIndex), oldIslandId);
+        m_islandTool->setIslandId(entity, oldIslandId);
     }
 
     invokeEntityChanged(entityIndex);
@@ -166,6 +168,29 @@ bool sgpGaOperatorMutateEx::processGenome(uint entityIndex, sgpGaGenome &genome)
   return res;  
 }
 
+bool sgpGaOperatorMutateEx::hasDefaultHooks() const
+{
+  return (typeid(*this) == typeid(sgpGaOperatorMutateEx));
+}
+
+void sgpGaOperatorMutateEx::prepareEntity(uint entityIndex)
+{
+  updateIslandId(entityIndex);
+  m_entityIslandIds[entityIndex] = m_activeIslandId;
+}
+
+void sgpGaOperatorMutateEx::finishEntity(uint entityIndex, sgpEntityBase &entity)
+{
+  if ((m_features & gmfProtectIslandId) != 0) {
+    uint newIslandId;
+    m_islandTool->getIslandId(entity, newIslandId);
+    if (newIslandId != m_entityIslandIds[entityIndex])
+      m_islandTool->setIslandId(entity, m_entityIslandIds[entityIndex]);
+  }
+
+  invokeEntityChanged(entityIndex);
+}
+
 void sgpGaOperatorMutateEx::invokeEntityChanged(uint entityIndex)
 {
   m_counter.inc("gx-mut-f-chg-entities");
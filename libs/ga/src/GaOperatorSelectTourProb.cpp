@@ -22,10 +22,10 @@
 
 //sc
 #include "sc/smath.h"
-#include "sc/alg/kmeans.h"
 //sgp
 #include "sgp/GaOperatorSelectTourProb.h"
 #include "sgp/GaStatistics.h"
+#include "sgp/AliasSampler.h"
 
 #include "sgp/ExperimentConst.h"
 
@@ -53,11 +53,34 @@ const bool TOUR_USE_PROB_ONLY_FOR_NON_DOMIN = true;
 const double TOUR_DISTRIB_NARROW_FACTOR = 10.0; 
 const double TOUR_SHAPE_SEL_PROB_MARGIN = 0.1;
 
-const uint ISLAND_DATA_IDX_SHAPE_COLN = 0;
-const uint ISLAND_DATA_IDX_SHAPE_DISTRIB = 1;
-const uint ISLAND_DATA_IDX_SIZE = 2;
-const uint ISLAND_DATA_IDX_SHAPE_DISTRIB_SUM = 3;
+// number of items selected by a single task in parallel mode
+const uint TOUR_PAR_BLOCK_SIZE = 16;
   
+// ----------------------------------------------------------------------------
+// sgpTourProbParTask
+// ----------------------------------------------------------------------------
+/// Runs tournaments for a single quota block, each block uses own random stream
+class sgpTourProbParTask: public sgpWorkStealTask {
+public:
+  sgpTourProbParTask(sgpGaOperatorSelectTourProb *owner, const sgpGaGeneration &input, sgpTourProbParBlockList &blocks, 
+    ulong64 seed, uint stepNo):
+    m_owner(owner), m_input(input), m_blocks(blocks), m_seed(seed), m_stepNo(stepNo)
+  {
+  }
+
+  virtual void runTask(uint workerNo, uint taskNo) {
+    sgpRandomStream random(m_seed, m_stepNo, taskNo, rsoSelect);
+    m_owner->selectBlockPar(m_input, m_blocks[taskNo], random);
+  }
+
+private:
+  sgpGaOperatorSelectTourProb *m_owner;
+  const sgpGaGeneration &m_input;
+  sgpTourProbParBlockList &m_blocks;
+  ulong64 m_seed;
+  uint m_stepNo;
+};
+
 // ----------------------------------------------------------------------------
 // sgpGaOperatorSelectTourProb
 // ----------------------------------------------------------------------------
@@ -71,6 +94,11 @@ sgpGaOperatorSelectTourProb::sgpGaOperatorSelectTourProb(): inherited()
   m_islandLimit = 0;
   m_experimentParams = SC_NULL;
   m_islandTool = SC_NULL;
+  m_parallel = false;
+  m_randomSeed = 0;
+  m_verifyMatchKernel = false;
+  m_matchRoundLimit = TOUR_LOOP_LIMIT;
+  m_stepNo = 0;
 }
 
 sgpGaOperatorSelectTourProb::~sgpGaOperatorSelectTourProb()
@@ -164,6 +192,69 @@ void sgpGaOperatorSelectTourProb::setIslandTool(sgpEntityIslandToolIntf *value)
   m_islandTool = value;
 }
 
+bool sgpGaOperatorSelectTourProb::getParallel() const
+{
+  return m_parallel;
+}
+
+void sgpGaOperatorSelectTourProb::setParallel(bool value)
+{
+  m_parallel = value;
+}
+
+uint sgpGaOperatorSelectTourProb::getThreadCount() const
+{
+  return m_scheduler.getWorkerCount();
+}
+
+void sgpGaOperatorSelectTourProb::setThreadCount(uint value)
+{
+  m_scheduler.setWorkerCount(value);
+}
+
+ulong64 sgpGaOperatorSelectTourProb::getRandomSeed() const
+{
+  return m_randomSeed;
+}
+
+void sgpGaOperatorSelectTourProb::setRandomSeed(ulong64 value)
+{
+  m_randomSeed = value;
+}
+
+bool sgpGaOperatorSelectTourProb::getVerifyMatchKernel() const
+{
+  return m_verifyMatchKernel;
+}
+
+void sgpGaOperatorSelectTourProb::setVerifyMatchKernel(bool value)
+{
+  m_verifyMatchKernel = value;
+}
+
+uint sgpGaOperatorSelectTourProb::getMatchRoundLimit() const
+{
+  return m_matchRoundLimit;
+}
+
+void sgpGaOperatorSelectTourProb::setMatchRoundLimit(uint value)
+{
+  m_matchRoundLimit = value;
+}
+
+void sgpGaOperatorSelectTourProb::resetCounters()
+{
+  m_matchStats.clear();
+}
+
+void sgpGaOperatorSelectTourProb::getCounters(scDataNode &output) const
+{
+  output.addChild("gx-tour-match-groups", new scDataNode(m_matchStats.groupCount));
+  output.addChild("gx-tour-match-rounds", new scDataNode(m_matchStats.roundCount));
+  output.addChild("gx-tour-match-equal-exits", new scDataNode(m_matchStats.equalShortcutCount));
+  output.addChild("gx-tour-match-limit-hits", new scDataNode(m_matchStats.limitHitCount));
+}
+
 void sgpGaOperatorSelectTourProb::prepareShapeCollectionByObj(const sgpGaGeneration &input, 
   scDataNode &output)
 {
@@ -203,7 +294,7 @@ class lessThenPred {    // function object that returns true if value is less th
 };
 
 void sgpGaOperatorSelectTourProb::prepareShapeCollectionByObjDistrib(const sgpGaGeneration &input, 
-  const scDataNode *itemList, uint islandId,
+  const sgpIslandPartition *islands, uint islandId,
   scDataNode &shapeList, scDataNode &shapeDistrib, double decFactor)
 { 
   bool oneLevel;
@@ -219,15 +310,19 @@ void sgpGaOperatorSelectTourProb::prepareShapeCollectionByObjDistrib(const sgpGa
   selectShapeObj(islandId, oneLevel, shapeObjIdx);
     
   uint eposj, idx;
-  if (itemList != SC_NULL)
-    eposj = itemList->size();
-  else
+  const uint *itemList;
+  if (islands != SC_NULL) {
+    itemList = islands->getIslandItems(islandId);
+    eposj = islands->getIslandSize(islandId);
+  } else {
+    itemList = SC_NULL;
     eposj = input.size();
+  }
         
   for(uint j=0; j != eposj; j++)
   {
     if (itemList != SC_NULL)
-      idx = (*itemList).getUInt(j);
+      idx = itemList[j];
     else
       idx = j;
         
@@ -308,6 +403,7 @@ void sgpGaOperatorSelectTourProb::prepareShapeDistrib(const scDataNode &shapeLis
 
   for(uint i=0, epos = shapeListWithPriority.size(); i != epos; i++)
   {
+    priority = shapeListWithPriority.getDouble(i);
     lessCount = std::distance(shapeVect.begin(), std::lower_bound(shapeVect.begin(), shapeVect.end(), priority));
 
     fitRate = static_cast<double>(lessCount)/dTotalCount;
@@ -320,6 +416,17 @@ void sgpGaOperatorSelectTourProb::prepareShapeDistrib(const scDataNode &shapeLis
   }
 }  
 
+void sgpGaOperatorSelectTourProb::prepareShapeSampler(const scDataNode &shapeDistrib, sgpAliasSampler &output)
+{
+  std::vector<double> weights(shapeDistrib.size());
+
+  for(uint i=0, epos = weights.size(); i != epos; i++)
+    weights[i] = shapeDistrib.getDouble(i);
+
+  // failed build leaves sampler empty
+  output.build(weights);
+}
+
 void sgpGaOperatorSelectTourProb::prepareShapeCollectionByCluster(const sgpGaGeneration &input, 
   scDataNode &shapeList)
 {
@@ -327,129 +434,136 @@ void sgpGaOperatorSelectTourProb::prepareShapeCollectionByCluster(const sgpGaGen
   prepareShapeCollectionByCluster(input, SC_NULL, 0, shapeList, shapeDistrib, 1.0);
 }
 
+// Clusters are kept as list of index arrays (one per shape), priority of 
+// shape is a center of cluster on shape objective.
 void sgpGaOperatorSelectTourProb::prepareShapeCollectionByCluster(const sgpGaGeneration &input, 
-  const scDataNode *itemList, uint islandId,
+  const sgpIslandPartition *islands, uint islandId,
   scDataNode &shapeList, scDataNode &shapeDistrib, double decFactor)
 {
   bool oneLevel;
   uint shapeObjIdx;
-
-  scKMeansCalculator calc;
-  double objValue;
-  scDataNode clusterInput, clusterOutput;
-  scString shapeName;
-  scDataNode shapeListForDistrib;
+  uint epos, idx;
+  const uint *itemList;
+  scDataNode shapeListForDistrib(ict_array, vt_double);
 
   selectShapeObj(islandId, oneLevel, shapeObjIdx);
 
-  uint epos, idx;
-
-  if (itemList != SC_NULL)
-    epos = itemList->size();
-  else
+  if (islands != SC_NULL) {
+    itemList = islands->getIslandItems(islandId);
+    epos = islands->getIslandSize(islandId);
+  } else {
+    itemList = SC_NULL;
     epos = input.size();
+  }
+
+  m_shapeColumn.resize(epos);
+  if (!oneLevel)
+    m_shapeColumn2.resize(epos);
 
   for(uint i=0; i != epos; i++)
   {
     if (itemList != SC_NULL)
-      idx = (*itemList).getUInt(i);
+      idx = itemList[i];
     else
       idx = i;
 
-    objValue = input[idx].getFitness(shapeObjIdx);
-
-    if (oneLevel)    
-    {
-      clusterInput.addItemAsDouble(objValue);
-    } else {
-      clusterInput.addChild(new scDataNode());
-      clusterInput[i].addItemAsDouble(objValue);
-      objValue = input[idx].getFitness(m_secShapeObjIndex);
-      clusterInput[i].addItemAsDouble(objValue);
-    }  
+    m_shapeColumn[i] = input[idx].getFitness(shapeObjIdx);
+    if (!oneLevel)
+      m_shapeColumn2[i] = input[idx].getFitness(m_secShapeObjIndex);
   }  
+
+  sgpShapeClusterer &clusterer = getShapeClusterer(islands, islandId);
   
-  calc.execute(clusterInput, clusterOutput, m_shapeLimit, TOUR_PROB_SHAPE_STEPS);
+  if (epos == 0)
+    clusterer.execute(SC_NULL, 0, m_shapeLimit);
+  else if (oneLevel)
+    clusterer.execute(&m_shapeColumn[0], epos, m_shapeLimit);
+  else
+    clusterer.execute(&m_shapeColumn[0], &m_shapeColumn2[0], epos, m_shapeLimit, TOUR_PROB_SHAPE_STEPS);
+
+  std::auto_ptr<scDataNode> shapeGuard;
+  const uint *clusterItems;
+
+  shapeList.clear();
+  shapeList.setAsList();
 
-  for(uint i=0, epos = clusterOutput.size(); i != epos; i++)
+  for(uint c=0, eposc = clusterer.getClusterCount(); c != eposc; c++)
   {
-    if (itemList != SC_NULL)
-      idx = (*itemList).getUInt(i);
-    else
-      idx = i;
+    shapeGuard.reset(new scDataNode(ict_array, vt_uint));
+    clusterItems = clusterer.getClusterItems(c);
 
-    shapeName = toString(clusterOutput.getUInt(i));
-    if (!shapeList.hasChild(shapeName)) {
-      shapeList.addChild(shapeName, new scDataNode());
-      objValue = input[idx].getFitness(shapeObjIdx);
-      shapeListForDistrib.addChild(shapeName, new scDataNode(objValue));
+    for(uint j=0, eposj = clusterer.getClusterSize(c); j != eposj; j++)
+    {
+      if (itemList != SC_NULL)
+        idx = itemList[clusterItems[j]];
+      else
+        idx = clusterItems[j];
+      shapeGuard->addItem(idx);
     }
-
-    shapeList[shapeName].addItem(scDataNode(idx));      
+    
+    shapeList.addChild(shapeGuard.release());
+    shapeListForDistrib.addItemAsDouble(clusterer.getCentroid(c));
   }  
 
   prepareShapeDistrib(shapeListForDistrib, decFactor, shapeDistrib);
 }
 
-void sgpGaOperatorSelectTourProb::prepareIslands(const sgpGaGeneration &input, uint totalSize, scDataNode &islandItems, scDataNode &islandData)
+// whole population (islands = NULL) and each island keep own clusterer 
+// so Lloyd's algorithm can start from centers of previous step
+sgpShapeClusterer &sgpGaOperatorSelectTourProb::getShapeClusterer(const sgpIslandPartition *islands, uint islandId)
 {
-  prepareIslands(input, 0, 0, totalSize, islandItems, islandData);
+  if (islands == SC_NULL)
+    return m_shapeClusterer;
+
+  if (islandId >= m_islandShapeClusterers.size())
+    m_islandShapeClusterers.resize(islandId + 1);
+
+  return m_islandShapeClusterers[islandId];
 }
 
-void sgpGaOperatorSelectTourProb::prepareIslands(const sgpGaGeneration &input, uint beginIslandNo, uint endIslandNo, 
-  uint totalSize, scDataNode &islandItems, scDataNode &islandData)
+void sgpGaOperatorSelectTourProb::prepareIslands(const sgpGaGeneration &input, uint totalSize, 
+  sgpIslandPartition &islands, sgpTourIslandDataList &islandData)
 {
-  prepareIslandMap(input, beginIslandNo, endIslandNo, islandItems);
-  prepareIslandData(input, islandItems, islandData);
-  normalizeIslandSize(totalSize, islandItems, islandData);
+  prepareIslands(input, 0, 0, totalSize, islands, islandData);
 }
 
-void sgpGaOperatorSelectTourProb::prepareIslandMap(const sgpGaGeneration &input, 
-  uint beginIslandNo, uint endIslandNo, 
-  scDataNode &islandItems)
+// islands from range [beginIslandNo, endIslandNo) are prepared, all if range is empty
+void sgpGaOperatorSelectTourProb::prepareIslands(const sgpGaGeneration &input, uint beginIslandNo, uint endIslandNo, 
+  uint totalSize, sgpIslandPartition &islands, sgpTourIslandDataList &islandData)
 {
-  if (beginIslandNo != endIslandNo)
-  {
-    // island range
-    scDataNode bufferMap;
-    std::auto_ptr<scDataNode> newIsland;
-    uint islandId;
-
-    m_islandTool->prepareIslandMap(input, bufferMap);
-    islandItems.clear();
-    islandItems.setAsParent();
+  prepareIslandPartition(input, islands);
+  prepareIslandData(input, beginIslandNo, endIslandNo, islands, islandData);
+  normalizeIslandSize(totalSize, islands, islandData);
+}
 
-    for(uint i=0, epos = bufferMap.size(); i != epos; i++)
-    {
-      islandId = stringToUInt(bufferMap.getElementName(i));
-      if ((islandId >= beginIslandNo) && (islandId < endIslandNo))
-      {
-        newIsland.reset(new scDataNode());
-        *newIsland = bufferMap[i];
-        islandItems.addChild(toString(islandId), newIsland.release());
-      }        
-    }    
-  } else {
-    // all
-    m_islandTool->prepareIslandMap(input, islandItems);
-  }    
+void sgpGaOperatorSelectTourProb::prepareIslandPartition(const sgpGaGeneration &input, sgpIslandPartition &islands)
+{
+  m_islandTool->prepareIslandPartition(input, islands);
 }
 
-void sgpGaOperatorSelectTourProb::prepareIslandData(const sgpGaGeneration &input, scDataNode &islandItems, scDataNode &islandData)
+void sgpGaOperatorSelectTourProb::prepareIslandData(const sgpGaGeneration &input, uint beginIslandNo, uint endIslandNo, 
+  const sgpIslandPartition &islands, sgpTourIslandDataList &islandData)
 {
-  dnode shapeCollection, shapeDistrib;
-  
-  uint islandId; 
   double decFactor = TOUR_PROB_SHAPE_DISTRIB_DECREASE_FACTOR;
   double sizeFactor = 1.0;
-  double shapeDistribSum;
   double param;
-  std::auto_ptr<scDataNode> islandDataGuard; 
+  uint islandCount = islands.getIslandCount();
+
+  if (beginIslandNo == endIslandNo) {
+    beginIslandNo = 0;
+    endIslandNo = islandCount;
+  } else {
+    endIslandNo = SC_MIN(endIslandNo, islandCount);
+  }
 
-  for(uint i=0, epos = islandItems.size(); i != epos; i++)
+  islandData.clear();
+  islandData.resize(islandCount);
+
+  for(uint islandId = beginIslandNo; islandId < endIslandNo; islandId++)
   {
-    islandId = stringToUIntDef(islandItems.getElementName(i), 0);
-    
+    if (islands.isIslandEmpty(islandId))
+      continue;
+
     if (m_experimentParams != SC_NULL)
     {
       if (m_experimentParams->getDouble(islandId, SGP_EXP_PAR_BLOCK_IDX_TOUR + SGP_TOUR_PROB_EP_DISTRIB_DEC_RATIO, param))
@@ -462,70 +576,61 @@ void sgpGaOperatorSelectTourProb::prepareIslandData(const sgpGaGeneration &input
         sizeFactor = 1.0;
     }
 
-    if (islandItems[i].empty())
-      sizeFactor = 0.0;
-      
+    sgpTourIslandData &data = islandData[islandId];
+
     if (getShapeLimit() > 0)
-      prepareShapeCollectionByCluster(input, &(islandItems[i]), islandId, shapeCollection, shapeDistrib, decFactor);  
+      prepareShapeCollectionByCluster(input, &islands, islandId, data.shapeCollection, data.shapeDistrib, decFactor);  
     else
-      prepareShapeCollectionByObjDistrib(input, &(islandItems[i]), islandId, shapeCollection, shapeDistrib, decFactor);  
+      prepareShapeCollectionByObjDistrib(input, &islands, islandId, data.shapeCollection, data.shapeDistrib, decFactor);  
 
-    shapeDistribSum = shapeDistrib.accumulate(0.0);
-
-    islandDataGuard.reset(new dnode());
-
-    // sorted in ISLAND_DATA_IDX_X order
-    islandDataGuard->addChild(new dnode(base::move(shapeCollection)));
-    islandDataGuard->addChild(new dnode(base::move(shapeDistrib)));
-    islandDataGuard->addChild(new dnode(sizeFactor));
-    islandDataGuard->addChild(new dnode(shapeDistribSum));
-
-    assert(islandDataGuard->size() - 1 == ISLAND_DATA_IDX_SHAPE_DISTRIB_SUM);
-    
-    islandData.addChild(islandItems.getElementName(i), islandDataGuard.release());
+    prepareShapeSampler(data.shapeDistrib, data.shapeSampler);
+    data.sizeFactor = sizeFactor;
+    data.active = true;
   }
 }
 
-void sgpGaOperatorSelectTourProb::normalizeIslandSize(uint totalSize, const scDataNode &islandItems, scDataNode &islandData)
+// split selection quota between active islands using size factors, 
+// last island receives rounding leftovers
+void sgpGaOperatorSelectTourProb::normalizeIslandSize(uint totalSize, const sgpIslandPartition &islands, 
+  sgpTourIslandDataList &islandData)
 {
-  // normalize size  
-  uint itemsLeft, islandSize;
-  itemsLeft = totalSize;
+  uint itemsLeft = totalSize;
+  uint lastActive = islandData.size();
   double sizeSum = 0.0;
   
   for(uint i=0, epos = islandData.size(); i != epos; i++)
   {
-    if (!islandItems[islandData.getElementName(i)].empty()) 
-      sizeSum += islandData[i].getDouble(ISLAND_DATA_IDX_SIZE);
+    if (islandData[i].active) {
+      sizeSum += islandData[i].sizeFactor;
+      lastActive = i;
+    }
   }
     
+  uint islandSize;
+
   for(uint i=0, epos = islandData.size(); i != epos; i++)
   {
-    if (i == epos - 1) {
-      if (islandItems[islandData.getElementName(i)].empty()) {
-      // find which one can be bigger
-        for(uint j=0, eposj = epos - 1; j != eposj; j++)
-          if (islandData[j].getUInt(ISLAND_DATA_IDX_SIZE) > 0) {
-            islandData[j].setUInt(ISLAND_DATA_IDX_SIZE, islandData[j].getUInt(ISLAND_DATA_IDX_SIZE) + itemsLeft);
-            break;
-          }
-        islandSize = 0;         
-      } else {      
-        islandSize = itemsLeft;
-      }  
-    } else { 
-      islandSize = round<uint>((islandData[i].getDouble(ISLAND_DATA_IDX_SIZE) / sizeSum) * static_cast<double>(totalSize));
+    if (!islandData[i].active)
+      continue;
+
+    if (i == lastActive) {
+      islandSize = itemsLeft;
+    } else if (sizeSum > 0.0) { 
+      islandSize = round<uint>((islandData[i].sizeFactor / sizeSum) * static_cast<double>(totalSize));
       islandSize = std::min<uint>(islandSize, itemsLeft);
-      itemsLeft -= islandSize;
+    } else {
+      islandSize = 0;
     }  
-    islandData[i][ISLAND_DATA_IDX_SIZE].setAsUInt(islandSize); 
+
+    itemsLeft -= islandSize;
+    islandData[i].quota = islandSize; 
   }
 }
 
 // generate tournament group using "equal oportunities" algorithm
 // shapeCollection is list of groups of entities, each group contains a list of entity indexes in population
 void sgpGaOperatorSelectTourProb::genRandomGroupByShape(sgpTournamentGroup &output, const sgpGaGeneration &input, uint limit, 
-  const scDataNode &shapeCollection, const scDataNode &shapeDistrib, double shapeDistribSum)
+  const scDataNode &shapeCollection, const sgpAliasSampler &shapeSampler, sgpRandomSource &random)
 {
   output.clear();
   if (shapeCollection.empty())
@@ -533,66 +638,58 @@ void sgpGaOperatorSelectTourProb::genRandomGroupByShape(sgpTournamentGroup &outp
 
   uint shapeIndex, shapeIndex2, entityIndex;
   uint addedCnt = 0;
-  bool useDistrib = !shapeDistrib.empty();
   bool oneLevel = true;
-  std::vector<uint> shapeIndexVector;
-  uint shapeIndexVectorIdx = 0;
+  // zero or invalid distribution: all shapes are equally probable
+  bool useDistrib = !shapeSampler.empty();
   
   while(addedCnt < limit) 
   {
     if (useDistrib) {
-      if (shapeIndexVectorIdx >= shapeIndexVector.size()) {
-        shapeIndexVector.clear();
-        selectProbItem(shapeDistrib, shapeDistribSum, shapeIndexVector, limit - addedCnt);
-        shapeIndexVectorIdx = 0;
-      } 
-      assert(!shapeIndexVector.empty());
-      shapeIndex = shapeIndexVector[shapeIndexVectorIdx];
-      shapeIndexVectorIdx++;
+      shapeIndex = shapeSampler.sample(random);
     } else {
-      shapeIndex = randomUInt(0, shapeCollection.size() - 1);
+      shapeIndex = random.randomUInt(0, shapeCollection.size() - 1);
     }
         
     assert(!shapeCollection[shapeIndex].empty());
-    entityIndex = randomUInt(0, shapeCollection[shapeIndex].size() - 1);
+    entityIndex = random.randomUInt(0, shapeCollection[shapeIndex].size() - 1);
     if (oneLevel)
     {
       entityIndex = shapeCollection[shapeIndex].getUInt(entityIndex);
     } else {
       shapeIndex2 = entityIndex;
-      entityIndex = randomUInt(0, shapeCollection[shapeIndex][shapeIndex2].size() - 1);
+      entityIndex = random.randomUInt(0, shapeCollection[shapeIndex][shapeIndex2].size() - 1);
       entityIndex = shapeCollection[shapeIndex][shapeIndex2].getUInt(entityIndex);    
     }  
-    if (output.find(entityIndex) == output.end())
-    {
-      output.insert(entityIndex);
+    if (output.insert(entityIndex))
       addedCnt++;
-    }  
   }    
 }  
 
 // select random island and items from it
 void sgpGaOperatorSelectTourProb::genRandomGroupAndIsland(sgpTournamentGroup &output, const sgpGaGeneration &input, uint limit, 
-  const scDataNode &islandItems, const scDataNode &islandData, uint &islandId, scDataNode &newItems)
+  const sgpIslandPartition &islands, const sgpTourIslandDataList &islandData, uint &islandId, 
+  const std::vector<uint> &islandAllocs)
 {
   uint islandIdx, islandSize;
   uint useLimit = limit;
   uint islandSpaceLeft;
   int islandLimit;
-  scString islandName;
+  uint islandCount = islandData.size();
 
-  islandId = islandItems.size();
+  islandId = islandCount;
   
   output.clear();
-  if (!islandItems.empty()) {
+  if (islands.getItemCount() > 0) {
     do {
-      islandIdx = randomUInt(0, islandItems.size() - 1);
-      islandName = islandItems.getElementName(islandIdx);
-      islandSize = islandItems[islandName].size();
-      islandSpaceLeft = islandData[islandName].getUInt(ISLAND_DATA_IDX_SIZE);
+      islandIdx = randomUInt(0, islandCount - 1);
+      if (!islandData[islandIdx].active)
+        continue;
+
+      islandSize = islands.getIslandSize(islandIdx);
+      islandSpaceLeft = islandData[islandIdx].quota;
       
-      if (newItems.hasChild(islandName))   
-        islandSpaceLeft = islandSpaceLeft - newItems.getUInt(islandName);   
+      if (islandIdx < islandAllocs.size())   
+        islandSpaceLeft = islandSpaceLeft - SC_MIN(islandAllocs[islandIdx], islandSpaceLeft);   
       if ((islandSize > 0) && (islandSpaceLeft > 0)) {
         if (m_experimentParams != SC_NULL)
           if (m_experimentParams->getInt(islandIdx, SGP_EXP_PAR_BLOCK_IDX_TOUR + SGP_TOUR_PROB_EP_TOUR_SIZE, islandLimit))
@@ -601,8 +698,8 @@ void sgpGaOperatorSelectTourProb::genRandomGroupAndIsland(sgpTournamentGroup &ou
         useLimit = std::min<uint>(useLimit, islandSpaceLeft);
         if (useLimit > 0) 
         {
-          islandId = stringToIntDef(islandName, 0);
-          genRandomGroup(output, input, useLimit, islandId, islandItems, islandData);
+          islandId = islandIdx;
+          genRandomGroup(output, input, useLimit, islandId, islands, islandData[islandId], sgpGlobalRandomSource::instance());
           assert(!output.empty());  
           break;
         }  
@@ -614,7 +711,7 @@ void sgpGaOperatorSelectTourProb::genRandomGroupAndIsland(sgpTournamentGroup &ou
 // select random items from a given island
 void sgpGaOperatorSelectTourProb::genRandomGroupFromIsland(sgpTournamentGroup &output, const sgpGaGeneration &input, 
   uint groupLimit, uint targetLimit, uint allocatedCount,
-  uint islandId, const scDataNode &islandItems, const scDataNode &islandData)
+  uint islandId, const sgpIslandPartition &islands, const sgpTourIslandData &islandData, sgpRandomSource &random)
 {
   uint useLimit;
   uint islandSpaceLeft;
@@ -633,38 +730,36 @@ void sgpGaOperatorSelectTourProb::genRandomGroupFromIsland(sgpTournamentGroup &o
     
     if (useLimit > 0) 
     {
-      genRandomGroup(output, input, useLimit, islandId, islandItems, islandData);
+      genRandomGroup(output, input, useLimit, islandId, islands, islandData, random);
       assert(!output.empty());  
     }  
   }  
 }
 
 void sgpGaOperatorSelectTourProb::genRandomGroup(sgpTournamentGroup &output, const sgpGaGeneration &input, 
-  uint limit, uint islandId, const scDataNode &islandItems, const scDataNode &islandData)
+  uint limit, uint islandId, const sgpIslandPartition &islands, const sgpTourIslandData &islandData, sgpRandomSource &random)
 {
-  if (selectTourGroupSelTypeByShape(islandId))
+  if (selectTourGroupSelTypeByShape(islandId, random))
     genRandomGroupByShape(output, input, limit, 
-      islandData[ISLAND_DATA_IDX_SHAPE_COLN], 
-      islandData[ISLAND_DATA_IDX_SHAPE_DISTRIB], 
-      islandData[ISLAND_DATA_IDX_SHAPE_DISTRIB_SUM].getAsDouble()
+      islandData.shapeCollection, 
+      islandData.shapeSampler, 
+      random
     );
   else  
-    genRandomGroupOnIsland(output, input, islandItems, limit);
+    genRandomGroupOnIsland(output, input, islands, islandId, limit, random);
 }
 
 void sgpGaOperatorSelectTourProb::genRandomGroupOnIsland(sgpTournamentGroup &output, const sgpGaGeneration &input, 
-  const scDataNode &islandItems, uint limit)
+  const sgpIslandPartition &islands, uint islandId, uint limit, sgpRandomSource &random)
 {
-  genRandomGroupFromBlockByIds(output, input, islandItems, limit);
+  genRandomGroupFromBlockByIds(output, input, islands.getIslandItems(islandId), islands.getIslandSize(islandId), limit, random);
 }
 
-void sgpGaOperatorSelectTourProb::updateIslandAllocs(uint islandId, uint groupSize, scDataNode &newItems)
+void sgpGaOperatorSelectTourProb::updateIslandAllocs(uint islandId, uint groupSize, std::vector<uint> &islandAllocs)
 {
-  scString islandName(toString(islandId));
-  if (!newItems.hasChild(islandName))
-    newItems.addChild(islandName, new scDataNode(groupSize));
-  else  
-    newItems.setUInt(islandName, newItems.getUInt(islandName) + groupSize);
+  if (islandId >= islandAllocs.size())
+    islandAllocs.resize(islandId + 1, 0);
+  islandAllocs[islandId] += groupSize;
 }
 
 void sgpGaOperatorSelectTourProb::genRandomGroupFromBlock(sgpTournamentGroup &output, const sgpGaGeneration &input, uint limit)
@@ -676,19 +771,18 @@ void sgpGaOperatorSelectTourProb::genRandomGroupFromBlock(sgpTournamentGroup &ou
 }
 
 void sgpGaOperatorSelectTourProb::genRandomGroupFromBlockByIds(sgpTournamentGroup &output, const sgpGaGeneration &input, 
-  const scDataNode &idList, uint limit)
+  const uint *idList, uint blockSize, uint limit, sgpRandomSource &random)
 {
   uint itemIdx, cnt;
-  uint blockSize = idList.size();
   
   output.clear();
   cnt = 0;
   
-  if (!idList.empty())
+  if (blockSize > 0)
   while(cnt < limit) 
   {
-    itemIdx = randomUInt(0, blockSize - 1);
-    itemIdx = idList.getUInt(itemIdx);
+    itemIdx = random.randomUInt(0, blockSize - 1);
+    itemIdx = idList[itemIdx];
     output.insert(itemIdx);
     cnt++;
   }  
@@ -741,7 +835,7 @@ bool sgpGaOperatorSelectTourProb::getStaticTourProbForIsland(uint islandId, doub
 
 // returns <true> if group contents selection should be based on shape
 // default: <true>
-bool sgpGaOperatorSelectTourProb::selectTourGroupSelTypeByShape(uint islandId)
+bool sgpGaOperatorSelectTourProb::selectTourGroupSelTypeByShape(uint islandId, sgpRandomSource &random)
 {
   const double MARGIN_VALUE = 0.1;
   bool res = true;
@@ -758,7 +852,7 @@ bool sgpGaOperatorSelectTourProb::selectTourGroupSelTypeByShape(uint islandId)
         res = true;
       else {
         probValue = (probValue - MARGIN_VALUE) / (1.0 - 2.0 * MARGIN_VALUE);
-        res = randomFlip(probValue);
+        res = random.randomFlip(probValue);
       }          
     }  
   
@@ -767,37 +861,45 @@ bool sgpGaOperatorSelectTourProb::selectTourGroupSelTypeByShape(uint islandId)
 
 void sgpGaOperatorSelectTourProb::execute(sgpGaGeneration &input, sgpGaGeneration &output, uint limit)
 {
+  ulong64 limitHitCount = m_matchStats.limitHitCount;
+
+  prepareMatchWeights();
+
   if (m_islandLimit > 0) 
     executeOnIslandList(input, output, limit, 0, m_islandLimit - 1);
+  else if (isParallelEnabled()) 
+    executeOnAllPar(input, output, limit);
   else 
     executeOnAll(input, output, limit);
+
+  if (m_matchStats.limitHitCount != limitHitCount)
+    perf::Log::addText("Tournament match too long", lmlWarning, "OSTP01");
 }
 
 void sgpGaOperatorSelectTourProb::executeOnIslandList(sgpGaGeneration &input, sgpGaGeneration &output, uint limit, uint firstIslandId, uint lastIslandId)
 {
-  scDataNode islandItems;
-  scDataNode islandData;
+  sgpIslandPartition islands;
+  sgpTourIslandDataList islandData;
 
-  prepareIslands(input, firstIslandId, lastIslandId + 1, limit, islandItems, islandData);
-  scString islandName;
-  uint islandLimit;
-  
-  for(uint i=firstIslandId, epos = lastIslandId + 1; i != epos; i++)
+  prepareIslands(input, firstIslandId, lastIslandId + 1, limit, islands, islandData);
+
+  if (isParallelEnabled()) {
+    executeOnIslandListPar(input, output, firstIslandId, lastIslandId, islands, islandData);
+    return;
+  }
+
+  for(uint i=firstIslandId, epos = SC_MIN(lastIslandId + 1, islandData.size()); i < epos; i++)
   {
-    islandName = toString(i);
-    if (islandItems.hasChild(islandName) && islandData.hasChild(islandName))
-    {
-      islandLimit = islandData[islandName].getUInt(ISLAND_DATA_IDX_SIZE);
-      executeOnIsland(input, output, islandLimit, i, islandItems[islandName], islandData[islandName]);
-    }  
+    if (islandData[i].active)
+      executeOnIsland(input, output, islandData[i].quota, i, islands, islandData[i]);
   }    
 }
 
 void sgpGaOperatorSelectTourProb::executeOnIsland(sgpGaGeneration &input, sgpGaGeneration &output, uint limit, uint islandId, 
-  const scDataNode &islandItems, scDataNode &islandData)
+  const sgpIslandPartition &islands, const sgpTourIslandData &islandData)
 {
   sgpTournamentGroup group, workGroup;
-  uint tourSize = std::min<uint>(input.size(), m_tournamentSize);
+  uint tourSize;
   uint addedSize;
 
 #if defined(TRACE_MATCH_PROB) 
@@ -820,40 +922,15 @@ void sgpGaOperatorSelectTourProb::executeOnIsland(sgpGaGeneration &input, sgpGaG
 
   uint islandLimit = limit;  
   
-  if (m_experimentParams != SC_NULL)
-  {
-    int tourSizeOnIsland;
-    if (m_experimentParams->getInt(islandId, SGP_EXP_PAR_BLOCK_IDX_TOUR + SGP_TOUR_PROB_EP_TOUR_SIZE, tourSizeOnIsland))
-      tourSize = static_cast<uint>(tourSizeOnIsland);    
-  }    
-  
-  tourSize = SC_MIN(tourSize, islandItems.size());
-  
   addedSize = 0;
 
-  bool canProcess = false;
-  if ((tourSize > 0) && canProcessIsland(islandId, islandItems))
-    canProcess = true;
-  
-  if (canProcess) {
-    dynamicTourType = getStaticTourProbForIsland(islandId, staticTourProb);
-  } else {
-    // just for warnings
-    dynamicTourType = false;
-    staticTourProb = 0.0;
-  }
+  bool canProcess = prepareIslandTour(input, islandId, islands, tourSize, dynamicTourType, staticTourProb);
 
   if (canProcess)
   while(addedSize < islandLimit)
   { 
-    genRandomGroupFromIsland(group, input, tourSize, islandLimit, addedSize, islandId, islandItems, islandData);
-
-    if (dynamicTourType && randomFlip(staticTourProb)) {
-      workGroup.clear();
-      workGroup.insert(sgpGaOperatorSelectTournamentMF::findBestInGroup(input, group, m_objectiveWeights));
-    } else {
-      runMatchInGroupOnIsland(workGroup, input, group, islandId);
-    }  
+    runIslandTournament(group, workGroup, input, tourSize, islandLimit, addedSize, 
+      islandId, islands, islandData, dynamicTourType, staticTourProb, sgpGlobalRandomSource::instance(), m_matchStats);
     
 #ifdef TRACE_MATCH_PROB
   Counter::inc("gx-tour-group-no");
@@ -887,9 +964,192 @@ void sgpGaOperatorSelectTourProb::executeOnIsland(sgpGaGeneration &input, sgpGaG
 #endif  
 }
 
-bool sgpGaOperatorSelectTourProb::canProcessIsland(uint islandId, const scDataNode &islandItems)
+bool sgpGaOperatorSelectTourProb::prepareIslandTour(const sgpGaGeneration &input, uint islandId, const sgpIslandPartition &islands, 
+  uint &tourSize, bool &dynamicTourType, double &staticTourProb)
 {
-  return (!islandItems.empty());
+  tourSize = std::min<uint>(input.size(), m_tournamentSize);
+
+  if (m_experimentParams != SC_NULL)
+  {
+    int tourSizeOnIsland;
+    if (m_experimentParams->getInt(islandId, SGP_EXP_PAR_BLOCK_IDX_TOUR + SGP_TOUR_PROB_EP_TOUR_SIZE, tourSizeOnIsland))
+      tourSize = static_cast<uint>(tourSizeOnIsland);    
+  }    
+  
+  tourSize = SC_MIN(tourSize, islands.getIslandSize(islandId));
+
+  bool canProcess = false;
+  if ((tourSize > 0) && canProcessIsland(islandId, islands))
+    canProcess = true;
+  
+  if (canProcess) {
+    dynamicTourType = getStaticTourProbForIsland(islandId, staticTourProb);
+  } else {
+    // just for warnings
+    dynamicTourType = false;
+    staticTourProb = 0.0;
+  }
+
+  return canProcess;
+}
+
+void sgpGaOperatorSelectTourProb::runIslandTournament(sgpTournamentGroup &group, sgpTournamentGroup &workGroup, 
+  const sgpGaGeneration &input, uint tourSize, uint targetLimit, uint allocatedCount, 
+  uint islandId, const sgpIslandPartition &islands, const sgpTourIslandData &islandData,
+  bool dynamicTourType, double staticTourProb, sgpRandomSource &random, sgpTourMatchStats &stats)
+{
+  genRandomGroupFromIsland(group, input, tourSize, targetLimit, allocatedCount, islandId, islands, islandData, random);
+
+  if (dynamicTourType && random.randomFlip(staticTourProb)) {
+    workGroup.clear();
+    workGroup.insert(sgpGaOperatorSelectTournamentMF::findBestInGroup(input, group, m_objectiveWeights));
+  } else {
+    runMatchInGroupOnIsland(workGroup, input, group, islandId, random, stats);
+  }  
+}
+
+bool sgpGaOperatorSelectTourProb::isParallelEnabled() const
+{
+#if defined(TRACE_MATCH_PROB) || defined(TRACE_ENTITY_BIO)
+  // tracing uses global counters and entity tracer state
+  return false;
+#else
+  return m_parallel;
+#endif
+}
+
+void sgpGaOperatorSelectTourProb::executeOnAllPar(sgpGaGeneration &input, sgpGaGeneration &output, uint limit)
+{
+  if ((input.size() == 0) || (limit == 0))
+    return;
+
+  // whole population is handled as a single island
+  sgpTourIslandData shapeData;
+
+  if (getShapeLimit() > 0)
+    prepareShapeCollectionByCluster(input, shapeData.shapeCollection);  
+  else 
+    prepareShapeCollectionByObjDistrib(input, SC_NULL, 0, shapeData.shapeCollection, shapeData.shapeDistrib, 
+      TOUR_PROB_SHAPE_DISTRIB_DECREASE_FACTOR);  
+
+  prepareShapeSampler(shapeData.shapeDistrib, shapeData.shapeSampler);
+  shapeData.active = true;
+
+  sgpTourProbParBlock blockTemplate;
+  blockTemplate.islandId = 0;
+  blockTemplate.islands = SC_NULL;
+  blockTemplate.islandData = &shapeData;
+  blockTemplate.tourSize = std::min<uint>(input.size(), m_tournamentSize);
+  blockTemplate.dynamicTourType = false;
+  blockTemplate.staticTourProb = 0.0;
+  blockTemplate.quota = 0;
+
+  m_parBlocks.clear();
+  addParBlocks(limit, blockTemplate);
+  executeParBlocks(input, output);
+}
+
+void sgpGaOperatorSelectTourProb::executeOnIslandListPar(sgpGaGeneration &input, sgpGaGeneration &output, 
+  uint firstIslandId, uint lastIslandId, const sgpIslandPartition &islands, const sgpTourIslandDataList &islandData)
+{
+  sgpTourProbParBlock blockTemplate;
+
+  m_parBlocks.clear();
+
+  for(uint i=firstIslandId, epos = SC_MIN(lastIslandId + 1, islandData.size()); i < epos; i++)
+  {
+    if (islandData[i].active)
+    {
+      blockTemplate.islandId = i;
+      blockTemplate.islands = &islands;
+      blockTemplate.islandData = &(islandData[i]);
+      blockTemplate.quota = 0;
+
+      if (prepareIslandTour(input, i, islands, 
+          blockTemplate.tourSize, blockTemplate.dynamicTourType, blockTemplate.staticTourProb))
+        addParBlocks(islandData[i].quota, blockTemplate);
+    }  
+  }    
+
+  executeParBlocks(input, output);
+}
+
+// split quota into blocks of TOUR_PAR_BLOCK_SIZE items
+void sgpGaOperatorSelectTourProb::addParBlocks(uint limit, const sgpTourProbParBlock &blockTemplate)
+{
+  for(uint addedSize = 0; addedSize < limit; addedSize += TOUR_PAR_BLOCK_SIZE)
+  {
+    m_parBlocks.push_back(blockTemplate);
+    m_parBlocks.back().quota = SC_MIN(TOUR_PAR_BLOCK_SIZE, limit - addedSize);
+  }
+}
+
+// run all blocks concurrently, then copy selected items in block order
+void sgpGaOperatorSelectTourProb::executeParBlocks(sgpGaGeneration &input, sgpGaGeneration &output)
+{
+  if (m_parBlocks.empty())
+    return;
+
+  ulong64 seed = (m_randomSeed != 0) ? m_randomSeed : sgpRandomStream::newSeed();
+
+  // match weights read island ids from worker threads
+  if (m_experimentParams != SC_NULL)
+    prepareIslandIdCache(input);
+
+  sgpTourProbParTask task(this, input, m_parBlocks, seed, m_stepNo++);
+  m_scheduler.execute(m_parBlocks.size(), task);
+
+  for(sgpTourProbParBlockList::const_iterator it = m_parBlocks.begin(), epos = m_parBlocks.end(); it != epos; ++it)
+  {
+    for(uint i = 0, eposi = it->selected.size(); i != eposi; i++)
+      output.insert(input.cloneItem(it->selected[i]));
+    m_matchStats.add(it->stats);
+  }
+}
+
+// island id cache is filled on first query, do it before tasks start
+void sgpGaOperatorSelectTourProb::prepareIslandIdCache(const sgpGaGeneration &input)
+{
+  uint islandId;
+  for(uint i = input.beginPos(), epos = input.endPos(); i != epos; i++)
+    m_islandTool->getIslandId(*input.atPtr(i), islandId);
+}
+
+void sgpGaOperatorSelectTourProb::selectBlockPar(const sgpGaGeneration &input, sgpTourProbParBlock &block, sgpRandomSource &random)
+{
+  sgpTournamentGroup group, workGroup;
+  uint addedSize = 0;
+
+  block.selected.clear();
+  block.selected.reserve(block.quota);
+  block.stats.clear();
+
+  while(addedSize < block.quota)
+  { 
+    if (block.islands != SC_NULL) {
+      runIslandTournament(group, workGroup, input, block.tourSize, block.quota, addedSize, 
+        block.islandId, *block.islands, *block.islandData, block.dynamicTourType, block.staticTourProb, random, 
+        block.stats);
+    } else {
+      genRandomGroupByShape(group, input, block.tourSize, 
+        block.islandData->shapeCollection, 
+        block.islandData->shapeSampler, 
+        random);
+      runMatchInGroup(workGroup, input, group, random, block.stats);
+    }
+
+    for(sgpTournamentGroup::const_iterator it = workGroup.begin(), epos = workGroup.end(); it != epos; ++it) {
+      if (addedSize < block.quota) {
+        block.selected.push_back(*it);
+        addedSize++;
+      }  
+    }  
+  }
+}
+
+bool sgpGaOperatorSelectTourProb::canProcessIsland(uint islandId, const sgpIslandPartition &islands)
+{
+  return !islands.isIslandEmpty(islandId);
 }
 
 void sgpGaOperatorSelectTourProb::executeOnAll(sgpGaGeneration &input, sgpGaGeneration &output, uint limit)
@@ -919,12 +1179,13 @@ void sgpGaOperatorSelectTourProb::executeOnAll(sgpGaGeneration &input, sgpGaGene
   Timer::start(TIMER_SHAPE_DETECT);    
 #endif  
   scDataNode shapeCollection;  
-  scDataNode islandItems, newIslandItems;
-  scDataNode islandData;
+  sgpIslandPartition islands;
+  sgpTourIslandDataList islandData;
+  std::vector<uint> islandAllocs;
   uint islandId;
   
   if (m_islandLimit > 0) 
-    prepareIslands(input, input.size(), islandItems, islandData);
+    prepareIslands(input, input.size(), islands, islandData);
   else if (getShapeLimit() > 0)
     prepareShapeCollectionByCluster(input, shapeCollection);  
   else 
@@ -933,7 +1194,8 @@ void sgpGaOperatorSelectTourProb::executeOnAll(sgpGaGeneration &input, sgpGaGene
   Timer::stop(TIMER_SHAPE_DETECT);    
 #endif  
 
-  double shapeDistribSum = shapeDistrib.accumulate(0.0);
+  sgpAliasSampler shapeSampler;
+  prepareShapeSampler(shapeDistrib, shapeSampler);
   double staticTourProb;  
   bool dynamicTourType;
   
@@ -941,19 +1203,19 @@ void sgpGaOperatorSelectTourProb::executeOnAll(sgpGaGeneration &input, sgpGaGene
   { 
     // generate random group of selected size
     if (m_islandLimit > 0) {
-      genRandomGroupAndIsland(group, input, tourSize, islandItems, islandData, islandId, newIslandItems);
+      genRandomGroupAndIsland(group, input, tourSize, islands, islandData, islandId, islandAllocs);
       dynamicTourType = getStaticTourProbForIsland(islandId, staticTourProb);
 
       if (dynamicTourType && randomFlip(staticTourProb)) {
         workGroup.clear();
         workGroup.insert(sgpGaOperatorSelectTournamentMF::findBestInGroup(input, group, m_objectiveWeights));
       } else {
-        runMatchInGroupOnIsland(workGroup, input, group, islandId);
+        runMatchInGroupOnIsland(workGroup, input, group, islandId, sgpGlobalRandomSource::instance(), m_matchStats);
       }  
-      updateIslandAllocs(islandId, workGroup.size(), newIslandItems);
+      updateIslandAllocs(islandId, workGroup.size(), islandAllocs);
     } else { 
-      genRandomGroupByShape(group, input, tourSize, shapeCollection, shapeDistrib, shapeDistribSum);
-      runMatchInGroup(workGroup, input, group);
+      genRandomGroupByShape(group, input, tourSize, shapeCollection, shapeSampler, sgpGlobalRandomSource::instance());
+      runMatchInGroup(workGroup, input, group, sgpGlobalRandomSource::instance(), m_matchStats);
     }  
     
 #ifdef TRACE_MATCH_PROB
@@ -1071,13 +1333,15 @@ void sgpGaOperatorSelectTourProb::traceTournamentFailedFor(sgpGaGeneration &inpu
     m_tournamentFailedTracer->execute(input, itemIndex);
 }
 
-void sgpGaOperatorSelectTourProb::runMatchInGroup(sgpTournamentGroup &output, const sgpGaGeneration &input, const sgpTournamentGroup &group)
+void sgpGaOperatorSelectTourProb::runMatchInGroup(sgpTournamentGroup &output, const sgpGaGeneration &input, const sgpTournamentGroup &group,
+  sgpRandomSource &random, sgpTourMatchStats &stats)
 {
-  intRunMatchInGroup(output, input, group, TOUR_PROB_EXTREME_GRAVITY_RATIO, TOUR_USE_PROB_ONLY_FOR_NON_DOMIN, TOUR_MAX_GROUP_SIZE);
+  intRunMatchInGroup(output, input, group, TOUR_PROB_EXTREME_GRAVITY_RATIO, TOUR_USE_PROB_ONLY_FOR_NON_DOMIN, TOUR_MAX_GROUP_SIZE, 
+    random, stats);
 }
 
 void sgpGaOperatorSelectTourProb::runMatchInGroupOnIsland(sgpTournamentGroup &output, const sgpGaGeneration &input, 
-  const sgpTournamentGroup &group, uint islandId)
+  const sgpTournamentGroup &group, uint islandId, sgpRandomSource &random, sgpTourMatchStats &stats)
 {
   double gravity;
   uint groupLimit;
@@ -1099,64 +1363,85 @@ void sgpGaOperatorSelectTourProb::runMatchInGroupOnIsland(sgpTournamentGroup &ou
       groupLimit = static_cast<uint>(groupLimitParam);
     } 
   }
-  intRunMatchInGroup(output, input, group, gravity, TOUR_USE_PROB_ONLY_FOR_NON_DOMIN, groupLimit);
+  intRunMatchInGroup(output, input, group, gravity, TOUR_USE_PROB_ONLY_FOR_NON_DOMIN, groupLimit, random, stats);
 }
 
+// Plays rounds in group until one of:
+// - single winner is found
+// - all matches in round are equal (random winner is selected)
+// - round limit is reached, then winners are reduced randomly to outSizeLimit
+// In each round random pivot plays against all other members, pivot stays 
+// if it did not lose all matches, others stay if they did not lose.
 void sgpGaOperatorSelectTourProb::intRunMatchInGroup(sgpTournamentGroup &output, const sgpGaGeneration &input, const sgpTournamentGroup &group,
-  double gravity, bool probOnlyForNonDomin, uint outSizeLimit)
+  double gravity, bool probOnlyForNonDomin, uint outSizeLimit, sgpRandomSource &random, sgpTourMatchStats &stats)
 {
   uint first;
   sgpTournamentGroup workGroup = group; // group of entities where we are choosing winners
   int matchRes;
-  uint stepCnt = 0;
+  uint roundCnt = 0;
   uint totalCnt, equalCnt;
-  bool onlyDiff = false;
+  uint sizeLimit = SC_MAX(1u, outSizeLimit);
+
+  stats.groupCount++;
 
   do {
+    roundCnt++;
     output.clear();
-    getRandomElement(first, workGroup);
+    getRandomElement(first, workGroup, random);
     if (workGroup.size() == 1) {
       output.insert(first);
       break;
-    } else {  
-      equalCnt = totalCnt = 0;
-      for(sgpTournamentGroup::const_iterator it = workGroup.begin(), epos = workGroup.end(); it != epos; ++it)
-      {
-        if (*it != first) {
-          matchRes = runMatch(input, first, *it, gravity, probOnlyForNonDomin);
-
-          if (matchRes == 0) {
-            equalCnt++;
-          }
-
-          totalCnt++;
-
-          if (matchRes <= 0) {
-            output.insert(*it);
-          }
-              
-          if (matchRes >= 0) {
-            output.insert(first);
-          }
-        } 
+    } 
+
+    equalCnt = totalCnt = 0;
+    for(sgpTournamentGroup::const_iterator it = workGroup.begin(), epos = workGroup.end(); it != epos; ++it)
+    {
+      if (*it != first) {
+        matchRes = runMatch(input, first, *it, gravity, probOnlyForNonDomin, random);
+
+        if (matchRes == 0) {
+          equalCnt++;
+        }
+
+        totalCnt++;
+
+        if (matchRes <= 0) {
+          output.insert(*it);
+        }
+            
+        if (matchRes >= 0) {
+          output.insert(first);
+        }
       } 
-    }
+    } 
 
-    if ((!output.empty()) && (totalCnt == equalCnt))
+    if (totalCnt == equalCnt)
     {
-      getRandomElement(first, output);
+      getRandomElement(first, output, random);
       output.clear();
       output.insert(first);
+      stats.equalShortcutCount++;
       break;
     }
 
-    workGroup = output;
-    stepCnt++;
-  // while output is too big we need to choose inside workGroup
-  } while ((output.size() > outSizeLimit) || (stepCnt < TOUR_LOOP_LIMIT));    
+    if (output.size() == 1)
+      break;
 
-  if (stepCnt >= TOUR_LOOP_LIMIT)
-    perf::Log::addText("Tournament match too long", lmlWarning, "OSTP01");
+    // not converged within round budget - trim to allowed number of winners, 
+    // warning is logged by execute() (kernel runs also on worker threads)
+    if (roundCnt >= m_matchRoundLimit) {
+      while(output.size() > sizeLimit) {
+        getRandomElement(first, output, random);
+        output.erase(first);
+      }
+      stats.limitHitCount++;
+      break;
+    }
+
+    workGroup.swap(output);
+  } while(true);    
+
+  stats.roundCount += roundCnt;
 }
 
 // Run match for two entities.
@@ -1168,13 +1453,12 @@ void sgpGaOperatorSelectTourProb::intRunMatchInGroup(sgpTournamentGroup &output,
 //    0 if both are equal
 // Scaling:
 // 
-int sgpGaOperatorSelectTourProb::runMatch(const sgpGaGeneration &input, uint first, uint second, double gravity, bool useProbOnlyForNonDomin)
+int sgpGaOperatorSelectTourProb::runMatch(const sgpGaGeneration &input, uint first, uint second, double gravity, bool useProbOnlyForNonDomin,
+  sgpRandomSource &random)
 {
   int res = 0;
-  sgpFitnessValue fitVectorFirst, fitVectorSecond;
-
-  input.at(first).getFitness(fitVectorFirst);
-  input.at(second).getFitness(fitVectorSecond);
+  const sgpFitnessValue &fitVectorFirst = input.at(first).getFitnessVector();
+  const sgpFitnessValue &fitVectorSecond = input.at(second).getFitnessVector();
   
   if (useProbOnlyForNonDomin)
   {
@@ -1191,85 +1475,19 @@ int sgpGaOperatorSelectTourProb::runMatch(const sgpGaGeneration &input, uint fir
     }  
   }
 
-  const double C_DIV_HELPER = 0.000001;
-  const double MAX_LR = 100.0;
-  const double MIN_LR = 1.0/MAX_LR;
-  
-  double objA, objB, rr, lr, lk, lrkVal, pt, sumLrk, weightSum;  
-  double objWeight;
+  double pt, sumLrk;  
 
-  
 #ifdef TRACE_MATCH_PROB
   Counter::inc("gx-tour-match-no");
   Counter::inc("gx-tour-match-count");
 #endif
   
-  sumLrk = 0.0;
-  weightSum = 0.0;
-  for(uint i=1,epos=m_objectiveWeightsRescaled.size(); i!=epos; i++)
-  {
-    objA = fitVectorFirst[i];
-    objB = fitVectorSecond[i];
-    // if objectives equal - skip them (improves speed of search)
-    if (objA == objB) 
-      continue;
-      
-    objWeight = getObjectiveWeight(input, first, second, i, m_objectiveWeightsRescaled[i]);
-      
-    // calc rr - how much objA is better than objB  
-    if (objA < 0.0) {
-      rr = (-C_DIV_HELPER + objB) / (-C_DIV_HELPER + objA);
-    } else { 
-      rr = (C_DIV_HELPER + objA) / (C_DIV_HELPER + objB);
-    }  
-    lr = fabs(rr);
-
-    //-------------------
-    if (lr > MAX_LR)
-      lr = MAX_LR;
-    else if (lr < MIN_LR)
-      lr = MIN_LR; 
-        
-    if (lr >= 1.0)
-    // >1.0 => A is better
-      lk = 1.0 - 1.0 / lr;
-    else 
-    // 0..1 => B is better
-      lk = -1.0 + lr;  
-      
-    // calculate relation related to avg(top); lk is (-1,+1)
-    // if any objX is close to avg(top) then lk will be 2x closer to extreme value
-    // otherwise it will stay as-is
-    // this will increase local searches - more pressure for close-to-best solutions
-
-    // here lk is -1..+1
-    if (gravity < 0.0)
-    {
-      lk = lk * (1.0 / pow(2.0, 10.0*((-gravity) - 0.5)));
-    } else {
-      if (lk < 0.0)
-        lk = lk - (lk - (-1.0)) * gravity; //TOUR_PROB_EXTREME_GRAVITY_RATIO;
-      else 
-        lk = lk + (1.0 - lk) * gravity; //TOUR_PROB_EXTREME_GRAVITY_RATIO;  
-    }  
-    lk = SC_MAX(-1.0, lk);  
-    lk = SC_MIN(1.0, lk);  
-          
-    //-------------------
-    lrkVal = (lk + 1.0) / 2.0; 
-    sumLrk += lrkVal * objWeight;
-    weightSum += objWeight;
-  }
-  
-  if (equDouble(weightSum, 0.0))
-    weightSum = 1.0;
-     
-  pt = sumLrk / weightSum;
+  pt = calcMatchProb(input, first, second, gravity, sumLrk);
   
-  if (randomFlip(pt))
+  if (random.randomFlip(pt))
     res++;
     
-  if (randomFlip(1.0 - pt))
+  if (random.randomFlip(1.0 - pt))
     res--;
 
 #ifdef TRACE_MATCH_PROB
@@ -1303,22 +1521,214 @@ int sgpGaOperatorSelectTourProb::runMatch(const sgpGaGeneration &input, uint fir
   return res;
 }
 
+// Adds rating of a single objective (see class description), shared by 
+// kernel and reference code so both round in the same way.
+// gravityFactor is used only for gravity < 0.
+static inline void tourProbAddObjective(double objA, double objB, double objWeight, double gravity, double gravityFactor, 
+  double &sumLrk, double &weightSum)
+{
+  const double C_DIV_HELPER = 0.000001;
+  const double MAX_LR = 100.0;
+  const double MIN_LR = 1.0/MAX_LR;
+
+  double rr, lr, lk, lrkVal;
+
+  // calc rr - how much objA is better than objB  
+  if (objA < 0.0) {
+    rr = (-C_DIV_HELPER + objB) / (-C_DIV_HELPER + objA);
+  } else { 
+    rr = (C_DIV_HELPER + objA) / (C_DIV_HELPER + objB);
+  }  
+  lr = fabs(rr);
+
+  //-------------------
+  if (lr > MAX_LR)
+    lr = MAX_LR;
+  else if (lr < MIN_LR)
+    lr = MIN_LR; 
+      
+  if (lr >= 1.0)
+  // >1.0 => A is better
+    lk = 1.0 - 1.0 / lr;
+  else 
+  // 0..1 => B is better
+    lk = -1.0 + lr;  
+    
+  // calculate relation related to avg(top); lk is (-1,+1)
+  // if any objX is close to avg(top) then lk will be 2x closer to extreme value
+  // otherwise it will stay as-is
+  // this will increase local searches - more pressure for close-to-best solutions
+
+  // here lk is -1..+1
+  if (gravity < 0.0)
+  {
+    lk = lk * gravityFactor;
+  } else {
+    if (lk < 0.0)
+      lk = lk - (lk - (-1.0)) * gravity; //TOUR_PROB_EXTREME_GRAVITY_RATIO;
+    else 
+      lk = lk + (1.0 - lk) * gravity; //TOUR_PROB_EXTREME_GRAVITY_RATIO;  
+  }  
+  lk = SC_MAX(-1.0, lk);  
+  lk = SC_MIN(1.0, lk);  
+        
+  //-------------------
+  lrkVal = (lk + 1.0) / 2.0; 
+  sumLrk += lrkVal * objWeight;
+  weightSum += objWeight;
+}
+
+static inline double tourProbCalcGravityFactor(double gravity)
+{
+  return (1.0 / pow(2.0, 10.0*((-gravity) - 0.5)));
+}
+
+// Match kernel: works on raw fitness rows, weights are resolved once per match 
+// and gravity factor is calculated outside of objective loop.
+static inline double tourProbCalcMatchKernel(const double *fitA, const double *fitB, const double *weights, uint objCnt, 
+  double gravity, double &sumLrk)
+{
+  double weightSum = 0.0;
+  double gravityFactor = 1.0;
+
+  if (gravity < 0.0)
+    gravityFactor = tourProbCalcGravityFactor(gravity);
+
+  sumLrk = 0.0;
+  for(uint i=1; i != objCnt; i++)
+  {
+    if (fitA[i] == fitB[i]) 
+      continue;
+    tourProbAddObjective(fitA[i], fitB[i], weights[i], gravity, gravityFactor, sumLrk, weightSum);
+  }
+  
+  if (equDouble(weightSum, 0.0))
+    weightSum = 1.0;
+     
+  return sumLrk / weightSum;
+}
+
+// Returns probability of winning of first against second 
+double sgpGaOperatorSelectTourProb::calcMatchProb(const sgpGaGeneration &input, uint first, uint second, double gravity, 
+  double &sumLrk)
+{
+  const sgpFitnessValue &fitVectorFirst = input.at(first).getFitnessVector();
+  const sgpFitnessValue &fitVectorSecond = input.at(second).getFitnessVector();
+  uint objCnt = m_objectiveWeightsRescaled.size();
+  const double *weights = getMatchWeights(input, first);
+
+  // single-value fitness is broadcasted by operator[], use reference code for it
+  if ((weights == SC_NULL) || (objCnt < 2) || (fitVectorFirst.size() < 2) || (fitVectorSecond.size() < 2))
+    return calcMatchProbRef(input, first, second, gravity, sumLrk);
+
+  double res = tourProbCalcMatchKernel(fitVectorFirst.getData(), fitVectorSecond.getData(), weights, objCnt, gravity, sumLrk);
+
+  if (m_verifyMatchKernel) {
+    double refSumLrk;
+    double refRes = calcMatchProbRef(input, first, second, gravity, refSumLrk);
+    bool sameRes = (refRes == res) || ((refRes != refRes) && (res != res));
+    if (!sameRes)
+      throw scError("Match kernel result differs from reference: "+toString(res)+" <> "+toString(refRes)+
+        ", items: "+toString(first)+", "+toString(second));
+  }
+
+  return res;
+}
+
+// Reference (per-objective) version of probability calculation
+double sgpGaOperatorSelectTourProb::calcMatchProbRef(const sgpGaGeneration &input, uint first, uint second, double gravity, 
+  double &sumLrk)
+{
+  const sgpFitnessValue &fitVectorFirst = input.at(first).getFitnessVector();
+  const sgpFitnessValue &fitVectorSecond = input.at(second).getFitnessVector();
+
+  double objA, objB, weightSum;  
+  double objWeight;
+
+  sumLrk = 0.0;
+  weightSum = 0.0;
+  for(uint i=1,epos=m_objectiveWeightsRescaled.size(); i!=epos; i++)
+  {
+    objA = fitVectorFirst[i];
+    objB = fitVectorSecond[i];
+    // if objectives equal - skip them (improves speed of search)
+    if (objA == objB) 
+      continue;
+      
+    objWeight = getObjectiveWeight(input, first, second, i, m_objectiveWeightsRescaled[i]);
+    tourProbAddObjective(objA, objB, objWeight, gravity, 
+      (gravity < 0.0) ? tourProbCalcGravityFactor(gravity) : 1.0, sumLrk, weightSum);
+  }
+  
+  if (equDouble(weightSum, 0.0))
+    weightSum = 1.0;
+     
+  return sumLrk / weightSum;
+}
+
 double sgpGaOperatorSelectTourProb::getObjectiveWeight(const sgpGaGeneration &input, uint first, uint second,
   uint objIndex, double defValue)
 {
   double res = defValue;
-  double weight;
   uint islandId;
   
   const sgpEntityBase *firstWorkInfo = dynamic_cast<const sgpEntityBase *>(input.atPtr(first));
   
   if ((m_experimentParams != SC_NULL) && m_islandTool->getIslandId(*firstWorkInfo, islandId))
-    if (m_experimentParams->getDouble(islandId, SGP_EXP_PAR_BLOCK_IDX_TOUR + SGP_TOUR_PROB_EP_DYN_ERROR_OBJS + objIndex, weight))
-      res = weight;        
+    res = getIslandObjectiveWeight(islandId, objIndex, defValue);
               
   return res;
 }
 
+double sgpGaOperatorSelectTourProb::getIslandObjectiveWeight(uint islandId, uint objIndex, double defValue)
+{
+  double weight;
+
+  if (m_experimentParams->getDouble(islandId, SGP_EXP_PAR_BLOCK_IDX_TOUR + SGP_TOUR_PROB_EP_DYN_ERROR_OBJS + objIndex, weight))
+    return weight;        
+  else
+    return defValue;
+}
+
+// weights for islands 0..m_islandLimit-1, other islands use reference code
+void sgpGaOperatorSelectTourProb::prepareMatchWeights()
+{
+  m_islandMatchWeights.clear();
+
+  if (m_experimentParams == SC_NULL)
+    return;
+
+  m_islandMatchWeights.resize(m_islandLimit);
+  for(uint islandId = 0; islandId != m_islandLimit; islandId++)
+  {
+    sgpWeightVector &weights = m_islandMatchWeights[islandId];
+    weights = m_objectiveWeightsRescaled;
+    for(uint i=1,epos=weights.size(); i!=epos; i++)
+      weights[i] = getIslandObjectiveWeight(islandId, i, m_objectiveWeightsRescaled[i]);
+  }
+}
+
+// returns SC_NULL if weights are not prepared for island of entity
+const double *sgpGaOperatorSelectTourProb::getMatchWeights(const sgpGaGeneration &input, uint first)
+{
+  if (m_objectiveWeightsRescaled.empty())
+    return SC_NULL;
+
+  if (m_experimentParams == SC_NULL)
+    return &m_objectiveWeightsRescaled[0];
+
+  uint islandId;
+  const sgpEntityBase *firstWorkInfo = dynamic_cast<const sgpEntityBase *>(input.atPtr(first));
+
+  if (!m_islandTool->getIslandId(*firstWorkInfo, islandId))
+    return &m_objectiveWeightsRescaled[0];
+
+  if (islandId < m_islandMatchWeights.size())
+    return &(m_islandMatchWeights[islandId][0]);
+  else
+    return SC_NULL;
+}
+
 void sgpGaOperatorSelectTourProb::traceMatchProb(ulong64 stepNo, ulong64 groupNo, 
     ulong64 matchNo,
     const sgpFitnessValue &fitVectorFirst, const sgpFitnessValue &fitVectorSecond, 
@@ -0,0 +1,63 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        IslandPartition.cpp
+// Project:     sgpLib
+// Purpose:     Population split into islands, stored as index arrays.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+//sc
+#include "sc/dtypes.h"
+
+//sgp
+#include "sgp/IslandPartition.h"
+
+#ifdef DEBUG_MEM
+#include "sc/DebugMem.h"
+#endif
+
+using namespace dtp;
+
+// ----------------------------------------------------------------------------
+// sgpIslandPartition
+// ----------------------------------------------------------------------------
+sgpIslandPartition::sgpIslandPartition()
+{
+  m_start.push_back(0);
+}
+
+void sgpIslandPartition::build(const uint *islandIds, uint count, uint islandCount, uint firstItem)
+{
+  m_start.assign(islandCount + 1, 0);
+
+  for(uint i = 0; i != count; i++) {
+    assert(islandIds[i] < islandCount);
+    if (islandIds[i] < islandCount)
+      m_start[islandIds[i] + 1]++;
+  }
+
+  for(uint i = 0; i != islandCount; i++)
+    m_start[i + 1] += m_start[i];
+
+  m_fill.assign(m_start.begin(), m_start.end() - 1);
+  m_items.resize(m_start[islandCount]);
+
+  for(uint i = 0; i != count; i++)
+    if (islandIds[i] < islandCount)
+      m_items[m_fill[islandIds[i]]++] = firstItem + i;
+}
+
+void sgpIslandPartition::build(const std::vector<uint> &islandIds, uint islandCount, uint firstItem)
+{
+  if (islandIds.empty())
+    build(SC_NULL, 0, islandCount, firstItem);
+  else
+    build(&islandIds[0], islandIds.size(), islandCount, firstItem);
+}
+
+void sgpIslandPartition::clear()
+{
+  m_start.assign(1, 0);
+  m_items.clear();
+}
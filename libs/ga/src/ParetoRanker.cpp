@@ -0,0 +1,231 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        ParetoRanker.cpp
+// Project:     sgpLib
+// Purpose:     Non-dominated sorting of multi-objective fitness.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+//std
+#include <algorithm>
+#include <limits>
+
+//sgp
+#include "sgp/ParetoRanker.h"
+
+#ifdef DEBUG_MEM
+#include "sc/DebugMem.h"
+#endif
+
+// ----------------------------------------------------------------------------
+// Local classes
+// ----------------------------------------------------------------------------
+// lexicographic order of rows, better values first, then row number
+class sgpParetoLexPred {
+public:
+  sgpParetoLexPred(const sgpFitnessMatrix &fitness, const std::vector<uint> &columns): 
+    m_fitness(fitness), m_columns(columns) {}
+
+  bool operator()(uint left, uint right) const {
+    const double *leftRow = m_fitness.getRow(left);
+    const double *rightRow = m_fitness.getRow(right);
+    uint col;
+
+    for(uint i = 0, epos = m_columns.size(); i != epos; i++) {
+      col = m_columns[i];
+      if (leftRow[col] != rightRow[col])
+        return leftRow[col] > rightRow[col];
+    }
+    return left < right;
+  }
+private:
+  const sgpFitnessMatrix &m_fitness;
+  const std::vector<uint> &m_columns;
+};
+
+// order of rows by value of single column
+class sgpParetoColumnPred {
+public:
+  sgpParetoColumnPred(const sgpFitnessMatrix &fitness, uint column): 
+    m_fitness(fitness), m_column(column) {}
+
+  bool operator()(uint left, uint right) const {
+    return m_fitness.get(left, m_column) < m_fitness.get(right, m_column);
+  }
+private:
+  const sgpFitnessMatrix &m_fitness;
+  uint m_column;
+};
+
+// ----------------------------------------------------------------------------
+// sgpParetoRanker
+// ----------------------------------------------------------------------------
+sgpParetoRanker::sgpParetoRanker(): m_fitness(SC_NULL), m_frontCount(0)
+{
+}
+
+sgpParetoRanker::~sgpParetoRanker()
+{
+}
+
+void sgpParetoRanker::rank(const sgpFitnessMatrix &fitness, const std::vector<uint> &columns)
+{
+  sgpParetoRowList rows(fitness.getRowCount());
+  for(uint i = 0, epos = rows.size(); i != epos; i++)
+    rows[i] = i;
+  rank(fitness, columns, rows);
+}
+
+void sgpParetoRanker::rank(const sgpFitnessMatrix &fitness, const std::vector<uint> &columns, const sgpParetoRowList &rows)
+{
+  m_fitness = &fitness;
+  m_columns = columns;
+  m_order = rows;
+  m_frontCount = 0;
+
+  std::sort(m_order.begin(), m_order.end(), sgpParetoLexPred(fitness, m_columns));
+
+  for(uint i = 0, epos = m_workFronts.size(); i != epos; i++)
+    m_workFronts[i].clear();
+
+  uint row, lo, hi, mid;
+
+  for(uint i = 0, epos = m_order.size(); i != epos; i++) {
+    row = m_order[i];
+
+    // first front which does not dominate the row
+    lo = 0;
+    hi = m_frontCount;
+    while(lo < hi) {
+      mid = (lo + hi) / 2;
+      if (isDominatedByFront(row, mid))
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+    if (lo == m_frontCount) {
+      m_frontCount++;
+      if (m_workFronts.size() < m_frontCount)
+        m_workFronts.resize(m_frontCount);
+    }
+
+    m_workFronts[lo].push_back(row);
+  }
+
+  buildFronts();
+  calcCrowding();
+  m_fitness = SC_NULL;
+}
+
+bool sgpParetoRanker::dominates(const double *first, const double *second, const std::vector<uint> &columns)
+{
+  bool better = false;
+  uint col;
+
+  for(uint i = 0, epos = columns.size(); i != epos; i++) {
+    col = columns[i];
+    if (first[col] < second[col])
+      return false;
+    if (first[col] > second[col])
+      better = true;
+  }
+
+  return better;
+}
+
+bool sgpParetoRanker::isDominatedByFront(uint row, uint frontNo) const
+{
+  const sgpParetoRowList &front = m_workFronts[frontNo];
+  const double *rowValues = m_fitness->getRow(row);
+
+  // recently added members are the most similar ones - check them first
+  for(uint i = front.size(); i > 0; i--)
+    if (dominates(m_fitness->getRow(front[i - 1]), rowValues, m_columns))
+      return true;
+
+  return false;
+}
+
+void sgpParetoRanker::buildFronts()
+{
+  m_ranks.assign(m_fitness->getRowCount(), m_frontCount);
+  m_frontStarts.resize(m_frontCount + 1);
+  m_frontRows.clear();
+  m_frontRows.reserve(m_order.size());
+
+  for(uint i = 0; i != m_frontCount; i++) {
+    sgpParetoRowList &front = m_workFronts[i];
+    std::sort(front.begin(), front.end());
+
+    m_frontStarts[i] = m_frontRows.size();
+    for(uint j = 0, epos = front.size(); j != epos; j++) {
+      m_ranks[front[j]] = i;
+      m_frontRows.push_back(front[j]);
+    }
+  }
+
+  m_frontStarts[m_frontCount] = m_frontRows.size();
+}
+
+void sgpParetoRanker::calcCrowding()
+{
+  const double infValue = std::numeric_limits<double>::infinity();
+  uint first, last, col;
+  double range;
+
+  m_crowding.assign(m_fitness->getRowCount(), 0.0);
+
+  for(uint f = 0; f != m_frontCount; f++) {
+    first = m_frontStarts[f];
+    last = m_frontStarts[f + 1];
+
+    if (last - first < 3) {
+      for(uint i = first; i != last; i++)
+        m_crowding[m_frontRows[i]] = infValue;
+      continue;
+    }
+
+    // work on a copy - front rows stay sorted by row number
+    m_order.assign(m_frontRows.begin() + first, m_frontRows.begin() + last);
+    uint size = m_order.size();
+
+    for(uint c = 0, cpos = m_columns.size(); c != cpos; c++) {
+      col = m_columns[c];
+      std::sort(m_order.begin(), m_order.end(), sgpParetoColumnPred(*m_fitness, col));
+
+      m_crowding[m_order[0]] = infValue;
+      m_crowding[m_order[size - 1]] = infValue;
+
+      range = m_fitness->get(m_order[size - 1], col) - m_fitness->get(m_order[0], col);
+      if (range <= 0.0)
+        continue;
+
+      for(uint i = 1; i != size - 1; i++)
+        m_crowding[m_order[i]] += 
+          (m_fitness->get(m_order[i + 1], col) - m_fitness->get(m_order[i - 1], col)) / range;
+    }
+  }
+}
+
+uint sgpParetoRanker::getFrontCount() const
+{
+  return m_frontCount;
+}
+
+void sgpParetoRanker::getFront(uint frontNo, sgpParetoRowList &output) const
+{
+  assert(frontNo < m_frontCount);
+  output.assign(m_frontRows.begin() + m_frontStarts[frontNo], m_frontRows.begin() + m_frontStarts[frontNo + 1]);
+}
+
+uint sgpParetoRanker::getRank(uint row) const
+{
+  return m_ranks[row];
+}
+
+double sgpParetoRanker::getCrowding(uint row) const
+{
+  return m_crowding[row];
+}
@@ -0,0 +1,66 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        PopulationStoreUInt.cpp
+// Project:     sgpLib
+// Purpose:     Contiguous storage of uint genomes & fitness for whole population.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#include "sc/utils.h"
+
+#include "sgp/PopulationStoreUInt.h"
+
+// ----------------------------------------------------------------------------
+// sgpPopulationStoreUInt
+// ----------------------------------------------------------------------------
+sgpPopulationStoreUInt::sgpPopulationStoreUInt(uint genomeSize, uint objectiveCount, uint chunkSize):
+  m_genomeSize(genomeSize), m_objectiveCount(objectiveCount), m_chunkSize(SC_MAX(1u, chunkSize)), m_usedCount(0)
+{
+}
+
+sgpPopulationStoreUInt::~sgpPopulationStoreUInt()
+{
+}
+
+uint sgpPopulationStoreUInt::allocSlot()
+{
+  if (m_freeSlots.empty())
+    addChunk();
+
+  uint res = m_freeSlots.top();
+  m_freeSlots.pop();
+  m_usedCount++;
+  return res;
+}
+
+void sgpPopulationStoreUInt::releaseSlot(uint slot)
+{
+  assert(slot < m_chunks.size() * m_chunkSize);
+  assert(m_usedCount > 0);
+  m_freeSlots.push(slot);
+  m_usedCount--;
+}
+
+const uint *sgpPopulationStoreUInt::getChunkGenomes(uint chunkIndex) const
+{
+  return m_genomeSize ? &(m_chunks[chunkIndex].genomes[0]) : SC_NULL;
+}
+
+const double *sgpPopulationStoreUInt::getChunkFitness(uint chunkIndex) const
+{
+  return m_objectiveCount ? &(m_chunks[chunkIndex].fitness[0]) : SC_NULL;
+}
+
+void sgpPopulationStoreUInt::addChunk()
+{
+  std::auto_ptr<sgpPopulationStoreChunk> chunkGuard(new sgpPopulationStoreChunk());
+  uint firstSlot = m_chunks.size() * m_chunkSize;
+
+  chunkGuard->genomes.resize(m_chunkSize * m_genomeSize, 0);
+  chunkGuard->fitness.resize(m_chunkSize * m_objectiveCount, 0.0);
+  m_chunks.push_back(chunkGuard.release());
+
+  for(uint i = 0; i != m_chunkSize; i++)
+    m_freeSlots.push(firstSlot + i);
+}
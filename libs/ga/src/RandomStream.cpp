@@ -0,0 +1,239 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        RandomStream.cpp
+// Project:     sgpLib
+// Purpose:     Counter-based random number streams for parallel operators.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+//std
+#include <cmath>
+
+//base
+#include "base/rand.h"
+
+//sgp
+#include "sgp/RandomStream.h"
+
+#ifdef DEBUG_MEM
+#include "sc/DebugMem.h"
+#endif
+
+using namespace dtp;
+
+// Philox4x32 constants
+const uint PHILOX_M0 = 0xD2511F53u;
+const uint PHILOX_M1 = 0xCD9E8D57u;
+const uint PHILOX_W0 = 0x9E3779B9u;
+const uint PHILOX_W1 = 0xBB67AE85u;
+const uint PHILOX_ROUNDS = 10;
+const double RS_UINT32_SCALE = 1.0 / 4294967296.0;
+const double RS_TWO_PI = 6.283185307179586476925286766559;
+
+// ----------------------------------------------------------------------------
+// sgpGlobalRandomSource
+// ----------------------------------------------------------------------------
+int sgpGlobalRandomSource::randomInt(int minValue, int maxValue)
+{
+  return ::randomInt(minValue, maxValue);
+}
+
+uint sgpGlobalRandomSource::randomUInt(uint minValue, uint maxValue)
+{
+  return ::randomUInt(minValue, maxValue);
+}
+
+double sgpGlobalRandomSource::randomDouble(double minValue, double maxValue)
+{
+  return ::randomDouble(minValue, maxValue);
+}
+
+bool sgpGlobalRandomSource::randomFlip(double prob)
+{
+  return ::randomFlip(prob);
+}
+
+void sgpGlobalRandomSource::randomString(const scString &charSet, uint len, scString &output)
+{
+  ::randomString(charSet, len, output);
+}
+
+sgpGlobalRandomSource &sgpGlobalRandomSource::instance()
+{
+  static sgpGlobalRandomSource source;
+  return source;
+}
+
+// ----------------------------------------------------------------------------
+// sgpRandomStream
+// ----------------------------------------------------------------------------
+sgpRandomStream::sgpRandomStream()
+{
+  reset(0, 0, 0, 0);
+}
+
+sgpRandomStream::sgpRandomStream(ulong64 seed, uint step, uint entity, uint oper)
+{
+  reset(seed, step, entity, oper);
+}
+
+void sgpRandomStream::reset(ulong64 seed, uint step, uint entity, uint oper)
+{
+  m_key[0] = static_cast<uint>(seed & 0xFFFFFFFFu);
+  m_key[1] = static_cast<uint>(seed >> 32);
+  m_counter[0] = 0;
+  m_counter[1] = step;
+  m_counter[2] = entity;
+  m_counter[3] = oper;
+  m_blockPos = 4;
+}
+
+uint sgpRandomStream::getPosition() const
+{
+  return m_counter[0];
+}
+
+void sgpRandomStream::setPosition(uint blockNo)
+{
+  m_counter[0] = blockNo;
+  m_blockPos = 4;
+}
+
+void sgpRandomStream::generateBlock()
+{
+  uint ctr[4];
+  uint key[2];
+  ulong64 prod0, prod1;
+
+  ctr[0] = m_counter[0];
+  ctr[1] = m_counter[1];
+  ctr[2] = m_counter[2];
+  ctr[3] = m_counter[3];
+  key[0] = m_key[0];
+  key[1] = m_key[1];
+
+  for(uint i = 0; i != PHILOX_ROUNDS; i++) {
+    prod0 = static_cast<ulong64>(PHILOX_M0) * ctr[0];
+    prod1 = static_cast<ulong64>(PHILOX_M1) * ctr[2];
+
+    uint hi0 = static_cast<uint>(prod0 >> 32);
+    uint lo0 = static_cast<uint>(prod0);
+    uint hi1 = static_cast<uint>(prod1 >> 32);
+    uint lo1 = static_cast<uint>(prod1);
+
+    ctr[0] = hi1 ^ ctr[1] ^ key[0];
+    ctr[1] = lo1;
+    ctr[2] = hi0 ^ ctr[3] ^ key[1];
+    ctr[3] = lo0;
+
+    key[0] += PHILOX_W0;
+    key[1] += PHILOX_W1;
+  }
+
+  m_block[0] = ctr[0];
+  m_block[1] = ctr[1];
+  m_block[2] = ctr[2];
+  m_block[3] = ctr[3];
+
+  m_counter[0]++;
+  m_blockPos = 0;
+}
+
+uint sgpRandomStream::nextUInt32()
+{
+  if (m_blockPos >= 4)
+    generateBlock();
+  return m_block[m_blockPos++];
+}
+
+// returns value from <0, 1)
+inline double sgpRandomStream::nextUnit()
+{
+  return static_cast<double>(nextUInt32()) * RS_UINT32_SCALE;
+}
+
+int sgpRandomStream::randomInt(int minValue, int maxValue)
+{
+  if (maxValue <= minValue)
+    return minValue;
+  uint range = static_cast<uint>(maxValue - minValue);
+  return minValue + static_cast<int>(randomUInt(0, range));
+}
+
+uint sgpRandomStream::randomUInt(uint minValue, uint maxValue)
+{
+  if (maxValue <= minValue)
+    return minValue;
+
+  uint range = maxValue - minValue;
+  if (range == 0xFFFFFFFFu)
+    return nextUInt32();
+
+  // rejection sampling - no modulo bias
+  uint span = range + 1;
+  uint limit = 0xFFFFFFFFu - (0xFFFFFFFFu % span + 1) % span;
+  uint value;
+  do {
+    value = nextUInt32();
+  } while (value > limit);
+
+  return minValue + value % span;
+}
+
+double sgpRandomStream::randomDouble(double minValue, double maxValue)
+{
+  return minValue + nextUnit() * (maxValue - minValue);
+}
+
+bool sgpRandomStream::randomFlip(double prob)
+{
+  return (nextUnit() < prob);
+}
+
+void sgpRandomStream::randomString(const scString &charSet, uint len, scString &output)
+{
+  output.resize(len);
+  if (charSet.empty())
+    return;
+
+  uint maxPos = charSet.length() - 1;
+  for(uint i = 0; i != len; i++)
+    output[i] = charSet[randomUInt(0, maxPos)];
+}
+
+void sgpRandomStream::fillUniform(double *output, uint count, double minValue, double maxValue)
+{
+  const double scale = (maxValue - minValue) * RS_UINT32_SCALE;
+  for(uint i = 0; i != count; i++)
+    output[i] = minValue + static_cast<double>(nextUInt32()) * scale;
+}
+
+void sgpRandomStream::fillNormal(double *output, uint count, double mean, double stdDev)
+{
+  double u1, u2, radius;
+  uint i = 0;
+
+  while(i < count) {
+    // (0, 1] - log(0) not possible
+    u1 = (static_cast<double>(nextUInt32()) + 1.0) * RS_UINT32_SCALE;
+    u2 = nextUnit();
+    radius = stdDev * sqrt(-2.0 * log(u1));
+
+    output[i++] = mean + radius * cos(RS_TWO_PI * u2);
+    if (i < count)
+      output[i++] = mean + radius * sin(RS_TWO_PI * u2);
+  }
+}
+
+void sgpRandomStream::fillUInt32(uint *output, uint count)
+{
+  for(uint i = 0; i != count; i++)
+    output[i] = nextUInt32();
+}
+
+ulong64 sgpRandomStream::newSeed()
+{
+  ulong64 res = ::randomUInt(0, 0xFFFFFFFFu);
+  return (res << 32) | ::randomUInt(0, 0xFFFFFFFFu);
+}
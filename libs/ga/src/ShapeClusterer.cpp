@@ -0,0 +1,413 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        ShapeClusterer.cpp
+// Project:     sgpLib
+// Purpose:     K-means clustering of objective columns for shape detection.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+//std
+#include <algorithm>
+#include <limits>
+
+//sc
+#include "sc/dtypes.h"
+
+//sgp
+#include "sgp/ShapeClusterer.h"
+
+#ifdef DEBUG_MEM
+#include "sc/DebugMem.h"
+#endif
+
+using namespace dtp;
+
+// ----------------------------------------------------------------------------
+// Local definitions
+// ----------------------------------------------------------------------------
+class sgpShapeValueLess {
+public:
+  sgpShapeValueLess(const double *values): m_values(values) {}
+  bool operator()(uint a, uint b) const { return m_values[a] < m_values[b]; }
+private:
+  const double *m_values;
+};
+
+// ----------------------------------------------------------------------------
+// sgpShapeClusterer
+// ----------------------------------------------------------------------------
+sgpShapeClusterer::sgpShapeClusterer(): m_shift(0.0), m_stepCount(0)
+{
+  m_clusterStart.push_back(0);
+}
+
+void sgpShapeClusterer::clear()
+{
+  m_clusterStart.assign(1, 0);
+  m_clusterItems.clear();
+  m_centroids.clear();
+  m_warmCentroids.clear();
+  m_stepCount = 0;
+}
+
+// ----------------------------------------------------------------------------
+// single column
+// ----------------------------------------------------------------------------
+void sgpShapeClusterer::execute(const double *values, uint count, uint clusterLimit)
+{
+  m_clusterStart.assign(1, 0);
+  m_clusterItems.clear();
+  m_centroids.clear();
+  m_stepCount = 0;
+
+  if (count == 0)
+    return;
+
+  prepareSortedValues(values, count);
+
+  uint uniqCount = m_uniqEnd.size();
+  uint clusterCount = std::min<uint>(std::max<uint>(clusterLimit, 1), uniqCount);
+
+  m_clusterItems.reserve(count);
+  m_clusterItems.assign(m_order.begin(), m_order.end());
+
+  if (clusterCount == 0) {
+    // only NaN values
+    m_clusterItems.insert(m_clusterItems.end(), m_nanItems.begin(), m_nanItems.end());
+    m_clusterStart.push_back(m_clusterItems.size());
+    m_centroids.push_back(std::numeric_limits<double>::quiet_NaN());
+    return;
+  }
+
+  if (clusterCount > 1)
+    calcOptimalSplit(clusterCount);
+
+  m_centroids.resize(clusterCount);
+  m_clusterStart.resize(clusterCount + 1);
+
+  // walk back from the last cluster
+  uint lastUniq = uniqCount - 1;
+  uint firstUniq;
+  for(int c = clusterCount - 1; c >= 0; c--)
+  {
+    firstUniq = (c > 0) ? m_splitAt[c * uniqCount + lastUniq] : 0;
+    m_clusterStart[c] = (firstUniq > 0) ? m_uniqEnd[firstUniq - 1] : 0;
+    m_centroids[c] =
+      (m_sum1[lastUniq + 1] - m_sum1[firstUniq]) / (m_sumW[lastUniq + 1] - m_sumW[firstUniq]) + m_shift;
+    if (c > 0)
+      lastUniq = firstUniq - 1;
+  }
+
+  m_clusterItems.insert(m_clusterItems.end(), m_nanItems.begin(), m_nanItems.end());
+  m_clusterStart[clusterCount] = m_clusterItems.size();
+}
+
+// Sorts positions by value and builds prefix sums of distinct values
+// (weighted by number of occurences). Values are shifted by median to
+// limit cancellation in cost calculation.
+void sgpShapeClusterer::prepareSortedValues(const double *values, uint count)
+{
+  m_order.clear();
+  m_nanItems.clear();
+
+  for(uint i = 0; i != count; i++)
+    if (values[i] == values[i])
+      m_order.push_back(i);
+    else
+      m_nanItems.push_back(i);
+
+  std::stable_sort(m_order.begin(), m_order.end(), sgpShapeValueLess(values));
+
+  m_uniqEnd.clear();
+  m_sumW.assign(1, 0.0);
+  m_sum1.assign(1, 0.0);
+  m_sum2.assign(1, 0.0);
+
+  if (m_order.empty())
+    return;
+
+  m_shift = values[m_order[m_order.size() / 2]];
+
+  double value, weight;
+  uint i = 0;
+  uint epos = m_order.size();
+
+  while(i != epos)
+  {
+    value = values[m_order[i]];
+    weight = 0.0;
+    while((i != epos) && (values[m_order[i]] == value)) {
+      weight += 1.0;
+      i++;
+    }
+    value -= m_shift;
+    m_uniqEnd.push_back(i);
+    m_sumW.push_back(m_sumW.back() + weight);
+    m_sum1.push_back(m_sum1.back() + weight * value);
+    m_sum2.push_back(m_sum2.back() + weight * value * value);
+  }
+}
+
+// sum of squared distances to mean for distinct values first..last
+double sgpShapeClusterer::calcRangeCost(uint first, uint last) const
+{
+  double s1 = m_sum1[last + 1] - m_sum1[first];
+  double res = (m_sum2[last + 1] - m_sum2[first]) - s1 * s1 / (m_sumW[last + 1] - m_sumW[first]);
+  return (res > 0.0) ? res : 0.0;
+}
+
+// cost[c][j] = min(i) cost[c-1][i-1] + rangeCost(i, j)
+// optimal i is monotone in j, so each row is calculated by divide & conquer
+void sgpShapeClusterer::calcOptimalSplit(uint clusterCount)
+{
+  uint uniqCount = m_uniqEnd.size();
+
+  m_costPrev.resize(uniqCount);
+  m_costCur.resize(uniqCount);
+  m_splitAt.resize(clusterCount * uniqCount);
+
+  for(uint j = 0; j != uniqCount; j++)
+  {
+    m_costPrev[j] = calcRangeCost(0, j);
+    m_splitAt[j] = 0;
+  }
+
+  for(uint c = 1; c != clusterCount; c++)
+  {
+    calcSplitRow(c, c, uniqCount - 1, c, uniqCount - 1);
+    m_costPrev.swap(m_costCur);
+  }
+}
+
+void sgpShapeClusterer::calcSplitRow(uint rowNo, int firstCol, int lastCol, uint firstSplit, uint lastSplit)
+{
+  if (firstCol > lastCol)
+    return;
+
+  uint col = static_cast<uint>((firstCol + lastCol) / 2);
+  uint uniqCount = m_uniqEnd.size();
+  uint bestSplit = std::max<uint>(rowNo, firstSplit);
+  uint endSplit = std::min<uint>(col, lastSplit);
+  double bestCost = std::numeric_limits<double>::max();
+  double cost;
+
+  for(uint i = bestSplit; i <= endSplit; i++)
+  {
+    cost = m_costPrev[i - 1] + calcRangeCost(i, col);
+    if (cost < bestCost) {
+      bestCost = cost;
+      bestSplit = i;
+    }
+  }
+
+  m_costCur[col] = bestCost;
+  m_splitAt[rowNo * uniqCount + col] = bestSplit;
+
+  calcSplitRow(rowNo, firstCol, static_cast<int>(col) - 1, firstSplit, bestSplit);
+  calcSplitRow(rowNo, col + 1, lastCol, bestSplit, lastSplit);
+}
+
+// ----------------------------------------------------------------------------
+// two columns
+// ----------------------------------------------------------------------------
+void sgpShapeClusterer::execute(const double *values, const double *values2, uint count, uint clusterLimit, uint stepLimit)
+{
+  m_clusterStart.assign(1, 0);
+  m_clusterItems.clear();
+  m_centroids.clear();
+  m_stepCount = 0;
+
+  if (count == 0)
+    return;
+
+  // items with NaN on any column do not take part in Lloyd's steps, 
+  // otherwise they would turn centroids (also warm ones) into NaN 
+  m_validItems.clear();
+  m_nanItems.clear();
+  for(uint i = 0; i != count; i++)
+    if ((values[i] == values[i]) && (values2[i] == values2[i]))
+      m_validItems.push_back(i);
+    else
+      m_nanItems.push_back(i);
+
+  uint validCount = m_validItems.size();
+
+  if (validCount == 0) {
+    // only NaN values
+    m_clusterItems.assign(m_nanItems.begin(), m_nanItems.end());
+    m_clusterStart.push_back(m_clusterItems.size());
+    m_centroids.push_back(std::numeric_limits<double>::quiet_NaN());
+    return;
+  }
+
+  uint clusterCount = std::min<uint>(std::max<uint>(clusterLimit, 1), validCount);
+
+  if (m_warmCentroids.size() != 2 * clusterCount)
+    initCentroids(values, values2, clusterCount);
+
+  m_labels.assign(count, clusterCount);
+  m_itemDist.resize(validCount);
+  m_clusterSum.resize(2 * clusterCount);
+  m_clusterCnt.resize(clusterCount);
+
+  bool changed;
+  uint best, idx;
+  double dist, bestDist, dx, dy;
+
+  do {
+    m_stepCount++;
+    changed = false;
+
+    for(uint i = 0; i != validCount; i++)
+    {
+      idx = m_validItems[i];
+      best = 0;
+      bestDist = std::numeric_limits<double>::max();
+      for(uint c = 0; c != clusterCount; c++)
+      {
+        dx = values[idx] - m_warmCentroids[2 * c];
+        dy = values2[idx] - m_warmCentroids[2 * c + 1];
+        dist = dx * dx + dy * dy;
+        if (dist < bestDist) {
+          bestDist = dist;
+          best = c;
+        }
+      }
+      m_itemDist[i] = bestDist;
+      if (m_labels[idx] != best) {
+        m_labels[idx] = best;
+        changed = true;
+      }
+    }
+
+    // centers are means of current members
+    std::fill(m_clusterSum.begin(), m_clusterSum.end(), 0.0);
+    std::fill(m_clusterCnt.begin(), m_clusterCnt.end(), 0);
+    for(uint i = 0; i != validCount; i++)
+    {
+      idx = m_validItems[i];
+      m_clusterSum[2 * m_labels[idx]] += values[idx];
+      m_clusterSum[2 * m_labels[idx] + 1] += values2[idx];
+      m_clusterCnt[m_labels[idx]]++;
+    }
+
+    if (reseedEmptyClusters(values, values2, clusterCount))
+      changed = true;
+
+    for(uint c = 0; c != clusterCount; c++)
+      if (m_clusterCnt[c] > 0) {
+        m_warmCentroids[2 * c] = m_clusterSum[2 * c] / static_cast<double>(m_clusterCnt[c]);
+        m_warmCentroids[2 * c + 1] = m_clusterSum[2 * c + 1] / static_cast<double>(m_clusterCnt[c]);
+      }
+  } while(changed && (m_stepCount < stepLimit));
+
+  buildFromLabels(clusterCount);
+}
+
+// cold start: items at equally spaced quantiles of first column
+void sgpShapeClusterer::initCentroids(const double *values, const double *values2, uint clusterCount)
+{
+  uint count = m_validItems.size();
+
+  m_order.assign(m_validItems.begin(), m_validItems.end());
+  std::stable_sort(m_order.begin(), m_order.end(), sgpShapeValueLess(values));
+
+  m_warmCentroids.resize(2 * clusterCount);
+
+  uint idx;
+  for(uint c = 0; c != clusterCount; c++)
+  {
+    idx = m_order[((2 * c + 1) * count) / (2 * clusterCount)];
+    m_warmCentroids[2 * c] = values[idx];
+    m_warmCentroids[2 * c + 1] = values2[idx];
+  }
+}
+
+// Warm centers can be left without members when population moves.
+// Each empty cluster takes the item farthest from all centers, including 
+// the ones seeded before (from a cluster with more than one member), 
+// items equal to a center are never moved. Returns true if any item was moved.
+bool sgpShapeClusterer::reseedEmptyClusters(const double *values, const double *values2, uint clusterCount)
+{
+  uint validCount = m_validItems.size();
+  uint farthest, idx, donor;
+  double farthestDist, dx, dy;
+  bool res = false;
+
+  for(uint c = 0; c != clusterCount; c++)
+  {
+    if (m_clusterCnt[c] > 0)
+      continue;
+
+    farthest = validCount;
+    farthestDist = 0.0;
+    for(uint i = 0; i != validCount; i++)
+      if ((m_itemDist[i] > farthestDist) && (m_clusterCnt[m_labels[m_validItems[i]]] > 1)) {
+        farthestDist = m_itemDist[i];
+        farthest = i;
+      }
+
+    if (farthest == validCount)
+      break;
+
+    idx = m_validItems[farthest];
+    donor = m_labels[idx];
+    m_clusterSum[2 * donor] -= values[idx];
+    m_clusterSum[2 * donor + 1] -= values2[idx];
+    m_clusterCnt[donor]--;
+
+    m_labels[idx] = c;
+    m_clusterSum[2 * c] = values[idx];
+    m_clusterSum[2 * c + 1] = values2[idx];
+    m_clusterCnt[c] = 1;
+    res = true;
+
+    // distance to nearest center, new one included
+    for(uint i = 0; i != validCount; i++)
+    {
+      dx = values[m_validItems[i]] - values[idx];
+      dy = values2[m_validItems[i]] - values2[idx];
+      m_itemDist[i] = std::min<double>(m_itemDist[i], dx * dx + dy * dy);
+    }
+  }
+
+  return res;
+}
+
+// counting sort of valid positions by label, empty clusters are skipped,
+// NaN items are added to the last cluster
+void sgpShapeClusterer::buildFromLabels(uint clusterCount)
+{
+  m_order.assign(clusterCount, 0);
+
+  uint clusterNo = 0;
+  for(uint c = 0; c != clusterCount; c++)
+    if (m_clusterCnt[c] > 0) {
+      m_order[c] = clusterNo++;
+      m_centroids.push_back(m_warmCentroids[2 * c]);
+    }
+
+  m_clusterStart.assign(clusterNo + 1, 0);
+  for(uint c = 0; c != clusterCount; c++)
+    if (m_clusterCnt[c] > 0)
+      m_clusterStart[m_order[c] + 1] = m_clusterCnt[c];
+
+  for(uint c = 0; c != clusterNo; c++)
+    m_clusterStart[c + 1] += m_clusterStart[c];
+
+  m_clusterItems.resize(m_validItems.size());
+  m_clusterCnt.assign(clusterNo, 0);
+
+  uint target, idx;
+  for(uint i = 0, epos = m_validItems.size(); i != epos; i++)
+  {
+    idx = m_validItems[i];
+    target = m_order[m_labels[idx]];
+    m_clusterItems[m_clusterStart[target] + m_clusterCnt[target]] = idx;
+    m_clusterCnt[target]++;
+  }
+
+  m_clusterItems.insert(m_clusterItems.end(), m_nanItems.begin(), m_nanItems.end());
+  m_clusterStart[clusterNo] = m_clusterItems.size();
+}
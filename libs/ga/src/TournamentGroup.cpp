@@ -0,0 +1,63 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        TournamentGroup.cpp
+// Project:     sgpLib
+// Purpose:     Small sorted set of entity indices used by tournaments.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+//sc
+#include "sc/utils.h"
+
+//sgp
+#include "sgp/TournamentGroup.h"
+
+#ifdef DEBUG_MEM
+#include "sc/DebugMem.h"
+#endif
+
+// ----------------------------------------------------------------------------
+// sgpTournamentGroup
+// ----------------------------------------------------------------------------
+void sgpTournamentGroup::assign(const sgpTournamentGroup &src)
+{
+  if (src.m_size > SGP_TOUR_GROUP_INLINE_SIZE) {
+    if (m_heap.size() < src.m_size)
+      m_heap.resize(src.m_size);
+    m_onHeap = true;
+  } else {
+    m_onHeap = false;
+  }
+
+  std::copy(src.begin(), src.end(), data());
+  m_size = src.m_size;
+}
+
+void sgpTournamentGroup::grow()
+{
+  uint newCapacity = 2 * SC_MAX(m_size, SGP_TOUR_GROUP_INLINE_SIZE);
+
+  if (m_onHeap) {
+    m_heap.resize(newCapacity);
+  } else {
+    if (m_heap.size() < newCapacity)
+      m_heap.resize(newCapacity);
+    std::copy(m_inline, m_inline + m_size, m_heap.begin());
+    m_onHeap = true;
+  }
+}
+
+void sgpTournamentGroup::swap(sgpTournamentGroup &other)
+{
+  if (!m_onHeap || !other.m_onHeap) {
+    uint inlineBuf[SGP_TOUR_GROUP_INLINE_SIZE];
+    std::copy(m_inline, m_inline + SGP_TOUR_GROUP_INLINE_SIZE, inlineBuf);
+    std::copy(other.m_inline, other.m_inline + SGP_TOUR_GROUP_INLINE_SIZE, m_inline);
+    std::copy(inlineBuf, inlineBuf + SGP_TOUR_GROUP_INLINE_SIZE, other.m_inline);
+  }
+
+  m_heap.swap(other.m_heap);
+  std::swap(m_size, other.m_size);
+  std::swap(m_onHeap, other.m_onHeap);
+}
@@ -0,0 +1,309 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        WorkStealScheduler.cpp
+// Project:     sgpLib
+// Purpose:     Work-stealing scheduler for fine-grained parallel tasks
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+#include "sc/defs.h"
+
+//sc
+#include "sc/ompdefs.h"
+#include "sc/utils.h"
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
+//sgp
+#include "sgp/WorkStealScheduler.h"
+
+#ifdef DEBUG_MEM
+#include "sc/DebugMem.h"
+#endif
+
+using namespace dtp;
+
+// ----------------------------------------------------------------------------
+// sgpWorkStealQueue
+// ----------------------------------------------------------------------------
+/// Deque of task numbers kept as a range [m_front, m_back)
+class sgpWorkStealQueue {
+public:
+  sgpWorkStealQueue() { 
+    m_front = m_back = 0; 
+#ifdef USE_OPENMP
+    omp_init_lock(&m_lock);
+#endif
+  }
+
+  ~sgpWorkStealQueue() {
+#ifdef USE_OPENMP
+    omp_destroy_lock(&m_lock);
+#endif
+  }
+
+  void assign(uint front, uint back) {
+    lock();
+    m_front = front;
+    m_back = back;
+    unlock();
+  }
+
+  /// take task from back, used by owner
+  bool pop(uint &taskNo) {
+    bool res = false;
+    lock();
+    if (m_front < m_back) {
+      m_back--;
+      taskNo = m_back;
+      res = true;
+    }
+    unlock();
+    return res;
+  }
+
+  /// take half of tasks from front, used by thieves
+  bool steal(uint &front, uint &back) {
+    bool res = false;
+    lock();
+    if (m_front < m_back) {
+      uint stealSize = (m_back - m_front + 1) / 2;
+      front = m_front;
+      back = m_front + stealSize;
+      m_front = back;
+      res = true;
+    }
+    unlock();
+    return res;
+  }
+
+private:
+  void lock() {
+#ifdef USE_OPENMP
+    omp_set_lock(&m_lock);
+#endif
+  }
+
+  void unlock() {
+#ifdef USE_OPENMP
+    omp_unset_lock(&m_lock);
+#endif
+  }
+
+private:
+  uint m_front;
+  uint m_back;
+#ifdef USE_OPENMP
+  omp_lock_t m_lock;
+#endif
+  // avoid false sharing between queues
+  char m_padding[64];
+};
+
+// ----------------------------------------------------------------------------
+// sgpWorkStealScheduler
+// ----------------------------------------------------------------------------
+sgpWorkStealScheduler::sgpWorkStealScheduler()
+{
+  m_workerCount = 0;
+  m_aborted = false;
+}
+
+sgpWorkStealScheduler::~sgpWorkStealScheduler()
+{
+  for(uint i=0, epos = m_queues.size(); i != epos; i++)
+    delete m_queues[i];
+}
+
+uint sgpWorkStealScheduler::getWorkerCount() const
+{
+  return m_workerCount;
+}
+
+void sgpWorkStealScheduler::setWorkerCount(uint value)
+{
+  m_workerCount = value;
+}
+
+uint sgpWorkStealScheduler::calcWorkerCount() const
+{
+#ifdef USE_OPENMP
+  if (m_workerCount > 0)
+    return m_workerCount;
+  else
+    return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+const sgpWorkStealStatsList &sgpWorkStealScheduler::getStats() const
+{
+  return m_stats;
+}
+
+void sgpWorkStealScheduler::resetStats()
+{
+  m_stats.clear();
+}
+
+void sgpWorkStealScheduler::getCounters(scDataNode &output) const
+{
+  ulong64 taskCount = 0;
+  ulong64 stealCount = 0;
+  double busyTime = 0.0;
+  double maxBusyTime = 0.0;
+
+  for(uint i=0, epos = m_stats.size(); i != epos; i++)
+  {
+    std::auto_ptr<scDataNode> workerNodeGuard(new scDataNode(ict_parent));
+    workerNodeGuard->addChild("task-count", new scDataNode(m_stats[i].taskCount));
+    workerNodeGuard->addChild("steal-count", new scDataNode(m_stats[i].stealCount));
+    workerNodeGuard->addChild("steal-task-count", new scDataNode(m_stats[i].stealTaskCount));
+#ifdef USE_OPENMP
+    workerNodeGuard->addChild("busy-time", new scDataNode(m_stats[i].busyTime));
+#endif
+    output.addChild("worker-"+toString(i), workerNodeGuard.release());
+
+    taskCount += m_stats[i].taskCount;
+    stealCount += m_stats[i].stealCount;
+    busyTime += m_stats[i].busyTime;
+    maxBusyTime = SC_MAX(maxBusyTime, m_stats[i].busyTime);
+  }
+
+  output.addChild("task-count", new scDataNode(taskCount));
+  output.addChild("steal-count", new scDataNode(stealCount));
+#ifdef USE_OPENMP
+  output.addChild("busy-time", new scDataNode(busyTime));
+  // 1.0 = perfectly balanced
+  if (maxBusyTime > 0.0)
+    output.addChild("balance", new scDataNode(busyTime / (maxBusyTime * m_stats.size())));
+#endif
+}
+
+void sgpWorkStealScheduler::prepareQueues(uint workerCount, uint taskCount)
+{
+  while(m_queues.size() < workerCount)
+    m_queues.push_back(new sgpWorkStealQueue());
+
+  if (m_stats.size() < workerCount) {
+    sgpWorkStealWorkerStats emptyStats;
+    emptyStats.taskCount = emptyStats.stealCount = emptyStats.stealTaskCount = 0;
+    emptyStats.busyTime = 0.0;
+    m_stats.resize(workerCount, emptyStats);
+  }
+
+  // initial distribution: equal contiguous blocks
+  uint blockSize = taskCount / workerCount;
+  uint restSize = taskCount % workerCount;
+  uint front = 0;
+  uint back;
+
+  for(uint i=0, epos = m_queues.size(); i != epos; i++)
+  {
+    if (i < workerCount) {
+      back = front + blockSize + ((i < restSize) ? 1 : 0);
+      m_queues[i]->assign(front, back);
+      front = back;
+    } else {
+      m_queues[i]->assign(0, 0);
+    }
+  }
+}
+
+void sgpWorkStealScheduler::execute(uint taskCount, sgpWorkStealTask &task)
+{
+  if (taskCount == 0)
+    return;
+
+  uint workerCount = SC_MIN(calcWorkerCount(), taskCount);
+  if (workerCount < 1) 
+    workerCount = 1;
+
+  m_aborted = false;
+  m_errorMsg.clear();
+
+  prepareQueues(workerCount, taskCount);
+
+#ifdef USE_OPENMP
+  if (workerCount > 1) {
+    #pragma omp parallel num_threads(workerCount)
+    {
+      // runtime can give less threads than requested, tasks of missing workers will be stolen
+      runWorker(omp_get_thread_num(), task);
+    }
+  } else {
+    runWorker(0, task);
+  }
+#else
+  runWorker(0, task);
+#endif
+
+  if (m_aborted)
+    throw scError("Task execution failed: "+m_errorMsg);
+}
+
+void sgpWorkStealScheduler::runWorker(uint workerNo, sgpWorkStealTask &task)
+{
+  sgpWorkStealQueue *queue = m_queues[workerNo];
+  sgpWorkStealWorkerStats &stats = m_stats[workerNo];
+  uint taskNo;
+#ifdef USE_OPENMP
+  double startTime;
+#endif
+
+  do {
+    while(!m_aborted && queue->pop(taskNo)) 
+    {
+#ifdef USE_OPENMP
+      startTime = omp_get_wtime();
+#endif
+      try {
+        task.runTask(workerNo, taskNo);
+      }
+      catch(const std::exception &e) {
+        handleTaskError(e.what());
+      }
+#ifdef USE_OPENMP
+      stats.busyTime += omp_get_wtime() - startTime;
+#endif
+      stats.taskCount++;
+    }
+  } while(!m_aborted && stealTasks(workerNo));
+}
+
+bool sgpWorkStealScheduler::stealTasks(uint workerNo)
+{
+  uint front, back;
+  uint queueCount = m_queues.size();
+
+  // try victims in order starting from next worker
+  for(uint i=1; i < queueCount; i++)
+  {
+    uint victimNo = (workerNo + i) % queueCount;
+    if (m_queues[victimNo]->steal(front, back)) {
+      m_queues[workerNo]->assign(front, back);
+      m_stats[workerNo].stealCount++;
+      m_stats[workerNo].stealTaskCount += back - front;
+      return true;
+    }
+  }
+
+  // all queues empty - no new tasks can appear
+  return false;
+}
+
+void sgpWorkStealScheduler::handleTaskError(const scString &msg)
+{
+#ifdef USE_OPENMP
+  #pragma omp critical (sgpWorkStealError)
+#endif
+  {
+    if (!m_aborted) {
+      m_errorMsg = msg;
+      m_aborted = true;
+    }
+  }
+}
@@ -0,0 +1,122 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        AliasSamplerTest.cpp
+// Project:     sgpLib
+// Purpose:     Unit tests for sgpAliasSampler.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#define BOOST_TEST_MODULE AliasSamplerTest
+#include <boost/test/unit_test.hpp>
+
+//std
+#include <limits>
+#include <vector>
+
+//sgp
+#include "sgp/AliasSampler.h"
+#include "sgp/RandomStream.h"
+
+namespace {
+
+void countDraws(const sgpAliasSampler &sampler, uint drawCount, std::vector<uint> &output)
+{
+  sgpRandomStream random(31337, 0, 0, rsoSelect);
+  std::vector<uint> draws;
+
+  sampler.sample(random, drawCount, draws);
+  output.assign(sampler.size(), 0);
+  for(uint i = 0; i != draws.size(); i++)
+    output[draws[i]]++;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(rejectsInvalidWeights)
+{
+  sgpAliasSampler sampler;
+  std::vector<double> weights;
+
+  BOOST_CHECK(!sampler.build(weights));
+  BOOST_CHECK(sampler.empty());
+
+  weights.assign(3, 0.0);
+  BOOST_CHECK(!sampler.build(weights));
+  BOOST_CHECK(sampler.empty());
+
+  weights[0] = 1.0;
+  weights[1] = -0.5;
+  BOOST_CHECK(!sampler.build(weights));
+  BOOST_CHECK(sampler.empty());
+
+  weights[1] = std::numeric_limits<double>::quiet_NaN();
+  BOOST_CHECK(!sampler.build(weights));
+
+  weights[1] = std::numeric_limits<double>::infinity();
+  BOOST_CHECK(!sampler.build(weights));
+  BOOST_CHECK(sampler.empty());
+}
+
+BOOST_AUTO_TEST_CASE(singleItemIsAlwaysDrawn)
+{
+  const double weights[] = {0.3};
+  sgpAliasSampler sampler;
+  std::vector<uint> counts;
+
+  BOOST_REQUIRE(sampler.build(weights, 1));
+  BOOST_CHECK_EQUAL(sampler.size(), 1u);
+
+  countDraws(sampler, 100, counts);
+  BOOST_CHECK_EQUAL(counts[0], 100u);
+}
+
+BOOST_AUTO_TEST_CASE(zeroWeightItemsAreNeverDrawn)
+{
+  const double weights[] = {0.0, 2.0, 0.0, 1.0, 0.0};
+  sgpAliasSampler sampler;
+  std::vector<uint> counts;
+
+  BOOST_REQUIRE(sampler.build(weights, 5));
+  countDraws(sampler, 30000, counts);
+
+  BOOST_CHECK_EQUAL(counts[0], 0u);
+  BOOST_CHECK_EQUAL(counts[2], 0u);
+  BOOST_CHECK_EQUAL(counts[4], 0u);
+  BOOST_CHECK_SMALL(counts[1] / 30000.0 - 2.0 / 3.0, 0.02);
+  BOOST_CHECK_SMALL(counts[3] / 30000.0 - 1.0 / 3.0, 0.02);
+}
+
+BOOST_AUTO_TEST_CASE(drawFrequenciesFollowWeights)
+{
+  const uint itemCount = 50;
+  const uint drawCount = 200000;
+  std::vector<double> weights(itemCount);
+  double sum = 0.0;
+  std::vector<uint> counts;
+  sgpAliasSampler sampler;
+
+  // skewed weights - mix of columns below and above mean
+  for(uint i = 0; i != itemCount; i++) {
+    weights[i] = static_cast<double>((i * i) % 17 + 1);
+    sum += weights[i];
+  }
+
+  BOOST_REQUIRE(sampler.build(weights));
+  BOOST_CHECK_EQUAL(sampler.size(), itemCount);
+  countDraws(sampler, drawCount, counts);
+
+  for(uint i = 0; i != itemCount; i++)
+    BOOST_CHECK_SMALL(static_cast<double>(counts[i]) / drawCount - weights[i] / sum, 0.003);
+}
+
+BOOST_AUTO_TEST_CASE(clearEmptiesSampler)
+{
+  const double weights[] = {1.0, 1.0};
+  sgpAliasSampler sampler;
+
+  BOOST_REQUIRE(sampler.build(weights, 2));
+  sampler.clear();
+  BOOST_CHECK(sampler.empty());
+  BOOST_CHECK_EQUAL(sampler.size(), 0u);
+}
@@ -0,0 +1,189 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        EntityIslandToolGaTest.cpp
+// Project:     sgpLib
+// Purpose:     Unit tests for island id lookup and its per-entity cache.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#define BOOST_TEST_MODULE EntityIslandToolGaTest
+#include <boost/test/unit_test.hpp>
+
+//base
+#include "base/bitstr.h"
+
+//sgp
+#include "sgp/EntityIslandToolGa.h"
+#include "sgp/EntityForGaUInt.h"
+#include "sgp/EntityForGaVarType.h"
+
+using namespace dtp;
+
+namespace {
+
+const uint ISLAND_LIMIT = 8;
+const uint ISLAND_BIT_SIZE = 4;
+const int ISLAND_ID_POS = 1;
+const uint GENOME_SIZE = 3;
+
+void prepareTool(sgpEntityIslandToolGa &tool)
+{
+  tool.setIslandLimit(ISLAND_LIMIT);
+  tool.setIslandIdPos(ISLAND_ID_POS);
+  tool.setBitSize(ISLAND_BIT_SIZE);
+}
+
+void prepareGenome(sgpGaGenome &genome)
+{
+  genome.resize(GENOME_SIZE);
+  for(uint i = 0; i != GENOME_SIZE; i++)
+    genome[i].setAsUInt(0);
+}
+
+uint readIslandId(sgpEntityIslandToolGa &tool, const sgpEntityBase &entity)
+{
+  uint res = ISLAND_LIMIT;
+  BOOST_REQUIRE(tool.getIslandId(entity, res));
+  return res;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(setAndGetRoundTrip)
+{
+  sgpEntityIslandToolGa tool;
+  sgpEntityForGaUInt entity;
+  sgpGaGenome genome;
+
+  prepareTool(tool);
+  prepareGenome(genome);
+  entity.setGenome(genome);
+
+  for(uint islandId = 0; islandId != ISLAND_LIMIT; islandId++) {
+    tool.setIslandId(entity, islandId);
+    BOOST_CHECK_EQUAL(readIslandId(tool, entity), islandId);
+    // second read is served from cache
+    BOOST_CHECK_EQUAL(readIslandId(tool, entity), islandId);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(directGenomeWriteIsDetected)
+{
+  sgpEntityIslandToolGa tool;
+  sgpEntityForGaUInt entity;
+  sgpGaGenome genome;
+  uint itemCount;
+
+  prepareTool(tool);
+  prepareGenome(genome);
+  entity.setGenome(genome);
+
+  tool.setIslandId(entity, 3);
+  BOOST_CHECK_EQUAL(readIslandId(tool, entity), 3u);
+
+  // no explicit invalidation - cache is keyed by raw gene value
+  uint *data = entity.modifyGenomeData(0, itemCount);
+  BOOST_REQUIRE_EQUAL(itemCount, GENOME_SIZE);
+  data[ISLAND_ID_POS] = binToGray(5u, ISLAND_BIT_SIZE);
+  BOOST_CHECK_EQUAL(readIslandId(tool, entity), 5u);
+
+  // other genes do not change island id
+  data[0] = 7;
+  BOOST_CHECK_EQUAL(readIslandId(tool, entity), 5u);
+}
+
+BOOST_AUTO_TEST_CASE(copyKeepsIndependentCache)
+{
+  sgpEntityIslandToolGa tool;
+  sgpEntityForGaUInt entity;
+  sgpGaGenome genome;
+
+  prepareTool(tool);
+  prepareGenome(genome);
+  entity.setGenome(genome);
+  tool.setIslandId(entity, 2);
+  BOOST_CHECK_EQUAL(readIslandId(tool, entity), 2u);
+
+  sgpEntityForGaUInt copy(entity);
+  BOOST_CHECK_EQUAL(readIslandId(tool, copy), 2u);
+
+  tool.setIslandId(copy, 6);
+  BOOST_CHECK_EQUAL(readIslandId(tool, copy), 6u);
+  BOOST_CHECK_EQUAL(readIslandId(tool, entity), 2u);
+
+  entity = copy;
+  BOOST_CHECK_EQUAL(readIslandId(tool, entity), 6u);
+}
+
+BOOST_AUTO_TEST_CASE(islandLimitIsAppliedAfterCache)
+{
+  sgpEntityIslandToolGa tool;
+  sgpEntityForGaUInt entity;
+  sgpGaGenome genome;
+
+  prepareTool(tool);
+  prepareGenome(genome);
+  entity.setGenome(genome);
+  tool.setIslandId(entity, 5);
+  BOOST_CHECK_EQUAL(readIslandId(tool, entity), 5u);
+
+  tool.setIslandLimit(4);
+  BOOST_CHECK_EQUAL(readIslandId(tool, entity), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(varTypeGenomeInvalidatesCacheOnWrite)
+{
+  sgpEntityIslandToolGa tool;
+  sgpEntityForGaVarType entity;
+  sgpGaGenome genome;
+
+  prepareTool(tool);
+  prepareGenome(genome);
+  entity.setGenome(genome);
+
+  tool.setIslandId(entity, 4);
+  BOOST_CHECK_EQUAL(readIslandId(tool, entity), 4u);
+
+  // setGenomeItem on island gene position
+  tool.setIslandId(entity, 1);
+  BOOST_CHECK_EQUAL(readIslandId(tool, entity), 1u);
+
+  // whole genome replaced
+  genome[ISLAND_ID_POS].setAsUInt(binToGray(7u, ISLAND_BIT_SIZE));
+  entity.setGenome(genome);
+  BOOST_CHECK_EQUAL(readIslandId(tool, entity), 7u);
+
+  // other genome item does not touch cache
+  entity.setGenomeItem(0, 0, scDataNode(3u));
+  BOOST_CHECK_EQUAL(readIslandId(tool, entity), 7u);
+}
+
+BOOST_AUTO_TEST_CASE(bitSizeChangeIsDetected)
+{
+  const uint islandLimit = 16;
+  const uint gene = binToGray(12u, ISLAND_BIT_SIZE);
+  sgpEntityIslandToolGa tool;
+  sgpEntityForGaUInt uintEntity;
+  sgpEntityForGaVarType varEntity;
+  sgpGaGenome genome;
+
+  prepareTool(tool);
+  tool.setIslandLimit(islandLimit);
+  prepareGenome(genome);
+  genome[ISLAND_ID_POS].setAsUInt(gene);
+  uintEntity.setGenome(genome);
+  varEntity.setGenome(genome);
+
+  uint expectedOld = grayToBin(gene, ISLAND_BIT_SIZE) % islandLimit;
+  uint expectedNew = grayToBin(gene, ISLAND_BIT_SIZE - 1) % islandLimit;
+  BOOST_REQUIRE(expectedOld != expectedNew);
+
+  BOOST_CHECK_EQUAL(readIslandId(tool, uintEntity), expectedOld);
+  BOOST_CHECK_EQUAL(readIslandId(tool, varEntity), expectedOld);
+
+  // same entities, same genes - decoded again with new bit size
+  tool.setBitSize(ISLAND_BIT_SIZE - 1);
+  BOOST_CHECK_EQUAL(readIslandId(tool, uintEntity), expectedNew);
+  BOOST_CHECK_EQUAL(readIslandId(tool, varEntity), expectedNew);
+}
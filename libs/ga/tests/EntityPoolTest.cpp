@@ -0,0 +1,199 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        EntityPoolTest.cpp
+// Project:     sgpLib
+// Purpose:     Unit tests for sgpEntityPool.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#define BOOST_TEST_MODULE EntityPoolTest
+#include <boost/test/unit_test.hpp>
+
+//std
+#include <memory>
+#include <vector>
+
+//sgp
+#include "sgp/EntityPool.h"
+#include "sgp/GaGenerationUInt.h"
+#include "sgp/EntityForGaUInt.h"
+
+namespace {
+
+sgpEntityBase *addItem(uint first, uint second, double fitness, sgpGaGeneration &output)
+{
+  sgpGaGenome genome(2);
+  genome[0].setAsUInt(first);
+  genome[1].setAsUInt(second);
+
+  sgpEntityBase *item = output.newItem();
+  item->setGenome(0, genome);
+  item->setFitness(0, fitness);
+  output.insert(item);
+  return item;
+}
+
+uint getGenomeSize(const sgpEntityBase &item)
+{
+  uint itemCount;
+  item.getGenomeData(0, itemCount);
+  return itemCount;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(releasedEntityIsReused)
+{
+  sgpGaGenerationUInt generation;
+  const sgpEntityPoolPtr &pool = generation.getPool();
+
+  sgpEntityBase *first = addItem(1, 2, 3.5, generation);
+  BOOST_CHECK(first->getPool() == pool);
+  BOOST_CHECK_EQUAL(pool->getAllocCount(), 1u);
+
+  generation.clear();
+  BOOST_CHECK_EQUAL(pool->size(), 1u);
+  BOOST_CHECK(!first->getPool());
+
+  // recycled entity is reset
+  sgpEntityBase *second = generation.newItem();
+  generation.insert(second);
+  BOOST_CHECK(second == first);
+  BOOST_CHECK(second->getPool() == pool);
+  BOOST_CHECK_EQUAL(getGenomeSize(*second), 0u);
+  BOOST_CHECK_EQUAL(second->getFitness(0), 0.0);
+  BOOST_CHECK_EQUAL(pool->size(), 0u);
+  BOOST_CHECK_EQUAL(pool->getReuseCount(), 1u);
+  BOOST_CHECK_EQUAL(pool->getAllocCount(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(recycledCloneCopiesSource)
+{
+  sgpGaGenerationUInt generation;
+  const sgpEntityPoolPtr &pool = generation.getPool();
+
+  sgpEntityBase *released = addItem(1, 2, 3.5, generation);
+  generation.clear();
+  BOOST_REQUIRE_EQUAL(pool->size(), 1u);
+
+  sgpEntityForGaUInt source;
+  sgpGaGenome genome(2);
+  genome[0].setAsUInt(7);
+  genome[1].setAsUInt(8);
+  source.setGenome(0, genome);
+  source.setFitness(0, 9.5);
+
+  sgpEntityBase *clone = generation.newItem(source);
+  generation.insert(clone);
+  BOOST_CHECK(clone == released);
+  BOOST_CHECK(clone->getPool() == pool);
+  BOOST_CHECK(!source.getPool());
+
+  uint itemCount;
+  const uint *data = clone->getGenomeData(0, itemCount);
+  BOOST_REQUIRE_EQUAL(itemCount, 2u);
+  BOOST_CHECK_EQUAL(data[0], 7u);
+  BOOST_CHECK_EQUAL(data[1], 8u);
+  BOOST_CHECK_EQUAL(clone->getFitness(0), 9.5);
+}
+
+BOOST_AUTO_TEST_CASE(emptyGenerationSharesPool)
+{
+  sgpGaGenerationUInt generation;
+  std::auto_ptr<sgpGaGeneration> other(generation.newEmpty());
+  const sgpEntityPoolPtr &pool = generation.getPool();
+
+  for(uint i = 0; i != 3; i++)
+    addItem(i, i, i, *other);
+  BOOST_CHECK_EQUAL(pool->getAllocCount(), 3u);
+
+  other.reset();
+  BOOST_CHECK_EQUAL(pool->size(), 3u);
+
+  for(uint i = 0; i != 3; i++)
+    addItem(i, i, i, generation);
+  BOOST_CHECK_EQUAL(pool->size(), 0u);
+  BOOST_CHECK_EQUAL(pool->getReuseCount(), 3u);
+  BOOST_CHECK_EQUAL(pool->getAllocCount(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(transferredEntityReturnsToOwnPool)
+{
+  sgpGaGenerationUInt target;
+  sgpEntityPoolPtr sourcePool;
+
+  {
+    sgpGaGenerationUInt source;
+    sourcePool = source.getPool();
+    addItem(1, 2, 3.0, source);
+    addItem(3, 4, 5.0, source);
+    target.transferItemsFrom(source);
+  }
+
+  BOOST_REQUIRE_EQUAL(target.size(), 2u);
+  BOOST_CHECK(target.at(0).getPool() == sourcePool);
+
+  target.clear();
+  BOOST_CHECK_EQUAL(sourcePool->size(), 2u);
+  BOOST_CHECK_EQUAL(target.getPool()->size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(entityKeepsPoolAlive)
+{
+  std::auto_ptr<sgpEntityBase> item;
+
+  {
+    sgpGaGenerationUInt generation;
+    addItem(1, 2, 3.0, generation);
+    item.reset(generation.extractItem(0));
+  }
+
+  // generation is gone, pool is referenced by entity only
+  BOOST_REQUIRE(item->getPool());
+  BOOST_CHECK_EQUAL(item->getPool()->size(), 0u);
+
+  // pool is released together with entity, without double delete
+  sgpEntityPool::dispose(item.release());
+}
+
+BOOST_AUTO_TEST_CASE(capacityLimitsKeptEntities)
+{
+  sgpGaGenerationUInt generation;
+  const sgpEntityPoolPtr &pool = generation.getPool();
+
+  pool->setCapacity(2);
+  for(uint i = 0; i != 4; i++)
+    addItem(i, i, i, generation);
+  generation.clear();
+  BOOST_CHECK_EQUAL(pool->size(), 2u);
+
+  pool->setCapacity(1);
+  BOOST_CHECK_EQUAL(pool->size(), 1u);
+
+  pool->setCapacity(0);
+  for(uint i = 0; i != 4; i++)
+    addItem(i, i, i, generation);
+  generation.clear();
+  BOOST_CHECK_EQUAL(pool->size(), 4u);
+
+  pool->clear();
+  BOOST_CHECK_EQUAL(pool->size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(countersReportPoolUsage)
+{
+  sgpGaGenerationUInt generation;
+  const sgpEntityPoolPtr &pool = generation.getPool();
+
+  addItem(1, 2, 3.0, generation);
+  generation.clear();
+  addItem(1, 2, 3.0, generation);
+  addItem(1, 2, 3.0, generation);
+
+  scDataNode counters;
+  pool->getCounters(counters);
+  BOOST_CHECK_EQUAL(counters["gx-epool-reuse"].getAsUInt64(), 1u);
+  BOOST_CHECK_EQUAL(counters["gx-epool-alloc"].getAsUInt64(), 2u);
+  BOOST_CHECK_EQUAL(counters["gx-epool-size"].getAsUInt(), 0u);
+}
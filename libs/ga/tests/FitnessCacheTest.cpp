@@ -0,0 +1,146 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        FitnessCacheTest.cpp
+// Project:     sgpLib
+// Purpose:     Unit tests for sgpFitnessCache.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#define BOOST_TEST_MODULE FitnessCacheTest
+#include <boost/test/unit_test.hpp>
+
+//sgp
+#include "sgp/FitnessCache.h"
+#include "sgp/EntityForGaUInt.h"
+#include "sgp/EntityForGaVarType.h"
+
+namespace {
+
+void setUIntGenome(uint first, uint second, sgpEntityBase &output)
+{
+  sgpGaGenome genome(2);
+  genome[0].setAsUInt(first);
+  genome[1].setAsUInt(second);
+  output.setGenome(0, genome);
+}
+
+void makeFitness(double value, sgpFitnessValue &output)
+{
+  output.resize(2);
+  output.setValue(0, value);
+  output.setValue(1, -value);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(missThenHit)
+{
+  sgpFitnessCache cache(16);
+  sgpEntityForGaUInt entity, sameGenome, otherGenome;
+  sgpFitnessValue fitness, found;
+
+  setUIntGenome(1, 2, entity);
+  setUIntGenome(1, 2, sameGenome);
+  setUIntGenome(2, 1, otherGenome);
+  makeFitness(3.5, fitness);
+
+  BOOST_CHECK(!cache.find(entity, found));
+  cache.insert(entity, fitness);
+  BOOST_CHECK_EQUAL(cache.size(), 1u);
+
+  BOOST_REQUIRE(cache.find(sameGenome, found));
+  BOOST_REQUIRE_EQUAL(found.size(), 2u);
+  BOOST_CHECK_EQUAL(found.getValue(0), 3.5);
+  BOOST_CHECK_EQUAL(found.getValue(1), -3.5);
+
+  BOOST_CHECK(!cache.find(otherGenome, found));
+
+  BOOST_CHECK_EQUAL(cache.getHitCount(), 1u);
+  BOOST_CHECK_EQUAL(cache.getMissCount(), 2u);
+  cache.resetCounters();
+  BOOST_CHECK_EQUAL(cache.getMissCount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(keyFromFindIsUsedForInsert)
+{
+  sgpFitnessCache cache(16);
+  sgpEntityForGaUInt entity;
+  sgpFitnessValue fitness, found;
+  sgpGenomeKey key, entityKey;
+  sgpGaGenome genomeBuffer;
+
+  setUIntGenome(7, 9, entity);
+  makeFitness(1.0, fitness);
+
+  BOOST_REQUIRE(!cache.find(entity, found, key));
+  sgpFitnessCache::calcKey(entity, entityKey, genomeBuffer);
+  BOOST_CHECK_EQUAL(key.hash, entityKey.hash);
+  BOOST_CHECK_EQUAL(key.check, entityKey.check);
+
+  cache.insert(key, fitness);
+  BOOST_REQUIRE(cache.find(entity, found));
+  BOOST_CHECK_EQUAL(found.getValue(0), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(clockEvictionKeepsReferencedEntries)
+{
+  sgpFitnessCache cache(2);
+  sgpEntityForGaUInt first, second, third;
+  sgpFitnessValue fitness, found;
+
+  setUIntGenome(1, 0, first);
+  setUIntGenome(2, 0, second);
+  setUIntGenome(3, 0, third);
+
+  makeFitness(1.0, fitness);
+  cache.insert(first, fitness);
+  makeFitness(2.0, fitness);
+  cache.insert(second, fitness);
+
+  // first is referenced, second is the next victim
+  BOOST_REQUIRE(cache.find(first, found));
+
+  makeFitness(3.0, fitness);
+  cache.insert(third, fitness);
+  BOOST_CHECK_EQUAL(cache.size(), 2u);
+
+  BOOST_CHECK(cache.find(first, found));
+  BOOST_CHECK(!cache.find(second, found));
+  BOOST_REQUIRE(cache.find(third, found));
+  BOOST_CHECK_EQUAL(found.getValue(0), 3.0);
+
+  cache.setCapacity(4);
+  BOOST_CHECK_EQUAL(cache.size(), 0u);
+  BOOST_CHECK_EQUAL(cache.getCapacity(), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(varTypeGenomes)
+{
+  sgpFitnessCache cache(16);
+  sgpEntityForGaVarType entity, sameGenome, otherType;
+  sgpGaGenome genome(3);
+  sgpFitnessValue fitness, found;
+
+  genome[0].setAsUInt(4);
+  genome[1].setAsDouble(0.25);
+  genome[2].setAsString("abc");
+  entity.setGenome(genome);
+  sameGenome.setGenome(genome);
+
+  // same bits, different value type
+  genome[0].setAsInt(4);
+  otherType.setGenome(genome);
+
+  makeFitness(5.0, fitness);
+  cache.insert(entity, fitness);
+
+  BOOST_REQUIRE(cache.find(sameGenome, found));
+  BOOST_CHECK_EQUAL(found.getValue(0), 5.0);
+  BOOST_CHECK(!cache.find(otherType, found));
+
+  genome[0].setAsUInt(4);
+  genome[2].setAsString("abd");
+  sameGenome.setGenome(genome);
+  BOOST_CHECK(!cache.find(sameGenome, found));
+}
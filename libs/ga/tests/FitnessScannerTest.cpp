@@ -0,0 +1,142 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        FitnessScannerTest.cpp
+// Project:     sgpLib
+// Purpose:     Unit tests for top-K selection in sgpFitnessScanner.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#define BOOST_TEST_MODULE FitnessScannerTest
+#include <boost/test/unit_test.hpp>
+
+//std
+#include <limits>
+#include <vector>
+
+//sc
+#include "sc/dtypes.h"
+
+//sgp
+#include "sgp/FitnessScanner.h"
+
+namespace {
+
+const uint ROW_COUNT = 6;
+
+// objective 0: value 5 repeated at 1, 2, 4
+// objective 1: NaN at 1 and 5, value 4 repeated at 2, 3
+void buildFitness(scDataNode &output)
+{
+  const double nanValue = std::numeric_limits<double>::quiet_NaN();
+  const double values[ROW_COUNT][2] = {
+    {3.0, 1.0}, {5.0, nanValue}, {5.0, 4.0}, {1.0, 4.0}, {5.0, 0.0}, {2.0, nanValue}
+  };
+
+  output = scDataNode(ict_list);
+  for(uint i = 0; i != ROW_COUNT; i++) {
+    scDataNode row(ict_array, vt_double);
+    row.addItemAsDouble(values[i][0]);
+    row.addItemAsDouble(values[i][1]);
+    output.addItem(row);
+  }
+}
+
+void checkIndices(const sgpEntityIndexList &indices, const uint *expected, uint expectedCount)
+{
+  BOOST_REQUIRE_EQUAL(indices.size(), expectedCount);
+  for(uint i = 0; i != expectedCount; i++)
+    BOOST_CHECK_EQUAL(indices[i], expected[i]);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(distinctModeReturnsFirstItemOfEachValue)
+{
+  scDataNode fitness;
+  sgpEntityIndexList indices;
+  buildFitness(fitness);
+  sgpFitnessScanner scanner(&fitness);
+
+  const uint expectedTop3[] = {1, 0, 5};
+  scanner.getTopIndicesByObjective(3, 0, ttmDistinct, indices);
+  checkIndices(indices, expectedTop3, 3);
+
+  // limit above number of distinct values
+  const uint expectedAll[] = {1, 0, 5, 3};
+  scanner.getTopIndicesByObjective(10, 0, ttmDistinct, indices);
+  checkIndices(indices, expectedAll, 4);
+}
+
+BOOST_AUTO_TEST_CASE(keepAllModeOrdersEqualValuesByIndex)
+{
+  scDataNode fitness;
+  sgpEntityIndexList indices;
+  buildFitness(fitness);
+  sgpFitnessScanner scanner(&fitness);
+
+  const uint expectedTop3[] = {1, 2, 4};
+  scanner.getTopIndicesByObjective(3, 0, ttmKeepAll, indices);
+  checkIndices(indices, expectedTop3, 3);
+
+  const uint expectedAll[] = {1, 2, 4, 0, 5, 3};
+  scanner.getTopIndicesByObjective(10, 0, ttmKeepAll, indices);
+  checkIndices(indices, expectedAll, ROW_COUNT);
+}
+
+BOOST_AUTO_TEST_CASE(nanValuesAreSkipped)
+{
+  scDataNode fitness;
+  sgpEntityIndexList indices;
+  buildFitness(fitness);
+  sgpFitnessScanner scanner(&fitness);
+
+  const uint expectedDistinct[] = {2, 0};
+  scanner.getTopIndicesByObjective(2, 1, ttmDistinct, indices);
+  checkIndices(indices, expectedDistinct, 2);
+
+  const uint expectedAll[] = {2, 3, 0, 4};
+  scanner.getTopIndicesByObjective(10, 1, ttmKeepAll, indices);
+  checkIndices(indices, expectedAll, 4);
+}
+
+BOOST_AUTO_TEST_CASE(emptyLimitGivesEmptyResult)
+{
+  scDataNode fitness;
+  sgpEntityIndexList indices;
+  buildFitness(fitness);
+  sgpFitnessScanner scanner(&fitness);
+
+  indices.push_back(1);
+  scanner.getTopIndicesByObjective(0, 0, ttmKeepAll, indices);
+  BOOST_CHECK(indices.empty());
+
+  indices.push_back(1);
+  scanner.getTopGenomesByObjective(-1, 0, indices);
+  BOOST_CHECK(indices.empty());
+}
+
+BOOST_AUTO_TEST_CASE(multiObjectiveMatchesSingleObjective)
+{
+  scDataNode fitness;
+  sgpEntityIndexList single;
+  std::vector<sgpEntityIndexList> multi;
+  std::vector<uint> objectives;
+  buildFitness(fitness);
+  sgpFitnessScanner scanner(&fitness);
+
+  objectives.push_back(1);
+  objectives.push_back(0);
+
+  for(uint mode = ttmDistinct; mode <= ttmKeepAll; mode++) {
+    sgpTopTieMode tieMode = static_cast<sgpTopTieMode>(mode);
+    for(uint limit = 0; limit <= ROW_COUNT; limit++) {
+      scanner.getTopIndicesByObjectives(limit, objectives, tieMode, multi);
+      BOOST_REQUIRE_EQUAL(multi.size(), objectives.size());
+      for(uint j = 0; j != objectives.size(); j++) {
+        scanner.getTopIndicesByObjective(limit, objectives[j], tieMode, single);
+        BOOST_CHECK(multi[j] == single);
+      }
+    }
+  }
+}
@@ -0,0 +1,204 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        FitnessValueTest.cpp
+// Project:     sgpLib
+// Purpose:     Unit tests for sgpFitnessValue.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#define BOOST_TEST_MODULE FitnessValueTest
+#include <boost/test/unit_test.hpp>
+
+//sgp
+#include "sgp/FitnessValue.h"
+
+namespace {
+
+const uint HEAP_SIZE = sgpFitnessValue::INLINE_CAPACITY + 3;
+
+void fillValues(uint count, double base, sgpFitnessValue &output)
+{
+  output.resize(count);
+  for(uint i = 0; i != count; i++)
+    output.setValue(i, base + i);
+}
+
+void checkValues(const sgpFitnessValue &value, uint count, double base)
+{
+  BOOST_REQUIRE_EQUAL(value.size(), count);
+  for(uint i = 0; i != count; i++)
+    BOOST_CHECK_EQUAL(value.getValue(i), base + i);
+}
+
+// storage is inside of object
+bool isInline(const sgpFitnessValue &value)
+{
+  const char *data = reinterpret_cast<const char *>(value.getData());
+  const char *obj = reinterpret_cast<const char *>(&value);
+  return (data >= obj) && (data < obj + sizeof(value));
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(defaultIsSingleInlineZero)
+{
+  sgpFitnessValue value;
+
+  BOOST_CHECK_EQUAL(value.size(), 1u);
+  BOOST_CHECK_EQUAL(value.getValue(0), 0.0);
+  BOOST_CHECK(isInline(value));
+  BOOST_CHECK(!value.isBound());
+}
+
+BOOST_AUTO_TEST_CASE(resizeWithinInlineCapacity)
+{
+  sgpFitnessValue value;
+
+  fillValues(sgpFitnessValue::INLINE_CAPACITY, 1.0, value);
+
+  BOOST_CHECK(isInline(value));
+  checkValues(value, sgpFitnessValue::INLINE_CAPACITY, 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(growToHeapAndShrinkBack)
+{
+  sgpFitnessValue value;
+
+  fillValues(sgpFitnessValue::INLINE_CAPACITY, 1.0, value);
+  value.resize(HEAP_SIZE);
+
+  BOOST_CHECK(!isInline(value));
+  BOOST_CHECK(!value.isBound());
+  for(uint i = 0; i != sgpFitnessValue::INLINE_CAPACITY; i++)
+    BOOST_CHECK_EQUAL(value.getValue(i), 1.0 + i);
+  for(uint i = sgpFitnessValue::INLINE_CAPACITY; i != HEAP_SIZE; i++)
+    BOOST_CHECK_EQUAL(value.getValue(i), 0.0);
+
+  // single value returns to inline buffer
+  value.resize(1);
+  BOOST_CHECK(isInline(value));
+  BOOST_CHECK_EQUAL(value.size(), 1u);
+  BOOST_CHECK_EQUAL(value.getValue(0), 1.0);
+
+  fillValues(HEAP_SIZE, 5.0, value);
+  checkValues(value, HEAP_SIZE, 5.0);
+}
+
+BOOST_AUTO_TEST_CASE(copyAndAssignAreIndependent)
+{
+  sgpFitnessValue heapValue, inlineValue;
+
+  fillValues(HEAP_SIZE, 10.0, heapValue);
+  fillValues(2, 20.0, inlineValue);
+
+  sgpFitnessValue heapCopy(heapValue);
+  checkValues(heapCopy, HEAP_SIZE, 10.0);
+  BOOST_CHECK(heapCopy.getData() != heapValue.getData());
+
+  heapCopy.setValue(0, -1.0);
+  BOOST_CHECK_EQUAL(heapValue.getValue(0), 10.0);
+
+  // shorter vector keeps allocated storage
+  heapCopy = inlineValue;
+  checkValues(heapCopy, 2, 20.0);
+  BOOST_CHECK(!isInline(heapCopy));
+
+  // inline to heap
+  inlineValue = heapValue;
+  checkValues(inlineValue, HEAP_SIZE, 10.0);
+
+  inlineValue = inlineValue;
+  checkValues(inlineValue, HEAP_SIZE, 10.0);
+
+  sgpFitnessValue single;
+  single.setValue(0, 7.0);
+  inlineValue = single;
+  BOOST_CHECK_EQUAL(inlineValue.size(), 1u);
+  BOOST_CHECK_EQUAL(inlineValue.getValue(0), 7.0);
+  BOOST_CHECK(isInline(inlineValue));
+}
+
+BOOST_AUTO_TEST_CASE(boundValueWritesToBuffer)
+{
+  double buffer[3] = {0.0, 0.0, 0.0};
+  sgpFitnessValue value, source;
+
+  value.bind(buffer, 3);
+  BOOST_CHECK(value.isBound());
+
+  fillValues(3, 1.0, value);
+  BOOST_CHECK(value.getData() == buffer);
+  BOOST_CHECK_EQUAL(buffer[2], 3.0);
+
+  // assignment keeps binding while values fit
+  fillValues(2, 4.0, source);
+  value = source;
+  BOOST_CHECK(value.isBound());
+  BOOST_CHECK_EQUAL(buffer[0], 4.0);
+  BOOST_CHECK_EQUAL(buffer[1], 5.0);
+
+  value.resize(1);
+  BOOST_CHECK(value.isBound());
+  BOOST_CHECK_EQUAL(value.getValue(0), 4.0);
+
+  // copy owns its storage
+  fillValues(3, 1.0, value);
+  sgpFitnessValue copy(value);
+  BOOST_CHECK(!copy.isBound());
+  copy.setValue(0, -1.0);
+  BOOST_CHECK_EQUAL(buffer[0], 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(boundValueMovesToHeapWhenTooLong)
+{
+  double buffer[2] = {0.0, 0.0};
+  sgpFitnessValue value;
+
+  value.bind(buffer, 2);
+  fillValues(2, 1.0, value);
+  value.resize(HEAP_SIZE);
+
+  BOOST_CHECK(!value.isBound());
+  BOOST_CHECK(value.getData() != buffer);
+  BOOST_CHECK_EQUAL(value.getValue(0), 1.0);
+  BOOST_CHECK_EQUAL(value.getValue(1), 2.0);
+
+  value.setValue(0, -1.0);
+  BOOST_CHECK_EQUAL(buffer[0], 1.0);
+
+  // rebinding releases heap storage
+  value.bind(buffer, 2);
+  BOOST_CHECK(value.isBound());
+  BOOST_CHECK_EQUAL(value.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(clearedValueCanGrow)
+{
+  sgpFitnessValue value;
+
+  fillValues(3, 1.0, value);
+  value.clear();
+  BOOST_CHECK_EQUAL(value.size(), 0u);
+
+  value.resize(HEAP_SIZE);
+  BOOST_REQUIRE_EQUAL(value.size(), HEAP_SIZE);
+  for(uint i = 0; i != HEAP_SIZE; i++)
+    BOOST_CHECK_EQUAL(value.getValue(i), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(compareReportsRelation)
+{
+  sgpFitnessValue first, second;
+
+  fillValues(3, 1.0, first);
+  fillValues(3, 1.0, second);
+  BOOST_CHECK_EQUAL(first.compare(second), 0);
+
+  second.setValue(1, 5.0);
+  BOOST_CHECK_EQUAL(first.compare(second), -2);
+  BOOST_CHECK_EQUAL(second.compare(first), 2);
+
+  second.setValue(2, 0.0);
+  BOOST_CHECK_EQUAL(first.compare(second), 1);
+}
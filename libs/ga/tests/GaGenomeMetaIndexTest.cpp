@@ -0,0 +1,174 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        GaGenomeMetaIndexTest.cpp
+// Project:     sgpLib
+// Purpose:     Unit tests for sgpGaGenomeMetaIndex.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#define BOOST_TEST_MODULE GaGenomeMetaIndexTest
+#include <boost/test/unit_test.hpp>
+
+//std
+#include <vector>
+
+//sgp
+#include "sgp/GaGenomeMetaIndex.h"
+
+namespace {
+
+void buildMeta(const uint *sizes, uint count, sgpGaGenomeMetaList &output)
+{
+  sgpGaGenomeMetaInfo info;
+  info.genType = gagtRanged;
+  info.minValue = scDataNode(0u);
+  info.maxValue = scDataNode(255u);
+  info.userType = 0;
+
+  output.clear();
+  for(uint i = 0; i != count; i++) {
+    info.genSize = sizes[i];
+    output.push_back(info);
+  }
+}
+
+// linear scan over variables
+uint findVarRef(const sgpGaGenomeMetaList &meta, uint point)
+{
+  uint offset = 0;
+  for(uint i = 0; i != meta.size(); i++) {
+    if ((point >= offset) && (point < offset + meta[i].genSize))
+      return i;
+    offset += meta[i].genSize;
+  }
+  return meta.size();
+}
+
+uint findVarFromRef(const sgpGaGenomeMetaList &meta, uint point)
+{
+  uint offset = 0;
+  for(uint i = 0; i != meta.size(); i++) {
+    if ((offset >= point) && (meta[i].genSize > 0))
+      return i;
+    offset += meta[i].genSize;
+  }
+  return meta.size();
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(emptyMetaHasNoPoints)
+{
+  sgpGaGenomeMetaList meta;
+  sgpGaGenomeMetaIndex index;
+
+  index.build(meta);
+
+  BOOST_CHECK_EQUAL(index.getPointCount(), 0u);
+  BOOST_CHECK_EQUAL(index.getVarCount(), 0u);
+  BOOST_CHECK_EQUAL(index.findVar(0), 0u);
+  BOOST_CHECK_EQUAL(index.findVarFrom(0), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(zeroSizeVarsAreSkipped)
+{
+  const uint sizes[] = {0, 2, 0, 0, 3, 1, 0};
+  sgpGaGenomeMetaList meta;
+  sgpGaGenomeMetaIndex index;
+
+  buildMeta(sizes, 7, meta);
+  index.build(meta);
+
+  BOOST_CHECK_EQUAL(index.getPointCount(), 6u);
+  BOOST_CHECK_EQUAL(index.getVarCount(), 7u);
+  BOOST_CHECK_EQUAL(index.getVarOffset(1), 0u);
+  BOOST_CHECK_EQUAL(index.getVarOffset(4), 2u);
+  BOOST_CHECK_EQUAL(index.getVarOffset(6), 6u);
+
+  const uint expectedVar[] = {1, 1, 4, 4, 4, 5};
+  for(uint p = 0; p != 6; p++)
+    BOOST_CHECK_EQUAL(index.findVar(p), expectedVar[p]);
+  // outside of genome
+  BOOST_CHECK_EQUAL(index.findVar(6), 7u);
+  BOOST_CHECK_EQUAL(index.findVar(100), 7u);
+
+  const uint expectedFrom[] = {1, 4, 4, 5, 5, 5, 7};
+  for(uint p = 0; p != 7; p++)
+    BOOST_CHECK_EQUAL(index.findVarFrom(p), expectedFrom[p]);
+}
+
+BOOST_AUTO_TEST_CASE(onlyZeroSizeVars)
+{
+  const uint sizes[] = {0, 0, 0};
+  sgpGaGenomeMetaList meta;
+  sgpGaGenomeMetaIndex index;
+
+  buildMeta(sizes, 3, meta);
+  index.build(meta);
+
+  BOOST_CHECK_EQUAL(index.getPointCount(), 0u);
+  BOOST_CHECK_EQUAL(index.getVarCount(), 3u);
+  BOOST_CHECK_EQUAL(index.findVar(0), 3u);
+  BOOST_CHECK_EQUAL(index.findVarFrom(0), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(directTableMatchesLinearScan)
+{
+  const uint sizes[] = {3, 0, 1, 7, 0, 0, 2, 5, 0, 1};
+  sgpGaGenomeMetaList meta;
+  sgpGaGenomeMetaIndex index;
+
+  buildMeta(sizes, 10, meta);
+  index.build(meta);
+
+  for(uint p = 0; p <= index.getPointCount() + 1; p++) {
+    BOOST_CHECK_EQUAL(index.findVar(p), findVarRef(meta, p));
+    BOOST_CHECK_EQUAL(index.findVarFrom(p), findVarFromRef(meta, p));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(binarySearchMatchesLinearScan)
+{
+  // above direct table limit
+  const uint sizes[] = {SGP_GA_META_INDEX_DIRECT_LIMIT, 0, 10, 0, 3};
+  sgpGaGenomeMetaList meta;
+  sgpGaGenomeMetaIndex index;
+
+  buildMeta(sizes, 5, meta);
+  index.build(meta);
+
+  BOOST_REQUIRE(index.getPointCount() > SGP_GA_META_INDEX_DIRECT_LIMIT);
+
+  const uint limit = SGP_GA_META_INDEX_DIRECT_LIMIT;
+  const uint points[] = {0, 1, limit - 1, limit, limit + 1, limit + 9, limit + 10, limit + 12, limit + 13, limit + 100};
+  for(uint i = 0; i != 10; i++) {
+    BOOST_CHECK_EQUAL(index.findVar(points[i]), findVarRef(meta, points[i]));
+    BOOST_CHECK_EQUAL(index.findVarFrom(points[i]), findVarFromRef(meta, points[i]));
+  }
+
+  BOOST_CHECK_EQUAL(index.findVar(limit), 2u);
+  BOOST_CHECK_EQUAL(index.findVarFrom(1), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(rebuildReplacesIndex)
+{
+  const uint sizes[] = {2, 2};
+  const uint sizes2[] = {0, 1};
+  sgpGaGenomeMetaList meta;
+  sgpGaGenomeMetaIndex index;
+
+  buildMeta(sizes, 2, meta);
+  index.build(meta);
+  BOOST_CHECK_EQUAL(index.findVar(3), 1u);
+
+  buildMeta(sizes2, 2, meta);
+  index.build(meta);
+  BOOST_CHECK_EQUAL(index.getPointCount(), 1u);
+  BOOST_CHECK_EQUAL(index.findVar(0), 1u);
+  BOOST_CHECK_EQUAL(index.findVar(3), 2u);
+
+  index.clear();
+  BOOST_CHECK_EQUAL(index.getPointCount(), 0u);
+  BOOST_CHECK_EQUAL(index.getVarCount(), 0u);
+}
@@ -0,0 +1,542 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        GaOperatorBasicTest.cpp
+// Project:     sgpLib
+// Purpose:     Unit tests for basic GA operators.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#define BOOST_TEST_MODULE GaOperatorBasicTest
+#include <boost/test/unit_test.hpp>
+
+//std
+#include <cmath>
+#include <vector>
+
+//sgp
+#include "sgp/GaOperatorBasic.h"
+#include "sgp/GaGenerationUInt.h"
+#include "sgp/RandomStream.h"
+#include "sgp/EvalFltClearNan.h"
+#include "sgp/EvalFltNormProb.h"
+
+namespace {
+
+/// objective #1 = first gene, postProcess doubles it (not repeatable)
+class sgpScalingFitnessFunction: public sgpFitnessFunctionEx {
+public:
+  sgpScalingFitnessFunction(bool incrementalSupported): m_incrementalSupported(incrementalSupported), m_calcCount(0) {}
+  virtual int getFunctionId() const { return 1; }
+  virtual uint getObjectiveCount() const { return 2; }
+  virtual bool isIncrementalSupported() const { return m_incrementalSupported; }
+
+  virtual bool calc(uint entityIndex, const sgpEntityBase *entity, sgpFitnessValue &fitness) const {
+    sgpGaGenome genome;
+    entity->getGenome(0, genome);
+    fitness.resize(getObjectiveCount());
+    fitness.setValue(0, 0.0);
+    fitness.setValue(1, genome[0].getAsUInt());
+    m_calcCount++;
+    return true;
+  }
+
+  virtual bool postProcess(sgpGaGeneration &newGeneration) {
+    if (!m_incrementalSupported)
+      for(uint i = 0; i != newGeneration.size(); i++)
+        newGeneration.at(i).setFitness(1, 2.0 * newGeneration.at(i).getFitness(1));
+    return true;
+  }
+
+  uint getCalcCount() const { return m_calcCount; }
+private:
+  bool m_incrementalSupported;
+  mutable uint m_calcCount;
+};
+
+// fitness of item i is weights[i], weights must be distinct - fitness identifies source item
+void buildGeneration(const std::vector<double> &weights, sgpGaGeneration &output)
+{
+  for(uint i = 0; i != weights.size(); i++) {
+    sgpEntityBase *item = output.newItem();
+    item->setFitness(weights[i]);
+    output.insert(item);
+  }
+}
+
+void buildMeta(uint varCount, sgpGaGenomeMetaList &output)
+{
+  sgpGaGenomeMetaInfo info;
+  info.genType = gagtRanged;
+  info.minValue = scDataNode(0u);
+  info.maxValue = scDataNode(255u);
+  info.genSize = 1;
+  info.userType = 0;
+  output.assign(varCount, info);
+}
+
+void buildGenomes(uint entityCount, uint genomeSize, sgpGaGeneration &output)
+{
+  sgpGaGenome genome(genomeSize);
+
+  for(uint i = 0; i != entityCount; i++) {
+    for(uint j = 0; j != genomeSize; j++)
+      genome[j].setAsUInt((i * 31 + j * 7) % 256);
+    sgpEntityBase *item = output.newItem();
+    item->setGenome(0, genome);
+    output.insert(item);
+  }
+}
+
+// mutates fresh population with given settings, returns genomes of all entities
+void mutateWithSeed(bool skipSampling, uint threadCount, ulong64 seed, std::vector<sgpGaGenome> &output)
+{
+  const uint entityCount = 200;
+  const uint genomeSize = 12;
+  sgpGaGenomeMetaList meta;
+  sgpGaGenerationUInt generation;
+
+  buildMeta(genomeSize, meta);
+  buildGenomes(entityCount, genomeSize, generation);
+
+  sgpGaOperatorMutateBasic mutate;
+  mutate.setMetaInfo(meta);
+  mutate.setProbability(0.3);
+  mutate.setSkipSampling(skipSampling);
+  mutate.setParallel(true);
+  mutate.setThreadCount(threadCount);
+  mutate.setRandomSeed(seed);
+  // two steps - step number is part of stream key
+  mutate.execute(generation);
+  mutate.execute(generation);
+
+  output.resize(entityCount);
+  for(uint i = 0; i != entityCount; i++)
+    generation.at(i).getGenome(0, output[i]);
+}
+
+bool isSameGenomes(const std::vector<sgpGaGenome> &first, const std::vector<sgpGaGenome> &second)
+{
+  if (first.size() != second.size())
+    return false;
+  for(uint i = 0; i != first.size(); i++) {
+    if (first[i].size() != second[i].size())
+      return false;
+    for(uint j = 0; j != first[i].size(); j++)
+      if (first[i][j].getAsUInt() != second[i][j].getAsUInt())
+        return false;
+  }
+  return true;
+}
+
+/// counts calls of generic-form hook, leaves genomes unchanged
+class sgpCountingMutate: public sgpGaOperatorMutateBasic {
+public:
+  sgpCountingMutate(): m_genomeCount(0) {}
+  uint getGenomeCount() const { return m_genomeCount; }
+protected:
+  virtual bool processGenome(uint entityIndex, sgpGaGenome &genome) {
+    m_genomeCount++;
+    return false;
+  }
+private:
+  uint m_genomeCount;
+};
+
+/// even entities use higher change probability (as islands), exposes skip-sampling counts
+class sgpSamplingMutate: public sgpGaOperatorMutateBasic {
+public:
+  static const uint POINT_LIMIT = 4;
+  sgpSamplingMutate(): m_activeEntity(0) {}
+  static double getProbFor(uint entityIndex) { return (entityIndex % 2 == 0) ? 0.3 : 0.1; }
+
+  void sample(sgpGaGeneration &generation, std::vector<uint> &counts, sgpEntityIndexList &changed) {
+    prepareEntities(generation);
+    sampleMutationCounts(generation, changed);
+    counts = m_entityMutationCounts;
+  }
+protected:
+  virtual void prepareEntity(uint entityIndex) { m_activeEntity = entityIndex; }
+  virtual double getEntityChangeProb() { return getProbFor(m_activeEntity); }
+  virtual uint getChangePointLimit() { return POINT_LIMIT; }
+private:
+  uint m_activeEntity;
+};
+
+/// counts calls of pair hook, leaves genomes unchanged
+class sgpCountingXOver: public sgpGaOperatorXOverBasic {
+public:
+  sgpCountingXOver(): m_pairCount(0) {}
+  uint getPairCount() const { return m_pairCount; }
+protected:
+  virtual bool crossGenomes(sgpGaGeneration &newGeneration, uint first, uint second) {
+    m_pairCount++;
+    return true;
+  }
+private:
+  uint m_pairCount;
+};
+
+void countSelected(const sgpGaGeneration &input, const sgpGaGeneration &output, std::vector<uint> &counts)
+{
+  counts.assign(input.size(), 0);
+  for(uint i = 0; i != output.size(); i++)
+    for(uint j = 0; j != input.size(); j++)
+      if (output.at(i).getFitness() == input.at(j).getFitness())
+        counts[j]++;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(susCopiesStayWithinOneOfExpected)
+{
+  const uint limit = 37;
+  std::vector<double> weights;
+  std::vector<uint> counts;
+  double sum = 0.0;
+
+  for(uint i = 0; i != 10; i++) {
+    weights.push_back(static_cast<double>(i * i + 1));
+    sum += weights.back();
+  }
+
+  sgpGaOperatorSelectBasic selector;
+  selector.setSusMode(true);
+  BOOST_CHECK(selector.getSusMode());
+
+  // any spin must give floor or ceil of expected count
+  for(uint run = 0; run != 50; run++) {
+    sgpGaGenerationUInt input, output;
+    buildGeneration(weights, input);
+    selector.execute(input, output, limit);
+
+    BOOST_REQUIRE_EQUAL(output.size(), limit);
+    countSelected(input, output, counts);
+    for(uint j = 0; j != weights.size(); j++) {
+      double expected = limit * weights[j] / sum;
+      BOOST_CHECK(counts[j] >= std::floor(expected));
+      BOOST_CHECK(counts[j] <= std::ceil(expected));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(susSkipsZeroWeightItems)
+{
+  const double values[] = {0.0, 3.0, 1.0};
+  std::vector<double> weights(values, values + 3);
+  std::vector<uint> counts;
+
+  sgpGaOperatorSelectBasic selector;
+  selector.setSusMode(true);
+
+  for(uint run = 0; run != 20; run++) {
+    sgpGaGenerationUInt input, output;
+    buildGeneration(weights, input);
+    selector.execute(input, output, 8);
+
+    BOOST_REQUIRE_EQUAL(output.size(), 8u);
+    countSelected(input, output, counts);
+    BOOST_CHECK_EQUAL(counts[0], 0u);
+    BOOST_CHECK_EQUAL(counts[1], 6u);
+    BOOST_CHECK_EQUAL(counts[2], 2u);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(susFallsBackToRouletteForNegativeWeights)
+{
+  const double values[] = {-1.0, 2.0, 5.0};
+  std::vector<double> weights(values, values + 3);
+
+  sgpGaOperatorSelectBasic selector;
+  selector.setSusMode(true);
+
+  sgpGaGenerationUInt input, output;
+  buildGeneration(weights, input);
+  selector.execute(input, output, 20);
+
+  BOOST_CHECK_EQUAL(output.size(), 20u);
+}
+
+BOOST_AUTO_TEST_CASE(parallelMutationDoesNotDependOnThreadCount)
+{
+  const ulong64 seed = 20131017;
+  const uint threadCounts[] = {2, 4, 0};
+  std::vector<sgpGaGenome> singleThread, multiThread, otherSeed, initial;
+
+  for(uint skipSampling = 0; skipSampling != 2; skipSampling++) {
+    // single worker runs all entities on caller's thread, in order
+    mutateWithSeed(skipSampling != 0, 1, seed, singleThread);
+
+    for(uint t = 0; t != 3; t++) {
+      mutateWithSeed(skipSampling != 0, threadCounts[t], seed, multiThread);
+      BOOST_CHECK(isSameGenomes(singleThread, multiThread));
+    }
+
+    mutateWithSeed(skipSampling != 0, 1, seed + 1, otherSeed);
+    BOOST_CHECK(!isSameGenomes(singleThread, otherSeed));
+  }
+
+  // mutation was performed at all
+  sgpGaGenerationUInt generation;
+  buildGenomes(singleThread.size(), singleThread[0].size(), generation);
+  initial.resize(generation.size());
+  for(uint i = 0; i != generation.size(); i++)
+    generation.at(i).getGenome(0, initial[i]);
+  BOOST_CHECK(!isSameGenomes(initial, singleThread));
+}
+
+BOOST_AUTO_TEST_CASE(filterWrappedEvaluatorRejectsIncrementalMode)
+{
+  sgpGaOperatorEvaluateBasic evaluator;
+  sgpEvalFltClearNan clearNanFilter(&evaluator);
+  sgpEvalFltNormProb normFilter(&evaluator);
+  normFilter.setPrior(&evaluator);
+
+  BOOST_CHECK_NO_THROW(evaluator.setIncrementalMode(true));
+  BOOST_CHECK_NO_THROW(clearNanFilter.setIncrementalMode(false));
+  BOOST_CHECK_NO_THROW(normFilter.setIncrementalMode(false));
+  // filters normalize fitness in-place, fitness of unchanged entities would be filtered twice
+  BOOST_CHECK_THROW(clearNanFilter.setIncrementalMode(true), scError);
+  BOOST_CHECK_THROW(normFilter.setIncrementalMode(true), scError);
+}
+
+BOOST_AUTO_TEST_CASE(postProcessRejectsIncrementalMode)
+{
+  sgpScalingFitnessFunction fitnessFunc(false);
+  sgpGaGenerationUInt generation;
+  buildGenomes(4, 2, generation);
+
+  sgpGaOperatorEvaluateBasic evaluator;
+  evaluator.setFitnessFunc(&fitnessFunc);
+  BOOST_REQUIRE(evaluator.execute(0, true, generation));
+  BOOST_CHECK_EQUAL(generation.at(1).getFitness(1), 2.0 * 31);
+
+  evaluator.setIncrementalMode(true);
+  BOOST_CHECK_THROW(evaluator.execute(1, false, generation), scError);
+  // fitness is not touched
+  BOOST_CHECK_EQUAL(generation.at(1).getFitness(1), 2.0 * 31);
+}
+
+BOOST_AUTO_TEST_CASE(incrementalModeWithRepeatablePostProcess)
+{
+  sgpScalingFitnessFunction fitnessFunc(true);
+  sgpGaGenerationUInt generation;
+  sgpGaGenome genome;
+  buildGenomes(4, 2, generation);
+
+  sgpGaOperatorEvaluateBasic evaluator;
+  evaluator.setFitnessFunc(&fitnessFunc);
+  evaluator.setIncrementalMode(true);
+  BOOST_REQUIRE(evaluator.execute(0, true, generation));
+  BOOST_CHECK_EQUAL(fitnessFunc.getCalcCount(), 4u);
+
+  generation.at(2).getGenome(0, genome);
+  genome[0].setAsUInt(5);
+  generation.at(2).setGenome(0, genome);
+
+  BOOST_REQUIRE(evaluator.execute(1, false, generation));
+  BOOST_CHECK_EQUAL(fitnessFunc.getCalcCount(), 5u);
+  BOOST_CHECK_EQUAL(generation.at(2).getFitness(1), 5.0);
+  BOOST_CHECK_EQUAL(generation.at(1).getFitness(1), 31.0);
+}
+
+BOOST_AUTO_TEST_CASE(cachedEvaluationCalculatesDuplicatesOnce)
+{
+  sgpScalingFitnessFunction fitnessFunc(true);
+  sgpFitnessCache cache;
+  sgpGaGenerationUInt generation;
+  sgpGaGenome genome;
+
+  // entities 0..3, then copies of entities 1 and 2
+  buildGenomes(4, 2, generation);
+  for(uint i = 1; i != 3; i++) {
+    generation.at(i).getGenome(0, genome);
+    sgpEntityBase *item = generation.newItem();
+    item->setGenome(0, genome);
+    generation.insert(item);
+  }
+
+  sgpGaOperatorEvaluateBasic evaluator;
+  evaluator.setFitnessFunc(&fitnessFunc);
+  evaluator.setFitnessCache(&cache);
+
+  BOOST_REQUIRE(evaluator.execute(0, true, generation));
+  BOOST_CHECK_EQUAL(fitnessFunc.getCalcCount(), 4u);
+  BOOST_CHECK_EQUAL(cache.size(), 4u);
+  BOOST_CHECK_EQUAL(generation.at(4).getFitness(1), generation.at(1).getFitness(1));
+  BOOST_CHECK_EQUAL(generation.at(5).getFitness(1), generation.at(2).getFitness(1));
+  BOOST_CHECK(!generation.at(4).isGenomeChanged());
+  BOOST_CHECK(!generation.at(5).isGenomeChanged());
+
+  // all genomes are cached now
+  BOOST_REQUIRE(evaluator.execute(1, true, generation));
+  BOOST_CHECK_EQUAL(fitnessFunc.getCalcCount(), 4u);
+  BOOST_CHECK_EQUAL(generation.at(3).getFitness(1), 93.0);
+}
+
+BOOST_AUTO_TEST_CASE(mutateHookIsCalledForUIntEntities)
+{
+  const uint entityCount = 10;
+  sgpGaGenomeMetaList meta;
+  sgpGaGenerationUInt generation;
+  std::vector<sgpGaGenome> before, after;
+
+  buildMeta(4, meta);
+  buildGenomes(entityCount, 4, generation);
+
+  before.resize(entityCount);
+  for(uint i = 0; i != entityCount; i++) {
+    generation.at(i).getGenome(0, before[i]);
+    generation.at(i).setGenomeChanged(false);
+  }
+
+  sgpCountingMutate mutate;
+  mutate.setMetaInfo(meta);
+  mutate.setProbability(1.0);
+  mutate.execute(generation);
+
+  BOOST_CHECK_EQUAL(mutate.getGenomeCount(), entityCount);
+
+  after.resize(entityCount);
+  for(uint i = 0; i != entityCount; i++) {
+    generation.at(i).getGenome(0, after[i]);
+    BOOST_CHECK(!generation.at(i).isGenomeChanged());
+  }
+  BOOST_CHECK(isSameGenomes(before, after));
+}
+
+BOOST_AUTO_TEST_CASE(xoverOfEqualGenesKeepsEntitiesUnchanged)
+{
+  sgpGaGenomeMetaList meta;
+  sgpGaGenerationUInt generation;
+  sgpGaGenome genome;
+
+  buildMeta(4, meta);
+  // two equal genomes
+  buildGenomes(1, 4, generation);
+  generation.at(0).getGenome(0, genome);
+  generation.insert(generation.newItem());
+  generation.at(1).setGenome(0, genome);
+
+  sgpGaOperatorXOverBasic xover;
+  xover.setMetaInfo(meta);
+  xover.setProbability(1.0);
+
+  for(uint step = 0; step != 10; step++) {
+    generation.at(0).setGenomeChanged(false);
+    generation.at(1).setGenomeChanged(false);
+    xover.execute(generation);
+    BOOST_CHECK(!generation.at(0).isGenomeChanged());
+    BOOST_CHECK(!generation.at(1).isGenomeChanged());
+  }
+
+  // different last gene - always swapped, crossing point is before it
+  genome[3].setAsUInt(genome[3].getAsUInt() + 1);
+  generation.at(1).setGenome(0, genome);
+  generation.at(0).setGenomeChanged(false);
+  generation.at(1).setGenomeChanged(false);
+  xover.execute(generation);
+  BOOST_CHECK(generation.at(0).isGenomeChanged());
+  BOOST_CHECK(generation.at(1).isGenomeChanged());
+  sgpGaGenome firstGenome, secondGenome;
+  generation.at(0).getGenome(0, firstGenome);
+  generation.at(1).getGenome(0, secondGenome);
+  BOOST_CHECK_EQUAL(firstGenome[3].getAsUInt(), secondGenome[3].getAsUInt() + 1);
+}
+
+BOOST_AUTO_TEST_CASE(parallelModeFallsBackForOverriddenHooks)
+{
+  const uint entityCount = 10;
+  sgpGaGenomeMetaList meta;
+  sgpGaGenerationUInt generation;
+
+  buildMeta(4, meta);
+  buildGenomes(entityCount, 4, generation);
+
+  for(uint skipSampling = 0; skipSampling != 2; skipSampling++) {
+    sgpCountingMutate mutate;
+    mutate.setMetaInfo(meta);
+    mutate.setProbability(1.0);
+    mutate.setSkipSampling(skipSampling != 0);
+    mutate.setParallel(true);
+    mutate.setRandomSeed(1);
+    mutate.execute(generation);
+    // with p = 1 each entity has at least one mutation
+    BOOST_CHECK_EQUAL(mutate.getGenomeCount(), entityCount);
+  }
+
+  sgpCountingXOver xover;
+  xover.setMetaInfo(meta);
+  xover.setProbability(1.0);
+  xover.setParallel(true);
+  xover.setRandomSeed(1);
+  xover.execute(generation);
+  BOOST_CHECK_EQUAL(xover.getPairCount(), entityCount / 2);
+}
+
+BOOST_AUTO_TEST_CASE(skipSamplingCountsMatchPerEntityTrials)
+{
+  const uint entityCount = 40000;
+  const uint limit = sgpSamplingMutate::POINT_LIMIT;
+  sgpGaGenomeMetaList meta;
+  sgpGaGenerationUInt generation;
+  sgpSamplingMutate mutate;
+  std::vector<uint> counts;
+  sgpEntityIndexList changed;
+
+  buildMeta(4, meta);
+  buildGenomes(entityCount, 4, generation);
+  mutate.setMetaInfo(meta);
+  mutate.setSkipSampling(true);
+  mutate.sample(generation, counts, changed);
+  BOOST_REQUIRE_EQUAL(counts.size(), entityCount);
+
+  // per-entity mode: K ~ U(1, L) trials, each one is a hit with probability p
+  sgpRandomStream random(20131017, 0, 0, rsoMutate);
+  std::vector<uint> trialCounts(entityCount, 0);
+  for(uint i = 0; i != entityCount; i++) {
+    uint trialCount = random.randomUInt(1, limit);
+    for(uint j = 0; j != trialCount; j++)
+      if (random.randomFlip(sgpSamplingMutate::getProbFor(i)))
+        trialCounts[i]++;
+  }
+
+  // changed entities are listed once, in order
+  uint changedCount = 0;
+  for(uint i = 0; i != entityCount; i++) {
+    BOOST_CHECK(counts[i] <= limit);
+    if (counts[i] > 0) {
+      BOOST_REQUIRE(changedCount < changed.size());
+      BOOST_CHECK_EQUAL(changed[changedCount], i);
+      changedCount++;
+    }
+  }
+  BOOST_CHECK_EQUAL(changedCount, changed.size());
+
+  for(uint parity = 0; parity != 2; parity++) {
+    double p = sgpSamplingMutate::getProbFor(parity);
+    double expectedMean = p * (limit + 1) / 2.0;
+    double expectedZero = 0.0;
+    for(uint k = 1; k <= limit; k++)
+      expectedZero += pow(1.0 - p, static_cast<double>(k)) / limit;
+
+    double sampledSum = 0.0, trialSum = 0.0;
+    double sampledZero = 0.0, trialZero = 0.0;
+    double itemCount = 0.0;
+    for(uint i = parity; i < entityCount; i += 2) {
+      sampledSum += counts[i];
+      trialSum += trialCounts[i];
+      if (counts[i] == 0)
+        sampledZero += 1.0;
+      if (trialCounts[i] == 0)
+        trialZero += 1.0;
+      itemCount += 1.0;
+    }
+
+    // tolerances are about 5 standard deviations
+    BOOST_CHECK_SMALL(sampledSum / itemCount - expectedMean, 0.03);
+    BOOST_CHECK_SMALL(trialSum / itemCount - expectedMean, 0.03);
+    BOOST_CHECK_SMALL(sampledZero / itemCount - expectedZero, 0.018);
+    BOOST_CHECK_SMALL(trialZero / itemCount - expectedZero, 0.018);
+  }
+}
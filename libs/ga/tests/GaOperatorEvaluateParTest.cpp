@@ -0,0 +1,140 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        GaOperatorEvaluateParTest.cpp
+// Project:     sgpLib
+// Purpose:     Unit tests for sgpGaOperatorEvaluatePar.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#define BOOST_TEST_MODULE GaOperatorEvaluateParTest
+#include <boost/test/unit_test.hpp>
+
+//sgp
+#include "sgp/GaOperatorEvaluatePar.h"
+#include "sgp/GaGenerationUInt.h"
+#include "sgp/FitnessFunction.h"
+
+namespace {
+
+const uint ENTITY_COUNT = 300;
+const uint GENOME_SIZE = 5;
+
+/// objective #0 = sum of genes, #1 = weighted sum, #2 = entity index;
+/// cost depends on entity so that workers get uneven load
+class sgpTestFitnessFunction: public sgpFitnessFunction {
+public:
+  sgpTestFitnessFunction(bool batchSupported, uint failedIndex = ENTITY_COUNT): 
+    sgpFitnessFunction(), m_batchSupported(batchSupported), m_failedIndex(failedIndex) {}
+  virtual int getFunctionId() const { return 1; }
+  virtual uint getObjectiveCount() const { return 3; }
+  virtual bool isBatchSupported() const { return m_batchSupported; }
+
+  virtual bool calc(uint entityIndex, const sgpEntityBase *entity, sgpFitnessValue &fitness) const {
+    sgpGaGenome genome;
+    double sum = 0.0;
+    double weightedSum = 0.0;
+
+    entity->getGenome(0, genome);
+    for(uint i = 0; i != genome.size(); i++) {
+      sum += genome[i].getAsUInt();
+      for(uint j = 0, epos = (entityIndex % 13 == 0) ? 2000 : 1; j != epos; j++)
+        weightedSum += 1e-3 * (i + 1) * genome[i].getAsUInt();
+    }
+
+    fitness.resize(getObjectiveCount());
+    fitness.setValue(0, sum);
+    fitness.setValue(1, weightedSum);
+    fitness.setValue(2, static_cast<double>(entityIndex));
+    return (entityIndex != m_failedIndex);
+  }
+private:
+  bool m_batchSupported;
+  uint m_failedIndex;
+};
+
+void buildGeneration(sgpGaGeneration &output)
+{
+  sgpGaGenome genome(GENOME_SIZE);
+
+  for(uint i = 0; i != ENTITY_COUNT; i++) {
+    for(uint j = 0; j != GENOME_SIZE; j++)
+      genome[j].setAsUInt((i * 7 + j * 3) % 16);
+    sgpEntityBase *item = output.newItem();
+    item->setGenome(0, genome);
+    output.insert(item);
+  }
+}
+
+void checkSameFitness(const sgpGaGeneration &expected, const sgpGaGeneration &actual)
+{
+  BOOST_REQUIRE_EQUAL(expected.size(), actual.size());
+  for(uint i = 0; i != expected.size(); i++) {
+    BOOST_REQUIRE_EQUAL(expected.at(i).getFitnessSize(), actual.at(i).getFitnessSize());
+    for(uint j = 0; j != expected.at(i).getFitnessSize(); j++)
+      BOOST_CHECK_EQUAL(expected.at(i).getFitness(j), actual.at(i).getFitness(j));
+  }
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(parallelFitnessMatchesBasicEvaluator)
+{
+  const uint threadCounts[] = {1, 2, 4, 0};
+
+  for(uint batchMode = 0; batchMode != 2; batchMode++) {
+    sgpTestFitnessFunction fitnessFunc(batchMode != 0);
+    sgpGaGenerationUInt expected;
+    buildGeneration(expected);
+
+    sgpGaOperatorEvaluateBasic basicEval;
+    basicEval.setFitnessFunc(&fitnessFunc);
+    BOOST_CHECK(basicEval.execute(0, true, expected));
+
+    for(uint t = 0; t != 4; t++) {
+      sgpGaGenerationUInt actual;
+      buildGeneration(actual);
+
+      sgpGaOperatorEvaluatePar parEval;
+      parEval.setFitnessFunc(&fitnessFunc);
+      parEval.setThreadCount(threadCounts[t]);
+      parEval.setBatchSize(16);
+      BOOST_CHECK(parEval.execute(0, true, actual));
+
+      checkSameFitness(expected, actual);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(incrementalModeSkipsUnchangedEntities)
+{
+  sgpTestFitnessFunction fitnessFunc(false);
+  sgpGaGenerationUInt generation;
+  buildGeneration(generation);
+
+  sgpGaOperatorEvaluatePar parEval;
+  parEval.setFitnessFunc(&fitnessFunc);
+  parEval.setIncrementalMode(true);
+  parEval.setThreadCount(4);
+  BOOST_REQUIRE(parEval.execute(0, true, generation));
+
+  // fitness of unchanged entities is not recalculated
+  generation.at(5).setFitness(2, -1.0);
+  BOOST_REQUIRE(parEval.execute(1, false, generation));
+  BOOST_CHECK_EQUAL(generation.at(5).getFitness(2), -1.0);
+}
+
+BOOST_AUTO_TEST_CASE(failedCalcKeepsEntitiesChanged)
+{
+  sgpTestFitnessFunction fitnessFunc(false, 17);
+  sgpGaGenerationUInt generation;
+  buildGeneration(generation);
+
+  sgpGaOperatorEvaluatePar parEval;
+  parEval.setFitnessFunc(&fitnessFunc);
+  parEval.setIncrementalMode(true);
+  parEval.setThreadCount(4);
+
+  BOOST_CHECK(!parEval.execute(0, true, generation));
+  BOOST_CHECK(generation.at(17).isGenomeChanged());
+}
@@ -0,0 +1,301 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        GaOperatorSelectTourProbTest.cpp
+// Project:     sgpLib
+// Purpose:     Unit tests for probability tournament selection.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#define BOOST_TEST_MODULE GaOperatorSelectTourProbTest
+#include <boost/test/unit_test.hpp>
+
+//std
+#include <vector>
+
+//sgp
+#include "sgp/GaOperatorSelectTourProb.h"
+#include "sgp/GaGenerationUInt.h"
+#include "sgp/RandomStream.h"
+
+namespace {
+
+const uint OBJ_COUNT = 3;
+
+/// exposes match kernel & group tournament
+class sgpTourProbProbe: public sgpGaOperatorSelectTourProb {
+public:
+  sgpTourProbProbe() {
+    sgpWeightVector weights(OBJ_COUNT, 1.0);
+    setObjectiveWeights(weights);
+  }
+
+  void runGroup(sgpTournamentGroup &output, const sgpGaGeneration &input, const sgpTournamentGroup &group,
+    double gravity, uint outSizeLimit, sgpRandomSource &random)
+  {
+    intRunMatchInGroup(output, input, group, gravity, true, outSizeLimit, random, m_matchStats);
+  }
+
+  double calcKernel(const sgpGaGeneration &input, uint first, uint second, double gravity) {
+    double sumLrk;
+    return calcMatchProb(input, first, second, gravity, sumLrk);
+  }
+
+  double calcRef(const sgpGaGeneration &input, uint first, uint second, double gravity) {
+    double sumLrk;
+    return calcMatchProbRef(input, first, second, gravity, sumLrk);
+  }
+
+  const sgpTourMatchStats &getMatchStats() const { return m_matchStats; }
+};
+
+/// always selects first item, match with probability > 0.5 is always won
+class sgpScriptedRandomSource: public sgpRandomSource {
+public:
+  virtual int randomInt(int minValue, int maxValue) { return minValue; }
+  virtual uint randomUInt(uint minValue, uint maxValue) { return minValue; }
+  virtual double randomDouble(double minValue, double maxValue) { return minValue; }
+  virtual bool randomFlip(double prob) { return (prob > 0.5); }
+  virtual void randomString(const scString &charSet, uint len, scString &output) { output.clear(); }
+};
+
+void addEntity(double obj0, double obj1, double obj2, sgpGaGeneration &output)
+{
+  sgpFitnessValue fitness;
+  fitness.resize(OBJ_COUNT);
+  fitness.setValue(0, obj0);
+  fitness.setValue(1, obj1);
+  fitness.setValue(2, obj2);
+
+  sgpEntityBase *item = output.newItem();
+  item->setFitness(fitness);
+  output.insert(item);
+}
+
+// objective #0 identifies item, other objectives include negative values & ties
+void buildPopulation(uint entityCount, sgpGaGeneration &output)
+{
+  for(uint i = 0; i != entityCount; i++)
+    addEntity(i, static_cast<double>((i * 37) % 101) - 50.0, 0.5 * ((i * 53) % 89), output);
+}
+
+// pivot (item 0) wins against item 1 and loses against item 2 on probability,
+// all items are non-dominated
+void buildUndecidedGroup(sgpGaGeneration &input, sgpTournamentGroup &group)
+{
+  addEntity(0.0, 10.0, 10.0, input);
+  addEntity(0.0, 1.0, 11.0, input);
+  addEntity(0.0, 9.0, 100.0, input);
+  for(uint i = 0; i != 3; i++)
+    group.insert(i);
+}
+
+void selectWithThreads(uint threadCount, ulong64 seed, std::vector<double> &output)
+{
+  const uint entityCount = 120;
+  sgpGaGenerationUInt input, selected;
+  sgpTourProbProbe selector;
+
+  buildPopulation(entityCount, input);
+
+  selector.setParallel(true);
+  selector.setThreadCount(threadCount);
+  selector.setRandomSeed(seed);
+  selector.setTournamentSize(4);
+  // two steps - step number is part of stream key
+  selector.execute(input, selected, entityCount);
+  selected.clear();
+  selector.execute(input, selected, entityCount);
+
+  output.resize(selected.size());
+  for(uint i = 0; i != selected.size(); i++)
+    output[i] = selected.at(i).getFitness(0);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(singleItemGroupIsWinner)
+{
+  sgpGaGenerationUInt input;
+  sgpTournamentGroup group, output;
+  sgpRandomStream random(1, 0, 0, rsoSelect);
+  sgpTourProbProbe selector;
+
+  buildPopulation(3, input);
+  group.insert(2);
+  selector.runGroup(output, input, group, 0.0, 2, random);
+
+  BOOST_REQUIRE_EQUAL(output.size(), 1u);
+  BOOST_CHECK_EQUAL(output[0], 2u);
+  BOOST_CHECK_EQUAL(selector.getMatchStats().roundCount, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(dominatingItemWinsGroup)
+{
+  sgpGaGenerationUInt input;
+  sgpTournamentGroup group, output;
+  sgpTourProbProbe selector;
+
+  addEntity(0.0, 1.0, 1.0, input);
+  addEntity(0.0, 2.0, 2.0, input);
+  addEntity(0.0, 3.0, 3.0, input);
+  for(uint i = 0; i != 3; i++)
+    group.insert(i);
+
+  // dominated items lose without random draw, result does not depend on pivot
+  for(uint seed = 1; seed != 20; seed++) {
+    sgpRandomStream random(seed, 0, 0, rsoSelect);
+    selector.runGroup(output, input, group, 0.0, 2, random);
+    BOOST_REQUIRE_EQUAL(output.size(), 1u);
+    BOOST_CHECK_EQUAL(output[0], 2u);
+  }
+
+  BOOST_CHECK_EQUAL(selector.getMatchStats().equalShortcutCount, 0u);
+  BOOST_CHECK_EQUAL(selector.getMatchStats().limitHitCount, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(equalItemsFinishInFirstRound)
+{
+  sgpGaGenerationUInt input;
+  sgpTournamentGroup group, output;
+  sgpRandomStream random(1, 0, 0, rsoSelect);
+  sgpTourProbProbe selector;
+
+  for(uint i = 0; i != 4; i++) {
+    addEntity(1.0, 2.0, 3.0, input);
+    group.insert(i);
+  }
+
+  selector.runGroup(output, input, group, 0.0, 2, random);
+
+  BOOST_REQUIRE_EQUAL(output.size(), 1u);
+  BOOST_CHECK(group.contains(output[0]));
+  BOOST_CHECK_EQUAL(selector.getMatchStats().roundCount, 1u);
+  BOOST_CHECK_EQUAL(selector.getMatchStats().equalShortcutCount, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(undecidedGroupConvergesInSecondRound)
+{
+  sgpGaGenerationUInt input;
+  sgpTournamentGroup group, output;
+  sgpScriptedRandomSource random;
+  sgpTourProbProbe selector;
+
+  buildUndecidedGroup(input, group);
+  BOOST_REQUIRE(selector.calcKernel(input, 0, 1, 0.0) > 0.5);
+  BOOST_REQUIRE(selector.calcKernel(input, 0, 2, 0.0) < 0.5);
+
+  // round 1: {0, 2} stay, round 2: 2 wins against 0
+  selector.runGroup(output, input, group, 0.0, 1, random);
+
+  BOOST_REQUIRE_EQUAL(output.size(), 1u);
+  BOOST_CHECK_EQUAL(output[0], 2u);
+  BOOST_CHECK_EQUAL(selector.getMatchStats().roundCount, 2u);
+  BOOST_CHECK_EQUAL(selector.getMatchStats().limitHitCount, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(roundLimitTrimsWinners)
+{
+  sgpGaGenerationUInt input;
+  sgpTournamentGroup group, output;
+  sgpScriptedRandomSource random;
+  sgpTourProbProbe selector;
+
+  buildUndecidedGroup(input, group);
+  selector.setMatchRoundLimit(1);
+
+  // both winners of first round are allowed
+  selector.runGroup(output, input, group, 0.0, 2, random);
+  BOOST_REQUIRE_EQUAL(output.size(), 2u);
+  BOOST_CHECK(output.contains(0));
+  BOOST_CHECK(output.contains(2));
+
+  // trimmed to a single winner
+  selector.runGroup(output, input, group, 0.0, 1, random);
+  BOOST_CHECK_EQUAL(output.size(), 1u);
+
+  // zero is handled as one
+  selector.runGroup(output, input, group, 0.0, 0, random);
+  BOOST_CHECK_EQUAL(output.size(), 1u);
+
+  BOOST_CHECK_EQUAL(selector.getMatchStats().roundCount, 3u);
+  BOOST_CHECK_EQUAL(selector.getMatchStats().limitHitCount, 3u);
+}
+
+BOOST_AUTO_TEST_CASE(countersReportMatchStats)
+{
+  sgpGaGenerationUInt input, equalInput;
+  sgpTournamentGroup group, equalGroup, output;
+  sgpScriptedRandomSource random;
+  sgpTourProbProbe selector;
+
+  buildUndecidedGroup(input, group);
+  for(uint i = 0; i != 2; i++) {
+    addEntity(1.0, 1.0, 1.0, equalInput);
+    equalGroup.insert(i);
+  }
+
+  // 2 rounds, then 1 round with limit hit, then 1 round with equal exit
+  selector.runGroup(output, input, group, 0.0, 1, random);
+  selector.setMatchRoundLimit(1);
+  selector.runGroup(output, input, group, 0.0, 1, random);
+  selector.runGroup(output, equalInput, equalGroup, 0.0, 1, random);
+
+  scDataNode counters;
+  selector.getCounters(counters);
+  BOOST_CHECK_EQUAL(counters["gx-tour-match-groups"].getAsUInt64(), 3u);
+  BOOST_CHECK_EQUAL(counters["gx-tour-match-rounds"].getAsUInt64(), 4u);
+  BOOST_CHECK_EQUAL(counters["gx-tour-match-equal-exits"].getAsUInt64(), 1u);
+  BOOST_CHECK_EQUAL(counters["gx-tour-match-limit-hits"].getAsUInt64(), 1u);
+
+  selector.resetCounters();
+  scDataNode emptyCounters;
+  selector.getCounters(emptyCounters);
+  BOOST_CHECK_EQUAL(emptyCounters["gx-tour-match-groups"].getAsUInt64(), 0u);
+  BOOST_CHECK_EQUAL(emptyCounters["gx-tour-match-rounds"].getAsUInt64(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(matchKernelAgreesWithReference)
+{
+  const uint entityCount = 40;
+  const double gravities[] = {-1.0, -0.5, -0.1, 0.0, 0.25, 0.75};
+  sgpGaGenerationUInt input;
+  sgpTourProbProbe selector;
+  double kernelRes, refRes;
+
+  buildPopulation(entityCount, input);
+
+  for(uint g = 0; g != 6; g++)
+    for(uint i = 0; i != entityCount; i++)
+      for(uint j = 0; j != entityCount; j++) {
+        kernelRes = selector.calcKernel(input, i, j, gravities[g]);
+        refRes = selector.calcRef(input, i, j, gravities[g]);
+        // bit-identical, not just close
+        BOOST_CHECK(kernelRes == refRes);
+      }
+
+  // verification mode throws on first difference
+  sgpGaGenerationUInt selected;
+  selector.setVerifyMatchKernel(true);
+  BOOST_CHECK_NO_THROW(selector.execute(input, selected, entityCount));
+  BOOST_CHECK_EQUAL(selected.size(), entityCount);
+}
+
+BOOST_AUTO_TEST_CASE(parallelSelectionDoesNotDependOnThreadCount)
+{
+  const ulong64 seed = 20131017;
+  const uint threadCounts[] = {2, 4, 0};
+  std::vector<double> singleThread, multiThread, otherSeed;
+
+  // single worker runs all blocks on caller's thread, in order
+  selectWithThreads(1, seed, singleThread);
+  BOOST_REQUIRE_EQUAL(singleThread.size(), 120u);
+
+  for(uint t = 0; t != 3; t++) {
+    selectWithThreads(threadCounts[t], seed, multiThread);
+    BOOST_CHECK(singleThread == multiThread);
+  }
+
+  selectWithThreads(1, seed + 1, otherSeed);
+  BOOST_CHECK(singleThread != otherSeed);
+}
@@ -0,0 +1,80 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        IslandPartitionTest.cpp
+// Project:     sgpLib
+// Purpose:     Unit tests for sgpIslandPartition.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#define BOOST_TEST_MODULE IslandPartitionTest
+#include <boost/test/unit_test.hpp>
+
+//sgp
+#include "sgp/IslandPartition.h"
+
+BOOST_AUTO_TEST_CASE(emptyPartitionHasNoIslands)
+{
+  sgpIslandPartition islands;
+
+  BOOST_CHECK_EQUAL(islands.getIslandCount(), 0u);
+  BOOST_CHECK_EQUAL(islands.getItemCount(), 0u);
+  BOOST_CHECK_EQUAL(islands.getIslandSize(0), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(buildGroupsItemsByIsland)
+{
+  const uint ids[] = {2, 0, 2, 1, 0, 2};
+  sgpIslandPartition islands;
+
+  islands.build(ids, 6, 3, 10);
+
+  BOOST_REQUIRE_EQUAL(islands.getIslandCount(), 3u);
+  BOOST_CHECK_EQUAL(islands.getItemCount(), 6u);
+
+  BOOST_REQUIRE_EQUAL(islands.getIslandSize(0), 2u);
+  BOOST_CHECK_EQUAL(islands.getIslandItems(0)[0], 11u);
+  BOOST_CHECK_EQUAL(islands.getIslandItems(0)[1], 14u);
+
+  BOOST_REQUIRE_EQUAL(islands.getIslandSize(1), 1u);
+  BOOST_CHECK_EQUAL(islands.getIslandItems(1)[0], 13u);
+
+  // items are kept in ascending order
+  BOOST_REQUIRE_EQUAL(islands.getIslandSize(2), 3u);
+  BOOST_CHECK_EQUAL(islands.getIslandItems(2)[0], 10u);
+  BOOST_CHECK_EQUAL(islands.getIslandItems(2)[1], 12u);
+  BOOST_CHECK_EQUAL(islands.getIslandItems(2)[2], 15u);
+}
+
+BOOST_AUTO_TEST_CASE(islandCountComesFromLimit)
+{
+  std::vector<uint> ids(4, 1);
+  sgpIslandPartition islands;
+
+  islands.build(ids, 5);
+
+  BOOST_CHECK_EQUAL(islands.getIslandCount(), 5u);
+  BOOST_CHECK(islands.isIslandEmpty(0));
+  BOOST_CHECK(islands.getIslandItems(0) == SC_NULL);
+  BOOST_CHECK_EQUAL(islands.getIslandSize(1), 4u);
+  BOOST_CHECK(islands.isIslandEmpty(4));
+  BOOST_CHECK_EQUAL(islands.getIslandSize(5), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(rebuildReplacesPreviousPartition)
+{
+  const uint ids[] = {0, 1, 1};
+  const uint ids2[] = {1};
+  sgpIslandPartition islands;
+
+  islands.build(ids, 3, 2);
+  islands.build(ids2, 1, 2);
+
+  BOOST_CHECK_EQUAL(islands.getItemCount(), 1u);
+  BOOST_CHECK(islands.isIslandEmpty(0));
+  BOOST_REQUIRE_EQUAL(islands.getIslandSize(1), 1u);
+  BOOST_CHECK_EQUAL(islands.getIslandItems(1)[0], 0u);
+
+  islands.clear();
+  BOOST_CHECK_EQUAL(islands.getIslandCount(), 0u);
+}
@@ -0,0 +1,184 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        ParetoRankerTest.cpp
+// Project:     sgpLib
+// Purpose:     Unit tests for sgpParetoRanker.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#define BOOST_TEST_MODULE ParetoRankerTest
+#include <boost/test/unit_test.hpp>
+
+//std
+#include <cstdlib>
+#include <limits>
+
+//sgp
+#include "sgp/ParetoRanker.h"
+
+namespace {
+
+// reference: repeatedly peel off rows not dominated by any remaining row
+void calcNaiveRanks(const sgpFitnessMatrix &fitness, const std::vector<uint> &columns, std::vector<uint> &output)
+{
+  const uint NO_RANK = static_cast<uint>(-1);
+  uint rowCount = fitness.getRowCount();
+  uint rankedCount = 0;
+  std::vector<uint> front;
+
+  output.assign(rowCount, NO_RANK);
+
+  for(uint rank = 0; rankedCount != rowCount; rank++) {
+    front.clear();
+    for(uint i = 0; i != rowCount; i++) {
+      if (output[i] != NO_RANK)
+        continue;
+      bool dominated = false;
+      for(uint j = 0; (j != rowCount) && !dominated; j++)
+        if ((output[j] == NO_RANK) && sgpParetoRanker::dominates(fitness.getRow(j), fitness.getRow(i), columns))
+          dominated = true;
+      if (!dominated)
+        front.push_back(i);
+    }
+    for(uint i = 0; i != front.size(); i++)
+      output[front[i]] = rank;
+    rankedCount += front.size();
+  }
+}
+
+std::vector<uint> makeColumns(uint count)
+{
+  std::vector<uint> res(count);
+  for(uint i = 0; i != count; i++)
+    res[i] = i;
+  return res;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(dominatesRequiresStrictImprovement)
+{
+  const double a[] = {2.0, 1.0};
+  const double b[] = {1.0, 1.0};
+  const double c[] = {0.0, 3.0};
+  std::vector<uint> columns = makeColumns(2);
+
+  BOOST_CHECK(sgpParetoRanker::dominates(a, b, columns));
+  BOOST_CHECK(!sgpParetoRanker::dominates(b, a, columns));
+  BOOST_CHECK(!sgpParetoRanker::dominates(a, a, columns));
+  BOOST_CHECK(!sgpParetoRanker::dominates(a, c, columns));
+  BOOST_CHECK(!sgpParetoRanker::dominates(c, a, columns));
+}
+
+BOOST_AUTO_TEST_CASE(ranksSimpleFronts)
+{
+  const double values[][2] = {
+    {1.0, 1.0}, {3.0, 0.0}, {0.0, 3.0}, {2.0, 2.0}, {0.0, 0.0}, {2.0, 2.0}
+  };
+  sgpFitnessMatrix fitness(6, 2);
+  for(uint i = 0; i != 6; i++) {
+    fitness.set(i, 0, values[i][0]);
+    fitness.set(i, 1, values[i][1]);
+  }
+
+  sgpParetoRanker ranker;
+  ranker.rank(fitness, makeColumns(2));
+
+  BOOST_REQUIRE_EQUAL(ranker.getFrontCount(), 3u);
+  BOOST_CHECK_EQUAL(ranker.getRank(1), 0u);
+  BOOST_CHECK_EQUAL(ranker.getRank(2), 0u);
+  BOOST_CHECK_EQUAL(ranker.getRank(3), 0u);
+  // equal rows do not dominate each other
+  BOOST_CHECK_EQUAL(ranker.getRank(5), 0u);
+  BOOST_CHECK_EQUAL(ranker.getRank(0), 1u);
+  BOOST_CHECK_EQUAL(ranker.getRank(4), 2u);
+
+  sgpParetoRowList front;
+  ranker.getFront(0, front);
+  BOOST_REQUIRE_EQUAL(front.size(), 4u);
+  BOOST_CHECK_EQUAL(front[0], 1u);
+  BOOST_CHECK_EQUAL(front[3], 5u);
+}
+
+BOOST_AUTO_TEST_CASE(selectedColumnsOnly)
+{
+  sgpFitnessMatrix fitness(2, 2);
+  fitness.set(0, 0, 1.0);
+  fitness.set(0, 1, 0.0);
+  fitness.set(1, 0, 0.0);
+  fitness.set(1, 1, 5.0);
+
+  std::vector<uint> columns(1, 0);
+  sgpParetoRanker ranker;
+  ranker.rank(fitness, columns);
+
+  BOOST_CHECK_EQUAL(ranker.getFrontCount(), 2u);
+  BOOST_CHECK_EQUAL(ranker.getRank(0), 0u);
+  BOOST_CHECK_EQUAL(ranker.getRank(1), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(partialRankLeavesOtherRowsUnranked)
+{
+  sgpFitnessMatrix fitness(3, 1);
+  fitness.set(0, 0, 1.0);
+  fitness.set(1, 0, 9.0);
+  fitness.set(2, 0, 2.0);
+
+  sgpParetoRowList rows;
+  rows.push_back(0);
+  rows.push_back(2);
+
+  sgpParetoRanker ranker;
+  ranker.rank(fitness, makeColumns(1), rows);
+
+  BOOST_REQUIRE_EQUAL(ranker.getFrontCount(), 2u);
+  BOOST_CHECK_EQUAL(ranker.getRank(2), 0u);
+  BOOST_CHECK_EQUAL(ranker.getRank(0), 1u);
+  BOOST_CHECK_EQUAL(ranker.getRank(1), ranker.getFrontCount());
+}
+
+BOOST_AUTO_TEST_CASE(matchesNaiveSortOnRandomData)
+{
+  const uint rowCount = 200;
+  std::vector<uint> expected;
+
+  std::srand(7);
+  for(uint colCount = 1; colCount <= 4; colCount++) {
+    sgpFitnessMatrix fitness(rowCount, colCount);
+    for(uint i = 0; i != rowCount; i++)
+      for(uint c = 0; c != colCount; c++)
+        // small value range - many ties
+        fitness.set(i, c, static_cast<double>(std::rand() % 8));
+
+    std::vector<uint> columns = makeColumns(colCount);
+    sgpParetoRanker ranker;
+    ranker.rank(fitness, columns);
+    calcNaiveRanks(fitness, columns, expected);
+
+    for(uint i = 0; i != rowCount; i++)
+      BOOST_CHECK_EQUAL(ranker.getRank(i), expected[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(crowdingDistanceInsideFront)
+{
+  const double infValue = std::numeric_limits<double>::infinity();
+  sgpFitnessMatrix fitness(4, 2);
+  // single front: x + y = 4
+  const double xs[] = {0.0, 1.0, 3.0, 4.0};
+  for(uint i = 0; i != 4; i++) {
+    fitness.set(i, 0, xs[i]);
+    fitness.set(i, 1, 4.0 - xs[i]);
+  }
+
+  sgpParetoRanker ranker;
+  ranker.rank(fitness, makeColumns(2));
+
+  BOOST_REQUIRE_EQUAL(ranker.getFrontCount(), 1u);
+  BOOST_CHECK_EQUAL(ranker.getCrowding(0), infValue);
+  BOOST_CHECK_EQUAL(ranker.getCrowding(3), infValue);
+  // (3 - 0) / 4 on each column
+  BOOST_CHECK_CLOSE(ranker.getCrowding(1), 1.5, 1e-9);
+  BOOST_CHECK_CLOSE(ranker.getCrowding(2), 1.5, 1e-9);
+}
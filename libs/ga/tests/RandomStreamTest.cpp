@@ -0,0 +1,124 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        RandomStreamTest.cpp
+// Project:     sgpLib
+// Purpose:     Unit tests for sgpRandomStream.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#define BOOST_TEST_MODULE RandomStreamTest
+#include <boost/test/unit_test.hpp>
+
+//std
+#include <cmath>
+#include <vector>
+
+//sgp
+#include "sgp/RandomStream.h"
+
+BOOST_AUTO_TEST_CASE(matchesPhiloxKnownAnswers)
+{
+  // Philox4x32-10 known-answer vectors (Random123), counter = (block, step, entity, oper)
+  sgpRandomStream zeroStream(0, 0, 0, 0);
+  BOOST_CHECK_EQUAL(zeroStream.nextUInt32(), 0x6627e8d5u);
+  BOOST_CHECK_EQUAL(zeroStream.nextUInt32(), 0xe169c58du);
+  BOOST_CHECK_EQUAL(zeroStream.nextUInt32(), 0xbc57ac4cu);
+  BOOST_CHECK_EQUAL(zeroStream.nextUInt32(), 0x9b00dbd8u);
+
+  sgpRandomStream piStream(0x299f31d0a4093822ull, 0x85a308d3u, 0x13198a2eu, 0x03707344u);
+  piStream.setPosition(0x243f6a88u);
+  BOOST_CHECK_EQUAL(piStream.nextUInt32(), 0xd16cfe09u);
+  BOOST_CHECK_EQUAL(piStream.nextUInt32(), 0x94fdccebu);
+  BOOST_CHECK_EQUAL(piStream.nextUInt32(), 0x5001e420u);
+  BOOST_CHECK_EQUAL(piStream.nextUInt32(), 0x24126ea1u);
+  BOOST_CHECK_EQUAL(piStream.getPosition(), 0x243f6a89u);
+}
+
+BOOST_AUTO_TEST_CASE(sameKeyGivesSameSequence)
+{
+  sgpRandomStream first(12345, 3, 17, rsoMutate);
+  sgpRandomStream second(12345, 3, 17, rsoMutate);
+
+  for(uint i = 0; i != 100; i++)
+    BOOST_CHECK_EQUAL(first.nextUInt32(), second.nextUInt32());
+}
+
+BOOST_AUTO_TEST_CASE(keyPartsSelectDifferentStreams)
+{
+  sgpRandomStream base(12345, 3, 17, rsoMutate);
+  sgpRandomStream otherSeed(12346, 3, 17, rsoMutate);
+  sgpRandomStream otherStep(12345, 4, 17, rsoMutate);
+  sgpRandomStream otherEntity(12345, 3, 18, rsoMutate);
+  sgpRandomStream otherOper(12345, 3, 17, rsoXOver);
+
+  uint value = base.nextUInt32();
+  BOOST_CHECK(value != otherSeed.nextUInt32());
+  BOOST_CHECK(value != otherStep.nextUInt32());
+  BOOST_CHECK(value != otherEntity.nextUInt32());
+  BOOST_CHECK(value != otherOper.nextUInt32());
+}
+
+BOOST_AUTO_TEST_CASE(setPositionJumpsToBlock)
+{
+  sgpRandomStream stream(99, 1, 2, rsoUser);
+  uint values[12];
+  stream.fillUInt32(values, 12);
+  BOOST_CHECK_EQUAL(stream.getPosition(), 3u);
+
+  stream.setPosition(2);
+  for(uint i = 8; i != 12; i++)
+    BOOST_CHECK_EQUAL(stream.nextUInt32(), values[i]);
+
+  stream.reset(99, 1, 2, rsoUser);
+  BOOST_CHECK_EQUAL(stream.getPosition(), 0u);
+  BOOST_CHECK_EQUAL(stream.nextUInt32(), values[0]);
+}
+
+BOOST_AUTO_TEST_CASE(valuesStayInRange)
+{
+  sgpRandomStream stream(7, 0, 0, rsoNone);
+  int intValue;
+  uint uintValue;
+  double doubleValue;
+
+  for(uint i = 0; i != 10000; i++) {
+    intValue = stream.randomInt(-3, 3);
+    BOOST_REQUIRE(intValue >= -3 && intValue <= 3);
+    uintValue = stream.randomUInt(10, 12);
+    BOOST_REQUIRE(uintValue >= 10 && uintValue <= 12);
+    doubleValue = stream.randomDouble(1.0, 2.0);
+    BOOST_REQUIRE(doubleValue >= 1.0 && doubleValue < 2.0);
+  }
+
+  BOOST_CHECK_EQUAL(stream.randomInt(5, 5), 5);
+  BOOST_CHECK_EQUAL(stream.randomUInt(5, 5), 5u);
+  BOOST_CHECK(!stream.randomFlip(0.0));
+  BOOST_CHECK(stream.randomFlip(1.0));
+}
+
+BOOST_AUTO_TEST_CASE(distributionMoments)
+{
+  const uint count = 100000;
+  std::vector<double> values(count);
+  sgpRandomStream stream(2024, 0, 0, rsoNone);
+  double sum, sum2;
+
+  stream.fillUniform(&values[0], count);
+  sum = sum2 = 0.0;
+  for(uint i = 0; i != count; i++) {
+    sum += values[i];
+    sum2 += values[i] * values[i];
+  }
+  BOOST_CHECK_SMALL(sum / count - 0.5, 0.01);
+  BOOST_CHECK_SMALL(sum2 / count - sum * sum / count / count - 1.0 / 12.0, 0.01);
+
+  stream.fillNormal(&values[0], count, 2.0, 3.0);
+  sum = sum2 = 0.0;
+  for(uint i = 0; i != count; i++) {
+    sum += values[i];
+    sum2 += values[i] * values[i];
+  }
+  BOOST_CHECK_SMALL(sum / count - 2.0, 0.05);
+  BOOST_CHECK_SMALL(std::sqrt(sum2 / count - sum * sum / count / count) - 3.0, 0.05);
+}
@@ -0,0 +1,177 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        ShapeClustererTest.cpp
+// Project:     sgpLib
+// Purpose:     Unit tests for sgpShapeClusterer.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#define BOOST_TEST_MODULE ShapeClustererTest
+#include <boost/test/unit_test.hpp>
+
+//std
+#include <cmath>
+#include <limits>
+#include <set>
+
+//sgp
+#include "sgp/ShapeClusterer.h"
+
+namespace {
+
+const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+std::set<uint> getItems(const sgpShapeClusterer &clusterer, uint clusterNo)
+{
+  const uint *items = clusterer.getClusterItems(clusterNo);
+  return std::set<uint>(items, items + clusterer.getClusterSize(clusterNo));
+}
+
+uint getTotalSize(const sgpShapeClusterer &clusterer)
+{
+  uint res = 0;
+  for(uint c = 0; c != clusterer.getClusterCount(); c++)
+    res += clusterer.getClusterSize(c);
+  return res;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(singleColumnFindsSeparatedGroups)
+{
+  const double values[] = {10.0, 0.0, 20.0, 0.5, 10.5, 20.5, 1.0, 11.0, 21.0};
+  sgpShapeClusterer clusterer;
+
+  clusterer.execute(values, 9, 3);
+
+  BOOST_REQUIRE_EQUAL(clusterer.getClusterCount(), 3u);
+
+  const uint low[] = {1, 3, 6};
+  const uint mid[] = {0, 4, 7};
+  const uint high[] = {2, 5, 8};
+  BOOST_CHECK(getItems(clusterer, 0) == std::set<uint>(low, low + 3));
+  BOOST_CHECK(getItems(clusterer, 1) == std::set<uint>(mid, mid + 3));
+  BOOST_CHECK(getItems(clusterer, 2) == std::set<uint>(high, high + 3));
+  BOOST_CHECK_CLOSE(clusterer.getCentroid(0), 0.5, 1e-9);
+  BOOST_CHECK_CLOSE(clusterer.getCentroid(1), 10.5, 1e-9);
+  BOOST_CHECK_CLOSE(clusterer.getCentroid(2), 20.5, 1e-9);
+  BOOST_CHECK_EQUAL(clusterer.getStepCount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(singleColumnLimitsClustersToDistinctValues)
+{
+  const double values[] = {1.0, 1.0, 2.0, 2.0};
+  sgpShapeClusterer clusterer;
+
+  clusterer.execute(values, 4, 5);
+
+  BOOST_CHECK_EQUAL(clusterer.getClusterCount(), 2u);
+  BOOST_CHECK_EQUAL(getTotalSize(clusterer), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(singleColumnAddsNanToLastCluster)
+{
+  const double values[] = {0.0, NaN, 10.0, 0.1, 10.1};
+  sgpShapeClusterer clusterer;
+
+  clusterer.execute(values, 5, 2);
+
+  BOOST_REQUIRE_EQUAL(clusterer.getClusterCount(), 2u);
+  BOOST_CHECK_EQUAL(getTotalSize(clusterer), 5u);
+  BOOST_CHECK(getItems(clusterer, 1).count(1) == 1);
+  BOOST_CHECK_CLOSE(clusterer.getCentroid(1), 10.05, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(twoColumnsFindSeparatedGroups)
+{
+  const double values[] = {0.0, 0.1, 5.0, 5.1, 0.2, 5.2};
+  const double values2[] = {0.0, 0.1, 5.0, 5.1, 0.2, 5.2};
+  sgpShapeClusterer clusterer;
+
+  clusterer.execute(values, values2, 6, 2, 20);
+
+  BOOST_REQUIRE_EQUAL(clusterer.getClusterCount(), 2u);
+  const uint low[] = {0, 1, 4};
+  const uint high[] = {2, 3, 5};
+  BOOST_CHECK(getItems(clusterer, 0) == std::set<uint>(low, low + 3));
+  BOOST_CHECK(getItems(clusterer, 1) == std::set<uint>(high, high + 3));
+  BOOST_CHECK_CLOSE(clusterer.getCentroid(0), 0.1, 1e-9);
+  BOOST_CHECK_CLOSE(clusterer.getCentroid(1), 5.1, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(twoColumnsKeepNanOutOfCentroids)
+{
+  const double values[] = {0.0, 0.1, 5.0, 5.1, NaN};
+  const double values2[] = {0.0, 0.1, 5.0, 5.1, 1.0};
+  sgpShapeClusterer clusterer;
+
+  // warm-started steps must not inherit NaN centroid
+  for(uint step = 0; step != 3; step++) {
+    clusterer.execute(values, values2, 5, 2, 20);
+
+    BOOST_REQUIRE_EQUAL(clusterer.getClusterCount(), 2u);
+    BOOST_CHECK_EQUAL(getTotalSize(clusterer), 5u);
+    BOOST_CHECK(getItems(clusterer, 1).count(4) == 1);
+    BOOST_CHECK_CLOSE(clusterer.getCentroid(0), 0.05, 1e-9);
+    BOOST_CHECK_CLOSE(clusterer.getCentroid(1), 5.05, 1e-9);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(twoColumnsWithOnlyNanGiveSingleCluster)
+{
+  const double values[] = {NaN, 1.0};
+  const double values2[] = {1.0, NaN};
+  sgpShapeClusterer clusterer;
+
+  clusterer.execute(values, values2, 2, 2, 20);
+
+  BOOST_REQUIRE_EQUAL(clusterer.getClusterCount(), 1u);
+  BOOST_CHECK_EQUAL(clusterer.getClusterSize(0), 2u);
+  BOOST_CHECK(clusterer.getCentroid(0) != clusterer.getCentroid(0));
+}
+
+BOOST_AUTO_TEST_CASE(twoColumnsReseedEmptyWarmClusters)
+{
+  const double values[] = {0.0, 0.1, 0.2, 5.0, 5.1, 5.2, 10.0, 10.1, 10.2};
+  double moved[9];
+  sgpShapeClusterer clusterer;
+
+  clusterer.execute(values, values, 9, 3, 20);
+  BOOST_REQUIRE_EQUAL(clusterer.getClusterCount(), 3u);
+
+  // whole population moves past the last warm center, 
+  // two centers are left without members in first step
+  for(uint i = 0; i != 9; i++)
+    moved[i] = values[i] + 100.0;
+
+  clusterer.execute(moved, moved, 9, 3, 20);
+
+  BOOST_REQUIRE_EQUAL(clusterer.getClusterCount(), 3u);
+  BOOST_CHECK_EQUAL(getTotalSize(clusterer), 9u);
+
+  std::set<std::set<uint> > found, expected;
+  for(uint c = 0; c != 3; c++) {
+    found.insert(getItems(clusterer, c));
+    const uint group[] = {3 * c, 3 * c + 1, 3 * c + 2};
+    expected.insert(std::set<uint>(group, group + 3));
+  }
+  BOOST_CHECK(found == expected);
+}
+
+BOOST_AUTO_TEST_CASE(twoColumnsDoNotReseedWithEqualItems)
+{
+  const double values[] = {0.0, 5.0, 10.0};
+  const double same[] = {1.0, 1.0, 1.0};
+  sgpShapeClusterer clusterer;
+
+  clusterer.execute(values, values, 3, 3, 20);
+  BOOST_REQUIRE_EQUAL(clusterer.getClusterCount(), 3u);
+
+  // no distinct item is available for empty clusters
+  clusterer.execute(same, same, 3, 3, 20);
+
+  BOOST_CHECK_EQUAL(clusterer.getClusterCount(), 1u);
+  BOOST_CHECK_EQUAL(getTotalSize(clusterer), 3u);
+  BOOST_CHECK(clusterer.getStepCount() < 20u);
+}
@@ -0,0 +1,124 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        TournamentGroupTest.cpp
+// Project:     sgpLib
+// Purpose:     Unit tests for sgpTournamentGroup.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#define BOOST_TEST_MODULE TournamentGroupTest
+#include <boost/test/unit_test.hpp>
+
+//std
+#include <cstdlib>
+#include <set>
+
+//sgp
+#include "sgp/TournamentGroup.h"
+
+namespace {
+
+bool isEqual(const sgpTournamentGroup &group, const std::set<uint> &expected)
+{
+  return (group.size() == expected.size()) && std::equal(group.begin(), group.end(), expected.begin());
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(insertKeepsSortedUniqueItems)
+{
+  sgpTournamentGroup group;
+
+  BOOST_CHECK(group.empty());
+  BOOST_CHECK(group.insert(5));
+  BOOST_CHECK(group.insert(1));
+  BOOST_CHECK(group.insert(9));
+  BOOST_CHECK(!group.insert(5));
+  BOOST_CHECK(group.insert(3));
+
+  BOOST_REQUIRE_EQUAL(group.size(), 4u);
+  BOOST_CHECK_EQUAL(group[0], 1u);
+  BOOST_CHECK_EQUAL(group[1], 3u);
+  BOOST_CHECK_EQUAL(group[2], 5u);
+  BOOST_CHECK_EQUAL(group[3], 9u);
+  BOOST_CHECK(group.contains(9));
+  BOOST_CHECK(!group.contains(4));
+  BOOST_CHECK(group.find(4) == group.end());
+}
+
+BOOST_AUTO_TEST_CASE(eraseRemovesItem)
+{
+  sgpTournamentGroup group;
+  group.insert(1);
+  group.insert(2);
+  group.insert(3);
+
+  BOOST_CHECK(group.erase(2u));
+  BOOST_CHECK(!group.erase(2u));
+  group.erase(group.begin());
+
+  BOOST_REQUIRE_EQUAL(group.size(), 1u);
+  BOOST_CHECK_EQUAL(group[0], 3u);
+
+  group.clear();
+  BOOST_CHECK(group.empty());
+}
+
+BOOST_AUTO_TEST_CASE(matchesStdSetBeyondInlineSize)
+{
+  sgpTournamentGroup group;
+  std::set<uint> expected;
+  uint value;
+
+  std::srand(1);
+  for(uint i = 0; i != 10 * SGP_TOUR_GROUP_INLINE_SIZE; i++) {
+    value = std::rand() % (4 * SGP_TOUR_GROUP_INLINE_SIZE);
+    BOOST_CHECK_EQUAL(group.insert(value), expected.insert(value).second);
+    if (i % 3 == 0) {
+      value = std::rand() % (4 * SGP_TOUR_GROUP_INLINE_SIZE);
+      BOOST_CHECK_EQUAL(group.erase(value), (expected.erase(value) > 0));
+    }
+  }
+
+  BOOST_CHECK(group.size() > SGP_TOUR_GROUP_INLINE_SIZE);
+  BOOST_CHECK(isEqual(group, expected));
+}
+
+BOOST_AUTO_TEST_CASE(copyAndSwapMixInlineAndHeapStorage)
+{
+  sgpTournamentGroup small, big;
+  std::set<uint> smallItems, bigItems;
+
+  for(uint i = 0; i != 3; i++) {
+    small.insert(i * 7);
+    smallItems.insert(i * 7);
+  }
+
+  for(uint i = 0; i != 2 * SGP_TOUR_GROUP_INLINE_SIZE; i++) {
+    big.insert(i);
+    bigItems.insert(i);
+  }
+
+  sgpTournamentGroup copy(big);
+  BOOST_CHECK(isEqual(copy, bigItems));
+
+  copy = small;
+  BOOST_CHECK(isEqual(copy, smallItems));
+
+  small.swap(big);
+  BOOST_CHECK(isEqual(small, bigItems));
+  BOOST_CHECK(isEqual(big, smallItems));
+
+  small.swap(big);
+  BOOST_CHECK(isEqual(small, smallItems));
+  BOOST_CHECK(isEqual(big, bigItems));
+
+  // heap buffer is kept after clear, inserts still work
+  big.clear();
+  big.insert(4);
+  big.insert(2);
+  BOOST_REQUIRE_EQUAL(big.size(), 2u);
+  BOOST_CHECK_EQUAL(big[0], 2u);
+  BOOST_CHECK_EQUAL(big[1], 4u);
+}
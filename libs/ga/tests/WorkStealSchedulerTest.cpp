@@ -0,0 +1,126 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        WorkStealSchedulerTest.cpp
+// Project:     sgpLib
+// Purpose:     Unit tests for sgpWorkStealScheduler.
+// Author:      
+// Modified by:
+// Created:     16/10/2026
+/////////////////////////////////////////////////////////////////////////////
+
+#define BOOST_TEST_MODULE WorkStealSchedulerTest
+#include <boost/test/unit_test.hpp>
+
+//std
+#include <stdexcept>
+#include <vector>
+
+//sc
+#include "sc/defs.h"
+
+//sgp
+#include "sgp/WorkStealScheduler.h"
+
+namespace {
+
+/// counts runs of each task, tasks have very different cost
+class sgpCountingTask: public sgpWorkStealTask {
+public:
+  sgpCountingTask(uint taskCount): m_runCounts(taskCount, 0), m_sink(0) {}
+
+  virtual void runTask(uint workerNo, uint taskNo) {
+    // written by one worker only
+    m_runCounts[taskNo]++;
+    uint loopCount = (taskNo % 7 == 0) ? 200000 : 100;
+    uint sum = 0;
+    for(uint i = 0; i != loopCount; i++)
+      sum += i ^ taskNo;
+    m_sink = sum;
+  }
+
+  uint getRunCount(uint taskNo) const { return m_runCounts[taskNo]; }
+private:
+  std::vector<uint> m_runCounts;
+  volatile uint m_sink;
+};
+
+/// throws for a single task
+class sgpFailingTask: public sgpWorkStealTask {
+public:
+  sgpFailingTask(uint failedTaskNo): m_failedTaskNo(failedTaskNo) {}
+
+  virtual void runTask(uint workerNo, uint taskNo) {
+    if (taskNo == m_failedTaskNo)
+      throw std::runtime_error("task failed");
+  }
+private:
+  uint m_failedTaskNo;
+};
+
+ulong64 sumTaskCount(const sgpWorkStealStatsList &stats)
+{
+  ulong64 res = 0;
+  for(uint i = 0; i != stats.size(); i++)
+    res += stats[i].taskCount;
+  return res;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(runsEachTaskOnce)
+{
+  const uint taskCount = 1000;
+  const uint workerCounts[] = {0, 1, 3, 8};
+
+  for(uint w = 0; w != 4; w++) {
+    sgpWorkStealScheduler scheduler;
+    sgpCountingTask task(taskCount);
+
+    scheduler.setWorkerCount(workerCounts[w]);
+    scheduler.execute(taskCount, task);
+
+    for(uint i = 0; i != taskCount; i++)
+      BOOST_REQUIRE_EQUAL(task.getRunCount(i), 1u);
+    BOOST_CHECK_EQUAL(sumTaskCount(scheduler.getStats()), taskCount);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(handlesLessTasksThanWorkers)
+{
+  sgpWorkStealScheduler scheduler;
+  sgpCountingTask task(2);
+
+  scheduler.setWorkerCount(8);
+  scheduler.execute(0, task);
+  BOOST_CHECK_EQUAL(task.getRunCount(0), 0u);
+
+  scheduler.execute(2, task);
+  BOOST_CHECK_EQUAL(task.getRunCount(0), 1u);
+  BOOST_CHECK_EQUAL(task.getRunCount(1), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(taskExceptionIsRethrownAfterWorkersFinish)
+{
+  sgpWorkStealScheduler scheduler;
+  sgpFailingTask failingTask(37);
+
+  scheduler.setWorkerCount(4);
+  BOOST_CHECK_THROW(scheduler.execute(100, failingTask), scError);
+
+  // scheduler is usable after failure
+  sgpCountingTask task(100);
+  scheduler.execute(100, task);
+  for(uint i = 0; i != 100; i++)
+    BOOST_REQUIRE_EQUAL(task.getRunCount(i), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(resetStatsClearsWorkerStats)
+{
+  sgpWorkStealScheduler scheduler;
+  sgpCountingTask task(10);
+
+  scheduler.execute(10, task);
+  BOOST_CHECK(!scheduler.getStats().empty());
+
+  scheduler.resetStats();
+  BOOST_CHECK(scheduler.getStats().empty());
+}